@@ -0,0 +1,121 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+/*
+ * Compares CentripetalCatmullRomSpline::interpolateY(), which uses Newton's method for segments
+ * with a monotonic X-component, with CentripetalCatmullRomSpline::interpolateYByBisection().
+ *
+ * Segments have control points at 5 degree intervals and random values. Queries are evaluated
+ * at random positions in the segments.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <libbsdf/Common/CentripetalCatmullRomSpline.h>
+#include <libbsdf/Common/Utility.h>
+
+using namespace lb;
+
+/* Creates segments with control points at 5 degree intervals and values in [0, maxValue]. */
+static std::vector<CentripetalCatmullRomSpline> createSplines(int numSplines, double maxValue, std::mt19937* engine)
+{
+    std::uniform_real_distribution<double> valueDist(0.0, maxValue);
+    const double interval = toRadian(5.0);
+
+    std::vector<CentripetalCatmullRomSpline> splines(numSplines);
+    for (int i = 0; i < numSplines; ++i) {
+        splines[i].initialize(Vec2(0.0,             valueDist(*engine)),
+                              Vec2(interval,        valueDist(*engine)),
+                              Vec2(interval * 2.0,  valueDist(*engine)),
+                              Vec2(interval * 3.0,  valueDist(*engine)));
+    }
+
+    return splines;
+}
+
+/* Measures the time per call in nanoseconds. */
+template <typename FuncT>
+static double measure(std::vector<CentripetalCatmullRomSpline>*   splines,
+                      const std::vector<double>&                  xs,
+                      int                                         numCalls,
+                      FuncT                                       func,
+                      double*                                     sum)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < numCalls; ++i) {
+        int index = i % static_cast<int>(splines->size());
+        *sum += func(&(*splines)[index], xs[index]);
+    }
+
+    std::chrono::steady_clock::duration time = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(time).count() / numCalls;
+}
+
+static double interpolateByNewton(CentripetalCatmullRomSpline* spline, double x)
+{
+    return spline->interpolateY(x);
+}
+
+static double interpolateByBisection(CentripetalCatmullRomSpline* spline, double x)
+{
+    return spline->interpolateYByBisection(x);
+}
+
+int main()
+{
+    const int numSplines = 10000;
+    const int numCalls = 2000000;
+    const double interval = toRadian(5.0);
+
+    std::mt19937 engine(1);
+    std::uniform_real_distribution<double> xDist(interval, interval * 2.0);
+
+    std::vector<double> xs(numSplines);
+    for (int i = 0; i < numSplines; ++i) {
+        xs[i] = xDist(engine);
+    }
+
+    const double maxValues[] = { 1.0, 100.0 };
+    for (int i = 0; i < 2; ++i) {
+        std::vector<CentripetalCatmullRomSpline> splines = createSplines(numSplines, maxValues[i], &engine);
+
+        double sum = 0.0;
+        double bisectionTime = measure(&splines, xs, numCalls, interpolateByBisection, &sum);
+        double newtonTime = measure(&splines, xs, numCalls, interpolateByNewton, &sum);
+
+        std::cout
+            << "Values in [0, " << maxValues[i] << "]: "
+            << bisectionTime << " ns (bisection), "
+            << newtonTime << " ns (Newton) per call"
+            << " (checksum: " << sum << ")" << std::endl;
+    }
+
+    // Compare the results of random segments.
+    const int numComparedSplines = 200000;
+    double maxRelativeDiff = 0.0;
+    for (int i = 0; i < numComparedSplines / numSplines; ++i) {
+        std::vector<CentripetalCatmullRomSpline> splines = createSplines(numSplines, maxValues[i % 2], &engine);
+
+        for (int j = 0; j < numSplines; ++j) {
+            double newtonY = splines[j].interpolateY(xs[j]);
+            double bisectionY = splines[j].interpolateYByBisection(xs[j]);
+            double diff = std::abs(newtonY - bisectionY) / std::max(std::abs(bisectionY), 1.0e-10);
+            maxRelativeDiff = std::max(maxRelativeDiff, diff);
+        }
+    }
+
+    std::cout << "Maximum relative difference of " << numComparedSplines << " segments: " << maxRelativeDiff << std::endl;
+
+    return 0;
+}
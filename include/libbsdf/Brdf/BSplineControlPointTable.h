@@ -0,0 +1,96 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_B_SPLINE_CONTROL_POINT_TABLE_H
+#define LIBBSDF_B_SPLINE_CONTROL_POINT_TABLE_H
+
+#include <cassert>
+
+#include <libbsdf/Brdf/SampleSet.h>
+
+namespace lb {
+
+/*!
+ * \class   BSplineControlPointTable
+ * \brief   The BSplineControlPointTable class holds the control points of uniform cubic B-splines.
+ *
+ * Control points are prefiltered from spectra along each axis so that the splines pass through spectra.
+ * Angle1 and angle3 are periodic if they cover [0, 2 * PI].
+ * The table holds a control point per sample point and wavelength in single precision, and must be
+ * built again after the sample set is modified.
+ */
+class BSplineControlPointTable
+{
+public:
+    BSplineControlPointTable();
+
+    /*! Constructs and builds the table of \a samples. */
+    explicit BSplineControlPointTable(const SampleSet& samples);
+
+    /*! Builds the table of \a samples. \a samples must not be destroyed while the table is used. */
+    void build(const SampleSet& samples);
+
+    /*! Clears the table. */
+    void clear();
+
+    /*! Returns true if the table has been built. */
+    bool isBuilt() const;
+
+    /*! Gets the sample set of the table. */
+    const SampleSet* getSampleSet() const;
+
+    /*!
+     * Gets the control points of all wavelengths at an index.
+     * The index of a set of angle indices is index0 + numAngles0 * (index1 + numAngles1 * (index2 + numAngles2 * index3)).
+     */
+    const float* getControlPoints(int index) const;
+
+private:
+    /*! Returns true if the numbers of angles and wavelengths of the sample set are the same as the table. */
+    bool isConsistent() const;
+
+    const SampleSet* samples_; /*!< The sample set used to build the table. */
+
+    int numAngles0_;        /*!< The number of angle0 when the table is built. */
+    int numAngles1_;        /*!< The number of angle1 when the table is built. */
+    int numAngles2_;        /*!< The number of angle2 when the table is built. */
+    int numAngles3_;        /*!< The number of angle3 when the table is built. */
+    int numWavelengths_;    /*!< The number of wavelengths when the table is built. */
+
+    Arrayf controlPoints_; /*!< The control points of splines. */
+};
+
+/*
+ * Implementation
+ */
+
+inline bool BSplineControlPointTable::isBuilt() const { return (samples_ != 0); }
+
+inline const SampleSet* BSplineControlPointTable::getSampleSet() const { return samples_; }
+
+inline const float* BSplineControlPointTable::getControlPoints(int index) const
+{
+    assert(isConsistent());
+    assert(index >= 0 && index < numAngles0_ * numAngles1_ * numAngles2_ * numAngles3_);
+
+    return &controlPoints_[index * numWavelengths_];
+}
+
+inline bool BSplineControlPointTable::isConsistent() const
+{
+    return (samples_ &&
+            samples_->getNumAngles0() == numAngles0_ &&
+            samples_->getNumAngles1() == numAngles1_ &&
+            samples_->getNumAngles2() == numAngles2_ &&
+            samples_->getNumAngles3() == numAngles3_ &&
+            samples_->getNumWavelengths() == numWavelengths_);
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_B_SPLINE_CONTROL_POINT_TABLE_H
@@ -0,0 +1,179 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_B_SPLINE_INTERPOLATOR_H
+#define LIBBSDF_B_SPLINE_INTERPOLATOR_H
+
+#include <libbsdf/Brdf/BSplineControlPointTable.h>
+
+namespace lb {
+
+/*!
+ * \class   BSplineInterpolator
+ * \brief   The BSplineInterpolator class provides the functions for uniform cubic B-spline interpolation.
+ *
+ * Spectra are interpolated with tensor-product cubic B-splines that are uniform in the indices of angles
+ * and pass through sample points. Control points are prefiltered in lb::BSplineControlPointTable.
+ * Angle1 and angle3 are periodic if they cover [0, 2 * PI].
+ * Interpolated values are C2 continuous but can slightly overshoot around sharp peaks.
+ *
+ * \a angle1 is not used for isotropic BRDFs.
+ */
+class BSplineInterpolator
+{
+public:
+    /*! Gets the interpolated spectrum of sample points at a set of angles. */
+    static void getSpectrum(const BSplineControlPointTable&    table,
+                            float                              angle0,
+                            float                              angle1,
+                            float                              angle2,
+                            float                              angle3,
+                            Spectrum*                          spectrum);
+
+    /*! Gets the interpolated spectrum of sample points at a set of angles. */
+    static void getSpectrum(const BSplineControlPointTable&    table,
+                            float                              angle0,
+                            float                              angle2,
+                            float                              angle3,
+                            Spectrum*                          spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * \a spectrum is an array of table.getSampleSet()->getNumWavelengths() values.
+     */
+    static void getSpectrum(const BSplineControlPointTable&    table,
+                            float                              angle0,
+                            float                              angle1,
+                            float                              angle2,
+                            float                              angle3,
+                            float*                             spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * \a spectrum is an array of table.getSampleSet()->getNumWavelengths() values.
+     */
+    static void getSpectrum(const BSplineControlPointTable&    table,
+                            float                              angle0,
+                            float                              angle2,
+                            float                              angle3,
+                            float*                             spectrum);
+
+    /*! Gets the interpolated value of sample points at a set of angles and the index of wavelength. */
+    static float getValue(const BSplineControlPointTable&    table,
+                          float                              angle0,
+                          float                              angle1,
+                          float                              angle2,
+                          float                              angle3,
+                          int                                wavelengthIndex);
+
+    /*! Gets the interpolated value of sample points at a set of angles and the index of wavelength. */
+    static float getValue(const BSplineControlPointTable&    table,
+                          float                              angle0,
+                          float                              angle2,
+                          float                              angle3,
+                          int                                wavelengthIndex);
+
+private:
+    /*!
+     * Interpolates \a numWavelengths values from the index of wavelength at a set of angles.
+     * \a angle1 is not used for isotropic BRDFs.
+     */
+    static void interpolate(const BSplineControlPointTable&    table,
+                            float                              angle0,
+                            float                              angle1,
+                            float                              angle2,
+                            float                              angle3,
+                            int                                wavelengthIndex,
+                            int                                numWavelengths,
+                            float*                             values);
+
+    /*!
+     * Finds the indices and weights of control points along an axis.
+     * Returns the number of control points, which is 1 if \a angles has a single angle, otherwise 4.
+     */
+    static int findControlPoints(const Arrayf&              angles,
+                                 const AngleLookupTable&    lookupTable,
+                                 bool                       equalIntervalAngles,
+                                 bool                       periodic,
+                                 float                      angle,
+                                 int*                       indices,
+                                 float*                     weights);
+};
+
+/*
+ * Implementation
+ */
+
+inline void BSplineInterpolator::getSpectrum(const BSplineControlPointTable&    table,
+                                             float                              angle0,
+                                             float                              angle1,
+                                             float                              angle2,
+                                             float                              angle3,
+                                             Spectrum*                          spectrum)
+{
+    int numWavelengths = table.getSampleSet()->getNumWavelengths();
+    spectrum->resize(numWavelengths);
+    interpolate(table, angle0, angle1, angle2, angle3, 0, numWavelengths, spectrum->data());
+}
+
+inline void BSplineInterpolator::getSpectrum(const BSplineControlPointTable&    table,
+                                             float                              angle0,
+                                             float                              angle2,
+                                             float                              angle3,
+                                             Spectrum*                          spectrum)
+{
+    int numWavelengths = table.getSampleSet()->getNumWavelengths();
+    spectrum->resize(numWavelengths);
+    interpolate(table, angle0, 0.0f, angle2, angle3, 0, numWavelengths, spectrum->data());
+}
+
+inline void BSplineInterpolator::getSpectrum(const BSplineControlPointTable&    table,
+                                             float                              angle0,
+                                             float                              angle1,
+                                             float                              angle2,
+                                             float                              angle3,
+                                             float*                             spectrum)
+{
+    interpolate(table, angle0, angle1, angle2, angle3, 0, table.getSampleSet()->getNumWavelengths(), spectrum);
+}
+
+inline void BSplineInterpolator::getSpectrum(const BSplineControlPointTable&    table,
+                                             float                              angle0,
+                                             float                              angle2,
+                                             float                              angle3,
+                                             float*                             spectrum)
+{
+    interpolate(table, angle0, 0.0f, angle2, angle3, 0, table.getSampleSet()->getNumWavelengths(), spectrum);
+}
+
+inline float BSplineInterpolator::getValue(const BSplineControlPointTable&    table,
+                                           float                              angle0,
+                                           float                              angle1,
+                                           float                              angle2,
+                                           float                              angle3,
+                                           int                                wavelengthIndex)
+{
+    float value;
+    interpolate(table, angle0, angle1, angle2, angle3, wavelengthIndex, 1, &value);
+    return value;
+}
+
+inline float BSplineInterpolator::getValue(const BSplineControlPointTable&    table,
+                                           float                              angle0,
+                                           float                              angle2,
+                                           float                              angle3,
+                                           int                                wavelengthIndex)
+{
+    float value;
+    interpolate(table, angle0, 0.0f, angle2, angle3, wavelengthIndex, 1, &value);
+    return value;
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_B_SPLINE_INTERPOLATOR_H
@@ -10,7 +10,11 @@
 #define LIBBSDF_BRDF_H
 
 #include <iostream>
+#include <memory>
+#include <vector>
 
+#include <libbsdf/Brdf/BrdfSlice.h>
+#include <libbsdf/Brdf/DirectionTable.h>
 #include <libbsdf/Brdf/Sampler.h>
 #include <libbsdf/Brdf/SampleSet.h>
 
@@ -38,9 +42,12 @@ public:
     /*! Constructs an empty BRDF. Brdf::samples_ must be initialized in a derived class. */
     Brdf();
 
-    /*! Copies and constructs a BRDF. */
+    /*! Copies and constructs a BRDF. Spectra are shared until either BRDF modifies them. */
     Brdf(const Brdf& brdf);
 
+    /*! Moves and constructs a BRDF. \a brdf can only be destroyed or assigned. */
+    Brdf(Brdf&& brdf);
+
     virtual ~Brdf();
 
     /*! Virtual copy constructor. */
@@ -55,9 +62,65 @@ public:
     /*! Gets the spectrum of the BRDF at incoming and outgoing directions. */
     virtual Spectrum getSpectrum(const Vec3& inDir, const Vec3& outDir) const = 0;
 
+    /*!
+     * Gets the spectrum of the BRDF at incoming and outgoing directions.
+     * \a spectrum is an array of getSampleSet()->getNumWavelengths() values.
+     * Derived classes override this function to evaluate without allocating memory.
+     */
+    virtual void getSpectrum(const Vec3& inDir, const Vec3& outDir, float* spectrum) const;
+
+    /*!
+     * Gets the spectrum of the BRDF at incoming and outgoing directions.
+     * \a context holds the last cell of sample points for coherent queries and is used by one thread.
+     * Derived classes without a lookup context ignore it.
+     */
+    virtual void getSpectrum(const Vec3&    inDir,
+                             const Vec3&    outDir,
+                             LookupContext* context,
+                             float*         spectrum) const;
+
+    /*!
+     * Gets the spectrum of the BRDF at incoming and outgoing directions using a random number.
+     * \a randomNumber is a uniform random number in [0, 1]. Derived classes with sample points
+     * return the spectrum of one sample point chosen with the probability equal to its weight,
+     * which is an unbiased estimate of the interpolated spectrum for Monte Carlo integration.
+     * The default implementation ignores \a randomNumber.
+     */
+    virtual void getSpectrumStochastic(const Vec3&  inDir,
+                                       const Vec3&  outDir,
+                                       float        randomNumber,
+                                       float*       spectrum) const;
+
     /*! Gets the value of the BRDF at incoming and outgoing directions and the index of wavelength. */
     virtual float getValue(const Vec3& inDir, const Vec3& outDir, int wavelengthIndex) const = 0;
 
+    /*!
+     * Gets the spectra of the BRDF at \a numQueries pairs of incoming and outgoing directions.
+     * The spectrum of the i-th query is written to \a spectra[i * getSampleSet()->getNumWavelengths()]
+     * and following values. Derived classes override this function to evaluate a batch with one virtual call.
+     */
+    virtual void getSpectra(const Vec3* inDirs,
+                            const Vec3* outDirs,
+                            int         numQueries,
+                            float*      spectra) const;
+
+    /*!
+     * Gets the values of the BRDF at \a numQueries pairs of incoming and outgoing directions
+     * and the index of wavelength.
+     */
+    virtual void getValues(const Vec3*  inDirs,
+                           const Vec3*  outDirs,
+                           int          numQueries,
+                           int          wavelengthIndex,
+                           float*       values) const;
+
+    /*!
+     * Binds an incoming direction and returns the slice of the BRDF to evaluate outgoing directions.
+     * Derived classes cache the values depending only on \a inDir, such as incoming angles.
+     * The default implementation evaluates the BRDF with both directions.
+     */
+    virtual std::unique_ptr<BrdfSlice> bindIncoming(const Vec3& inDir) const;
+
     /*!
      * Computes incoming and outgoing directions of a Cartesian coordinate system
      * using a set of angle indices.
@@ -65,6 +128,20 @@ public:
     virtual void getInOutDirection(int index0, int index1, int index2, int index3,
                                    Vec3* inDir, Vec3* outDir) const = 0;
 
+    /*!
+     * Creates the table of incoming and outgoing directions at the sample points with the current angles.
+     * Derived classes precompute directions to avoid trigonometric functions at each sample point.
+     * The default implementation computes directions with getInOutDirection().
+     */
+    virtual std::unique_ptr<DirectionTable> createDirectionTable() const;
+
+    /*!
+     * Calls \a func with incoming and outgoing directions at all sample points.
+     * \a func is called as func(index0, index1, index2, index3, inDir, outDir) in the order of angle indices.
+     */
+    template <typename FuncT>
+    void forEachInOutDirection(FuncT func) const;
+
     /*!
      * Converts from four angles to incoming and outgoing directions and
      * assigns them to \a inDir and \a outDir.
@@ -109,6 +186,9 @@ public:
     static bool initializeSpectra(const Brdf& baseBrdf, Brdf* brdf);
 
 protected:
+    /*! Moves a BRDF. This is used in derived classes of the same coordinate system. */
+    Brdf& operator=(Brdf&& brdf);
+
     /*! This attribute holds the sample set including angles, wavelengths, and spectra. */
     SampleSet* samples_;
 
@@ -120,6 +200,29 @@ private:
 inline       SampleSet* Brdf::getSampleSet()       { return samples_; }
 inline const SampleSet* Brdf::getSampleSet() const { return samples_; }
 
+template <typename FuncT>
+void Brdf::forEachInOutDirection(FuncT func) const
+{
+    const int numAngles2 = samples_->getNumAngles2();
+    const int numAngles3 = samples_->getNumAngles3();
+
+    std::vector<Vec3, Eigen::aligned_allocator<Vec3> > inDirs(numAngles2 * numAngles3);
+    std::vector<Vec3, Eigen::aligned_allocator<Vec3> > outDirs(numAngles2 * numAngles3);
+
+    std::unique_ptr<DirectionTable> table = createDirectionTable();
+
+    for (int i0 = 0; i0 < samples_->getNumAngles0(); ++i0) {
+    for (int i1 = 0; i1 < samples_->getNumAngles1(); ++i1) {
+        table->getInOutDirections(i0, i1, inDirs.data(), outDirs.data());
+
+        for (int i2 = 0; i2 < numAngles2; ++i2) {
+        for (int i3 = 0; i3 < numAngles3; ++i3) {
+            int index = i3 + numAngles3 * i2;
+            func(i0, i1, i2, i3, inDirs[index], outDirs[index]);
+        }}
+    }}
+}
+
 template <typename InterpolatorT>
 bool Brdf::initializeSpectra(const Brdf& baseBrdf, Brdf* brdf)
 {
@@ -148,20 +251,32 @@ bool Brdf::initializeSpectra(const Brdf& baseBrdf, Brdf* brdf)
 
     if (!same) return false;
 
+    // Consecutive directions are in the same or an adjacent cell of the base BRDF in most cases.
+    LookupContext context;
+    Spectrum sp;
+
+    const int numAngles3 = ss->getNumAngles3();
+    std::vector<Vec3, Eigen::aligned_allocator<Vec3> > inDirs(ss->getNumAngles2() * numAngles3);
+    std::vector<Vec3, Eigen::aligned_allocator<Vec3> > outDirs(ss->getNumAngles2() * numAngles3);
+
+    std::unique_ptr<DirectionTable> table = brdf->createDirectionTable();
+
     for (int i0 = 0; i0 < ss->getNumAngles0(); ++i0) {
     for (int i1 = 0; i1 < ss->getNumAngles1(); ++i1) {
-    for (int i2 = 0; i2 < ss->getNumAngles2(); ++i2) {
-    for (int i3 = 0; i3 < ss->getNumAngles3(); ++i3) {
-        Vec3 inDir, outDir;
-        brdf->getInOutDirection(i0, i1, i2, i3, &inDir, &outDir);
-        fixDownwardDir(&inDir);
-        fixDownwardDir(&outDir);
-
-        Spectrum sp;
-        Sampler::getSpectrum<InterpolatorT>(baseBrdf, inDir, outDir, &sp);
-
-        ss->setSpectrum(i0, i1, i2, i3, sp.cwiseMax(0.0));
-    }}}}
+        table->getInOutDirections(i0, i1, inDirs.data(), outDirs.data());
+
+        for (int i2 = 0; i2 < ss->getNumAngles2(); ++i2) {
+        for (int i3 = 0; i3 < ss->getNumStoredAngles3(); ++i3) {
+            Vec3 inDir = inDirs[i3 + numAngles3 * i2];
+            Vec3 outDir = outDirs[i3 + numAngles3 * i2];
+            fixDownwardDir(&inDir);
+            fixDownwardDir(&outDir);
+
+            Sampler::getSpectrum<InterpolatorT>(baseBrdf, inDir, outDir, &context, &sp);
+
+            ss->setSpectrum(i0, i1, i2, i3, sp.cwiseMax(0.0));
+        }}
+    }}
 
     return true;
 }
@@ -0,0 +1,102 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_BRDF_PYRAMID_H
+#define LIBBSDF_BRDF_PYRAMID_H
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <libbsdf/Brdf/Brdf.h>
+
+namespace lb {
+
+/*!
+ * \class   BrdfPyramid
+ * \brief   The BrdfPyramid class provides a mip-style pyramid of a BRDF.
+ *
+ * Level 0 is a copy of the original BRDF. Each following level has about half the angles of
+ * the previous level along each axis with more than two angles. Both end angles of an axis are kept,
+ * and spectra are filtered with a tent filter in angle weighted by the width of each sample.
+ * The tent of angle1 and angle3 wraps around if the angles cover [0, 2 * PI].
+ *
+ * Kept angles are chosen symmetrically about the middle index of an axis, so the mirrored angles3 of
+ * lb::PLANE_SYMMETRY are kept in pairs and coarse levels have the symmetry of the original BRDF.
+ * If angles3 of a coarse level are not plane symmetric, the level is stored without symmetry.
+ */
+class BrdfPyramid
+{
+public:
+    /*!
+     * Constructs the pyramid of \a brdf.
+     * Levels are added until no axis can be halved or the number of levels reaches \a maxNumLevels.
+     */
+    explicit BrdfPyramid(const Brdf& brdf, int maxNumLevels = 8);
+
+    ~BrdfPyramid();
+
+    /*! Gets the number of levels. */
+    int getNumLevels() const;
+
+    /*! Gets the BRDF at \a level. */
+    Brdf*       getLevel(int level);
+    const Brdf* getLevel(int level) const; /*!< Gets the BRDF at \a level. */
+
+    /*!
+     * Gets the spectrum of the BRDF at a continuous \a level.
+     * Spectra of the two nearest levels are linearly blended. \a level is clamped to the range of levels.
+     */
+    Spectrum getSpectrum(const Vec3& inDir, const Vec3& outDir, float level) const;
+
+    /*!
+     * Gets the spectrum of the BRDF at a continuous \a level.
+     * \a spectrum is an array of getLevel(0)->getSampleSet()->getNumWavelengths() values.
+     */
+    void getSpectrum(const Vec3& inDir, const Vec3& outDir, float level, float* spectrum) const;
+
+    /*! Creates a BRDF with about half the angles of \a brdf along each axis. */
+    static Brdf* downsample(const Brdf& brdf);
+
+private:
+    /*! Copy constructor is disabled. */
+    BrdfPyramid(const BrdfPyramid&);
+
+    /*! Copy operator is disabled. */
+    BrdfPyramid& operator=(const BrdfPyramid&);
+
+    /*! The maximum number of wavelengths blended in a buffer on the stack. */
+    static const int MAX_NUM_STACK_WAVELENGTHS = 64;
+
+    /*! The indices and weights of fine sample points used for a coarse sample point. */
+    typedef std::vector<std::pair<int, float> > Taps;
+
+    /*! Gets the angle at \a index, which is extended over the range of angles. */
+    static float getExtendedAngle(const Arrayf& angles, bool periodic, int index);
+
+    /*! Computes coarse angles and the filter taps of each coarse angle along an axis. */
+    static void computeTaps(const Arrayf&       angles,
+                            bool                periodic,
+                            Arrayf*             coarseAngles,
+                            std::vector<Taps>*  taps);
+
+    std::vector<std::unique_ptr<Brdf> > levels_; /*!< The BRDFs from the finest to the coarsest level. */
+};
+
+/*
+ * Implementation
+ */
+
+inline int BrdfPyramid::getNumLevels() const { return static_cast<int>(levels_.size()); }
+
+inline       Brdf* BrdfPyramid::getLevel(int level)       { return levels_.at(level).get(); }
+inline const Brdf* BrdfPyramid::getLevel(int level) const { return levels_.at(level).get(); }
+
+} // namespace lb
+
+#endif // LIBBSDF_BRDF_PYRAMID_H
@@ -0,0 +1,86 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_BRDF_SLICE_H
+#define LIBBSDF_BRDF_SLICE_H
+
+#include <libbsdf/Brdf/LookupContext.h>
+#include <libbsdf/Common/Global.h>
+#include <libbsdf/Common/Vector.h>
+
+namespace lb {
+
+class Brdf;
+
+/*!
+ * \class   BrdfSlice
+ * \brief   The BrdfSlice class provides the functions to evaluate a BRDF at outgoing directions with a fixed incoming direction.
+ *
+ * A slice is created by Brdf::bindIncoming(). Derived classes cache the values depending only on
+ * the incoming direction. This class evaluates the BRDF with both directions.
+ *
+ * The BRDF must outlive the slice and must not be modified while the slice is used.
+ * The functions are const and a slice can be shared between threads.
+ */
+class BrdfSlice
+{
+public:
+    /*! Constructs a slice of a BRDF at an incoming direction. */
+    BrdfSlice(const Brdf& brdf, const Vec3& inDir);
+
+    virtual ~BrdfSlice();
+
+    /*! Gets the BRDF. */
+    const Brdf& getBrdf() const;
+
+    /*! Gets the incoming direction. */
+    const Vec3& getInDir() const;
+
+    /*! Gets the spectrum of the BRDF at an outgoing direction. */
+    Spectrum getSpectrum(const Vec3& outDir) const;
+
+    /*!
+     * Gets the spectrum of the BRDF at an outgoing direction.
+     * \a spectrum is an array of getBrdf().getSampleSet()->getNumWavelengths() values.
+     */
+    virtual void getSpectrum(const Vec3& outDir, float* spectrum) const;
+
+    /*!
+     * Gets the spectrum of the BRDF at an outgoing direction.
+     * \a context holds the last cell of sample points for the BRDFs evaluated with both directions
+     * and is used by one thread. Derived classes with cached values ignore it.
+     */
+    virtual void getSpectrum(const Vec3&    outDir,
+                             LookupContext* context,
+                             float*         spectrum) const;
+
+    /*! Gets the value of the BRDF at an outgoing direction and the index of wavelength. */
+    virtual float getValue(const Vec3& outDir, int wavelengthIndex) const;
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+protected:
+    const Brdf& brdf_; /*!< The BRDF evaluated by the slice. */
+
+    Vec3 inDir_; /*!< The incoming direction. */
+
+private:
+    /*! Copy operator is disabled. */
+    BrdfSlice& operator=(const BrdfSlice&);
+};
+
+/*
+ * Implementation
+ */
+
+inline const Brdf& BrdfSlice::getBrdf()  const { return brdf_; }
+inline const Vec3& BrdfSlice::getInDir() const { return inDir_; }
+
+} // namespace lb
+
+#endif // LIBBSDF_BRDF_SLICE_H
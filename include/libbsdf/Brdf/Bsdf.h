@@ -28,6 +28,12 @@ public:
      */
     Bsdf(Brdf* brdf, Btdf* btdf);
 
+    /*! Moves and constructs a BSDF. \a bsdf can only be destroyed or assigned. */
+    Bsdf(Bsdf&& bsdf);
+
+    /*! Moves a BSDF. */
+    Bsdf& operator=(Bsdf&& bsdf);
+
     virtual ~Bsdf();
 
     Brdf* getBrdf(); /*!< Gets the BRDF data. */
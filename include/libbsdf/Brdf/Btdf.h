@@ -30,11 +30,50 @@ public:
      */
     explicit Btdf(Brdf* brdf);
 
+    /*! Moves and constructs a BTDF. \a btdf can only be destroyed or assigned. */
+    Btdf(Btdf&& btdf);
+
+    /*! Moves a BTDF. */
+    Btdf& operator=(Btdf&& btdf);
+
     virtual ~Btdf();
 
     /*! Gets the spectrum of the BTDF at incoming and outgoing directions. */
     Spectrum getSpectrum(const Vec3& inDir, const Vec3& outDir) const;
 
+    /*!
+     * Gets the spectrum of the BTDF at incoming and outgoing directions.
+     * \a spectrum is an array of getSampleSet()->getNumWavelengths() values.
+     */
+    void getSpectrum(const Vec3& inDir, const Vec3& outDir, float* spectrum) const;
+
+    /*!
+     * Gets the spectrum of the BTDF at incoming and outgoing directions.
+     * \a context holds the last cell of sample points for coherent queries.
+     */
+    void getSpectrum(const Vec3&    inDir,
+                     const Vec3&    outDir,
+                     LookupContext* context,
+                     float*         spectrum) const;
+
+    /*!
+     * Gets the spectrum of the BTDF at incoming and outgoing directions using a random number.
+     * \a randomNumber is a uniform random number in [0, 1].
+     */
+    void getSpectrumStochastic(const Vec3&  inDir,
+                               const Vec3&  outDir,
+                               float        randomNumber,
+                               float*       spectrum) const;
+
+    /*!
+     * Gets the spectra of the BTDF at \a numQueries pairs of incoming and outgoing directions.
+     * Directions are mirrored in blocks and evaluated with one call of Brdf::getSpectra() per block.
+     */
+    void getSpectra(const Vec3* inDirs,
+                    const Vec3* outDirs,
+                    int         numQueries,
+                    float*      spectra) const;
+
     /*!
      * Computes incoming and outgoing directions of a Cartesian coordinate system
      * using a set of angle indices.
@@ -64,6 +103,35 @@ inline Spectrum Btdf::getSpectrum(const Vec3& inDir, const Vec3& outDir) const
     return sp;
 }
 
+inline void Btdf::getSpectrum(const Vec3& inDir, const Vec3& outDir, float* spectrum) const
+{
+    brdf_->getSpectrum(Vec3(inDir[0], inDir[1], std::abs(inDir[2])),
+                       Vec3(outDir[0], outDir[1], std::abs(outDir[2])),
+                       spectrum);
+}
+
+inline void Btdf::getSpectrum(const Vec3&       inDir,
+                              const Vec3&       outDir,
+                              LookupContext*    context,
+                              float*            spectrum) const
+{
+    brdf_->getSpectrum(Vec3(inDir[0], inDir[1], std::abs(inDir[2])),
+                       Vec3(outDir[0], outDir[1], std::abs(outDir[2])),
+                       context,
+                       spectrum);
+}
+
+inline void Btdf::getSpectrumStochastic(const Vec3&     inDir,
+                                        const Vec3&     outDir,
+                                        float           randomNumber,
+                                        float*          spectrum) const
+{
+    brdf_->getSpectrumStochastic(Vec3(inDir[0], inDir[1], std::abs(inDir[2])),
+                                 Vec3(outDir[0], outDir[1], std::abs(outDir[2])),
+                                 randomNumber,
+                                 spectrum);
+}
+
 inline void Btdf::getInOutDirection(int index0, int index1, int index2, int index3,
                                     Vec3* inDir, Vec3* outDir) const
 {
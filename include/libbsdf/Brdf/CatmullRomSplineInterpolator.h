@@ -9,6 +9,8 @@
 #ifndef LIBBSDF_CATMULL_ROM_SPLINE_INTERPOLATOR_H
 #define LIBBSDF_CATMULL_ROM_SPLINE_INTERPOLATOR_H
 
+#include <libbsdf/Brdf/CatmullRomSplineTable.h>
+#include <libbsdf/Brdf/LookupContext.h>
 #include <libbsdf/Brdf/SampleSet.h>
 #include <libbsdf/Common/Vector.h>
 #include <libbsdf/Common/Utility.h>
@@ -41,6 +43,50 @@ public:
                             float               angle3,
                             Spectrum*           spectrum);
 
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * \a context is not used since the neighborhood of a cell depends on angles.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle1,
+                            float               angle2,
+                            float               angle3,
+                            LookupContext*      context,
+                            Spectrum*           spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * \a context is not used since the neighborhood of a cell depends on angles.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle2,
+                            float               angle3,
+                            LookupContext*      context,
+                            Spectrum*           spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles
+     * using the splines baked in \a table.
+     */
+    static void getSpectrum(const CatmullRomSplineTable&    table,
+                            float                           angle0,
+                            float                           angle1,
+                            float                           angle2,
+                            float                           angle3,
+                            Spectrum*                       spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles
+     * using the splines baked in \a table.
+     */
+    static void getSpectrum(const CatmullRomSplineTable&    table,
+                            float                           angle0,
+                            float                           angle2,
+                            float                           angle3,
+                            Spectrum*                       spectrum);
+
     /*! Gets the interpolated value of sample points at a set of angles and the index of wavelength. */
     static float getValue(const SampleSet&  samples,
                           float             angle0,
@@ -68,19 +114,35 @@ public:
                             Spectrum*           spectrum);
 
 private:
-    /*! Finds four near indices and angles. */
-    static void findBounds(const Arrayf&    positions,
-                           float            posAngle,
-                           bool             equalIntervalPositions,
-                           bool             repeatBounds,
-                           int*             pos0Index,
-                           int*             pos1Index,
-                           int*             pos2Index,
-                           int*             pos3Index,
-                           float*           pos0Angle,
-                           float*           pos1Angle,
-                           float*           pos2Angle,
-                           float*           pos3Angle);
+    friend class CatmullRomSplineTable;
+
+    /*!
+     * Finds four near indices and angles.
+     * \a lookupTable is used to find the indices of positions at unequal intervals.
+     */
+    static void findBounds(const Arrayf&            positions,
+                           const AngleLookupTable&  lookupTable,
+                           float                    posAngle,
+                           bool                     equalIntervalPositions,
+                           bool                     repeatBounds,
+                           int*                     pos0Index,
+                           int*                     pos1Index,
+                           int*                     pos2Index,
+                           int*                     pos3Index,
+                           float*                   pos0Angle,
+                           float*                   pos1Angle,
+                           float*                   pos2Angle,
+                           float*                   pos3Angle);
+
+    /*! Finds the outer indices and angles of the interval between \a pos1Index and \a pos2Index. */
+    static void findOuterBounds(const Arrayf&   positions,
+                                bool            repeatBounds,
+                                int             pos1Index,
+                                int             pos2Index,
+                                int*            pos0Index,
+                                int*            pos3Index,
+                                float*          pos0Angle,
+                                float*          pos3Angle);
 
     /*! Interpolates spectra of 2D sample points. */
     static Spectrum interpolate2D(const SampleSet&  samples,
@@ -105,6 +167,16 @@ private:
                                   float             angle2,
                                   float             angle3);
 
+    /*! Interpolates spectra of 2D sample points using the splines baked in \a table. */
+    static Spectrum interpolate2D(const CatmullRomSplineTable&  table,
+                                  int                           index0,
+                                  int                           index1,
+                                  const int*                    posIndices2,
+                                  const float*                  posAngles2,
+                                  int                           index3,
+                                  float                         angle2,
+                                  float                         angle3);
+
     /*! Interpolates values of 2D sample points. */
     static float interpolate2D(const SampleSet& samples,
                                int              index0,
@@ -130,6 +202,31 @@ private:
                                int              wavelengthIndex);
 };
 
+/*
+ * Implementation
+ */
+
+inline void CatmullRomSplineInterpolator::getSpectrum(const SampleSet&  samples,
+                                                      float             angle0,
+                                                      float             angle1,
+                                                      float             angle2,
+                                                      float             angle3,
+                                                      LookupContext*    /*context*/,
+                                                      Spectrum*         spectrum)
+{
+    getSpectrum(samples, angle0, angle1, angle2, angle3, spectrum);
+}
+
+inline void CatmullRomSplineInterpolator::getSpectrum(const SampleSet&  samples,
+                                                      float             angle0,
+                                                      float             angle2,
+                                                      float             angle3,
+                                                      LookupContext*    /*context*/,
+                                                      Spectrum*         spectrum)
+{
+    getSpectrum(samples, angle0, angle2, angle3, spectrum);
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_CATMULL_ROM_SPLINE_INTERPOLATOR_H
@@ -0,0 +1,133 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_CATMULL_ROM_SPLINE_TABLE_H
+#define LIBBSDF_CATMULL_ROM_SPLINE_TABLE_H
+
+#include <cassert>
+
+#include <libbsdf/Brdf/SampleSet.h>
+#include <libbsdf/Common/CentripetalCatmullRomSpline.h>
+
+namespace lb {
+
+/*!
+ * \class   CatmullRomSplineTable
+ * \brief   The CatmullRomSplineTable class holds the baked tangents of centripetal Catmull-Rom splines.
+ *
+ * The splines along angle3 are computed for each cell of sample points and each wavelength.
+ * Splines along the other angles are not baked since their control points depend on
+ * the interpolated values at angle3.
+ * The table holds the tangents at both ends of a cell in single precision, 4 values per sample point
+ * and wavelength. The end points are read from the sample set. The table must be built again
+ * after the sample set is modified.
+ */
+class CatmullRomSplineTable
+{
+public:
+    CatmullRomSplineTable();
+
+    /*! Constructs and builds the table of \a samples. */
+    explicit CatmullRomSplineTable(const SampleSet& samples);
+
+    /*! Builds the table of \a samples. \a samples must not be destroyed while the table is used. */
+    void build(const SampleSet& samples);
+
+    /*! Clears the table. */
+    void clear();
+
+    /*! Returns true if the table has been built. */
+    bool isBuilt() const;
+
+    /*! Gets the sample set of the table. */
+    const SampleSet* getSampleSet() const;
+
+    /*!
+     * Interpolates a value along angle3 in the cell with the lower bound at \a index3.
+     * \a index3 is 0 if the number of angle3 is 1.
+     */
+    float interpolate(int   index0,
+                      int   index1,
+                      int   index2,
+                      int   index3,
+                      int   wavelengthIndex,
+                      float angle3) const;
+
+private:
+    /*! Gets the offset of the first tangent of a cell. */
+    int getOffset(int index0, int index1, int index2, int index3) const;
+
+    /*! Returns true if the numbers of angles and wavelengths of the sample set are the same as the table. */
+    bool isConsistent() const;
+
+    const SampleSet* samples_; /*!< The sample set used to build the table. */
+
+    int numAngles0_;        /*!< The number of angle0 when the table is built. */
+    int numAngles1_;        /*!< The number of angle1 when the table is built. */
+    int numAngles2_;        /*!< The number of angle2 when the table is built. */
+    int numAngles3_;        /*!< The number of angle3 when the table is built. */
+    int numWavelengths_;    /*!< The number of wavelengths when the table is built. */
+
+    int numCells3_; /*!< The number of cells along angle3. */
+
+    /*! The tangents of splines. Each spline has the X and Y components of tan1 and tan2 in order. */
+    Arrayf tangents_;
+};
+
+/*
+ * Implementation
+ */
+
+inline bool CatmullRomSplineTable::isBuilt() const { return (samples_ != 0); }
+
+inline const SampleSet* CatmullRomSplineTable::getSampleSet() const { return samples_; }
+
+inline float CatmullRomSplineTable::interpolate(int     index0,
+                                                int     index1,
+                                                int     index2,
+                                                int     index3,
+                                                int     wavelengthIndex,
+                                                float   angle3) const
+{
+    assert(isConsistent());
+
+    const float* t = &tangents_[getOffset(index0, index1, index2, index3) + wavelengthIndex * 4];
+
+    int pos2Index3 = (numAngles3_ > 1) ? index3 + 1 : index3;
+
+    const Arrayf& angles3 = samples_->getAngles3();
+    float pos1Value = samples_->getValue(samples_->getIndex(index0, index1, index2, index3), wavelengthIndex);
+    float pos2Value = samples_->getValue(samples_->getIndex(index0, index1, index2, pos2Index3), wavelengthIndex);
+
+    CentripetalCatmullRomSpline ccrs;
+    ccrs.initializeWithTangents(Vec2(angles3[index3], pos1Value),
+                                Vec2(angles3[pos2Index3], pos2Value),
+                                Vec2(t[0], t[1]),
+                                Vec2(t[2], t[3]));
+
+    return static_cast<float>(ccrs.interpolateY(angle3));
+}
+
+inline int CatmullRomSplineTable::getOffset(int index0, int index1, int index2, int index3) const
+{
+    int index = index0 + numAngles0_ * (index1 + numAngles1_ * (index2 + numAngles2_ * index3));
+    return index * numWavelengths_ * 4;
+}
+
+inline bool CatmullRomSplineTable::isConsistent() const
+{
+    return (samples_->getNumAngles0() == numAngles0_ &&
+            samples_->getNumAngles1() == numAngles1_ &&
+            samples_->getNumAngles2() == numAngles2_ &&
+            samples_->getNumAngles3() == numAngles3_ &&
+            samples_->getNumWavelengths() == numWavelengths_);
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_CATMULL_ROM_SPLINE_TABLE_H
@@ -9,9 +9,14 @@
 #ifndef LIBBSDF_COORDINATES_BRDF_H
 #define LIBBSDF_COORDINATES_BRDF_H
 
+#include <utility>
+#include <vector>
+
 #include <libbsdf/Brdf/Brdf.h>
+#include <libbsdf/Brdf/CoordinatesDirectionTable.h>
 #include <libbsdf/Brdf/LinearInterpolator.h>
 #include <libbsdf/Brdf/Sampler.h>
+#include <libbsdf/Brdf/StochasticInterpolator.h>
 
 namespace lb {
 
@@ -56,6 +61,12 @@ public:
     /*! Copies and constructs a BRDF. */
     CoordinatesBrdf(const CoordinatesBrdf& brdf);
 
+    /*! Moves and constructs a BRDF. \a brdf can only be destroyed or assigned. */
+    CoordinatesBrdf(CoordinatesBrdf&& brdf);
+
+    /*! Moves a BRDF. */
+    CoordinatesBrdf& operator=(CoordinatesBrdf&& brdf);
+
     virtual ~CoordinatesBrdf();
 
     /*! Virtual copy constructor. */
@@ -64,9 +75,53 @@ public:
     /*! Gets the spectrum of the BRDF at incoming and outgoing directions. */
     Spectrum getSpectrum(const Vec3& inDir, const Vec3& outDir) const;
 
+    /*!
+     * Gets the spectrum of the BRDF at incoming and outgoing directions.
+     * \a spectrum is an array of getSampleSet()->getNumWavelengths() values. Memory is not allocated.
+     */
+    void getSpectrum(const Vec3& inDir, const Vec3& outDir, float* spectrum) const;
+
+    /*!
+     * Gets the spectrum of the BRDF at incoming and outgoing directions.
+     * The cell of sample points in \a context is reused for coherent queries.
+     */
+    void getSpectrum(const Vec3&    inDir,
+                     const Vec3&    outDir,
+                     LookupContext* context,
+                     float*         spectrum) const;
+
+    /*!
+     * Gets the spectrum of a sample point chosen with the probability equal to its weight of
+     * linear interpolation. Only one spectrum is fetched per query.
+     */
+    void getSpectrumStochastic(const Vec3&  inDir,
+                               const Vec3&  outDir,
+                               float        randomNumber,
+                               float*       spectrum) const;
+
     /*! Gets the value of the BRDF at incoming and outgoing directions and the index of wavelength. */
     float getValue(const Vec3& inDir, const Vec3& outDir, int wavelengthIndex) const;
 
+    /*!
+     * Gets the spectra of the BRDF at \a numQueries pairs of incoming and outgoing directions.
+     * Queries are converted to angles with the SIMD kernels of CoordSysT and interpolated in SIMD lanes
+     * without virtual calls.
+     */
+    void getSpectra(const Vec3* inDirs,
+                    const Vec3* outDirs,
+                    int         numQueries,
+                    float*      spectra) const;
+
+    /*!
+     * Gets the values of the BRDF at \a numQueries pairs of incoming and outgoing directions
+     * and the index of wavelength.
+     */
+    void getValues(const Vec3*  inDirs,
+                   const Vec3*  outDirs,
+                   int          numQueries,
+                   int          wavelengthIndex,
+                   float*       values) const;
+
     /*!
      * Computes incoming and outgoing directions of a Cartesian coordinate system
      * using a set of angle indices.
@@ -74,6 +129,9 @@ public:
     void getInOutDirection(int index0, int index1, int index2, int index3,
                            Vec3* inDir, Vec3* outDir) const;
 
+    /*! Creates the table of precomputed directions at the sample points with the current angles. */
+    std::unique_ptr<DirectionTable> createDirectionTable() const;
+
     /*!
      * Converts from four angles to incoming and outgoing directions and
      * assigns them to \a inDir and \a outDir.
@@ -116,6 +174,15 @@ protected:
     void setAngle2(int index, float angle); /*!< Sets the angle2 at the index. \sa setAngle0() */
     void setAngle3(int index, float angle); /*!< Sets the angle3 at the index. \sa setAngle0() */
 
+    /*!
+     * Sets the array of angle0. The array must be sorted in ascending order and its size must be
+     * equal to the number of angles0. Angles are clamped to the range of the coordinate system.
+     */
+    void setAngles0(const Arrayf& angles);
+    void setAngles1(const Arrayf& angles); /*!< Sets the array of angle1. \sa setAngles0() */
+    void setAngles2(const Arrayf& angles); /*!< Sets the array of angle2. \sa setAngles0() */
+    void setAngles3(const Arrayf& angles); /*!< Sets the array of angle3. \sa setAngles0() */
+
 private:
     /*! Copy operator is disabled. */
     CoordinatesBrdf& operator=(const CoordinatesBrdf&);
@@ -190,6 +257,16 @@ CoordinatesBrdf<CoordSysT>::CoordinatesBrdf(const Brdf& brdf,
 template <typename CoordSysT>
 CoordinatesBrdf<CoordSysT>::CoordinatesBrdf(const CoordinatesBrdf& brdf) : Brdf(brdf) {}
 
+template <typename CoordSysT>
+CoordinatesBrdf<CoordSysT>::CoordinatesBrdf(CoordinatesBrdf&& brdf) : Brdf(std::move(brdf)) {}
+
+template <typename CoordSysT>
+CoordinatesBrdf<CoordSysT>& CoordinatesBrdf<CoordSysT>::operator=(CoordinatesBrdf&& brdf)
+{
+    Brdf::operator=(std::move(brdf));
+    return *this;
+}
+
 template <typename CoordSysT>
 CoordinatesBrdf<CoordSysT>::~CoordinatesBrdf() {}
 
@@ -202,17 +279,60 @@ CoordinatesBrdf<CoordSysT>* CoordinatesBrdf<CoordSysT>::clone() const
 template <typename CoordSysT>
 Spectrum CoordinatesBrdf<CoordSysT>::getSpectrum(const Vec3& inDir, const Vec3& outDir) const
 {
-    Spectrum sp;
-    Sampler::getSpectrum<CoordSysT, LinearInterpolator>(*samples_, inDir, outDir, &sp);
+    Spectrum sp(samples_->getNumWavelengths());
+    getSpectrum(inDir, outDir, sp.data());
     return sp;
 }
 
+template <typename CoordSysT>
+void CoordinatesBrdf<CoordSysT>::getSpectrum(const Vec3& inDir, const Vec3& outDir, float* spectrum) const
+{
+    Sampler::getSpectrum<CoordSysT, LinearInterpolator>(*samples_, inDir, outDir, spectrum);
+}
+
+template <typename CoordSysT>
+void CoordinatesBrdf<CoordSysT>::getSpectrum(const Vec3&    inDir,
+                                             const Vec3&    outDir,
+                                             LookupContext* context,
+                                             float*         spectrum) const
+{
+    Sampler::getSpectrum<CoordSysT, LinearInterpolator>(*samples_, inDir, outDir, context, spectrum);
+}
+
+template <typename CoordSysT>
+void CoordinatesBrdf<CoordSysT>::getSpectrumStochastic(const Vec3&  inDir,
+                                                       const Vec3&  outDir,
+                                                       float        randomNumber,
+                                                       float*       spectrum) const
+{
+    Sampler::getSpectrumStochastic<CoordSysT, StochasticInterpolator>(*samples_, inDir, outDir, randomNumber, spectrum);
+}
+
 template <typename CoordSysT>
 float CoordinatesBrdf<CoordSysT>::getValue(const Vec3& inDir, const Vec3& outDir, int wavelengthIndex) const
 {
     return Sampler::getValue<CoordSysT, LinearInterpolator>(*samples_, inDir, outDir, wavelengthIndex);
 }
 
+template <typename CoordSysT>
+void CoordinatesBrdf<CoordSysT>::getSpectra(const Vec3* inDirs,
+                                            const Vec3* outDirs,
+                                            int         numQueries,
+                                            float*      spectra) const
+{
+    Sampler::getSpectra<CoordSysT, LinearInterpolator>(*samples_, inDirs, outDirs, numQueries, spectra);
+}
+
+template <typename CoordSysT>
+void CoordinatesBrdf<CoordSysT>::getValues(const Vec3*  inDirs,
+                                           const Vec3*  outDirs,
+                                           int          numQueries,
+                                           int          wavelengthIndex,
+                                           float*       values) const
+{
+    Sampler::getValues<CoordSysT, LinearInterpolator>(*samples_, inDirs, outDirs, numQueries, wavelengthIndex, values);
+}
+
 template <typename CoordSysT>
 void CoordinatesBrdf<CoordSysT>::getInOutDirection(int index0, int index1, int index2, int index3,
                                                    Vec3* inDir, Vec3* outDir) const
@@ -227,6 +347,12 @@ void CoordinatesBrdf<CoordSysT>::getInOutDirection(int index0, int index1, int i
     outDir->normalize();
 }
 
+template <typename CoordSysT>
+std::unique_ptr<DirectionTable> CoordinatesBrdf<CoordSysT>::createDirectionTable() const
+{
+    return std::unique_ptr<DirectionTable>(new CoordinatesDirectionTable<CoordSysT>(*this));
+}
+
 template <typename CoordSysT>
 void CoordinatesBrdf<CoordSysT>::toXyz(float angle0, float angle1, float angle2, float angle3,
                                        Vec3* inDir, Vec3* outDir) const
@@ -275,57 +401,91 @@ std::string CoordinatesBrdf<CoordSysT>::getAngle3Name() const
 template <typename CoordSysT>
 bool CoordinatesBrdf<CoordSysT>::expandAngles()
 {
-    bool expanded = false;
+    const Arrayf& angles0 = samples_->getAngles0();
+    const Arrayf& angles1 = samples_->getAngles1();
+    const Arrayf& angles2 = samples_->getAngles2();
+    const Arrayf& angles3 = samples_->getAngles3();
 
-    Arrayf angles0 = samples_->getAngles0();
-    Arrayf angles1 = samples_->getAngles1();
-    Arrayf angles2 = samples_->getAngles2();
-    Arrayf angles3 = samples_->getAngles3();
+    // Minimum and maximum angles are inserted at both ends.
+    Arrayf insertedAngles0(2), insertedAngles1(2), insertedAngles2(2), insertedAngles3(2);
+    int numInserted0 = 0, numInserted1 = 0, numInserted2 = 0, numInserted3 = 0;
 
-    if (!isEqual(angles0[0], CoordSysT::MIN_ANGLE0)) { appendElement(&angles0, CoordSysT::MIN_ANGLE0); }
-    if (!isEqual(angles1[0], CoordSysT::MIN_ANGLE1)) { appendElement(&angles1, CoordSysT::MIN_ANGLE1); }
-    if (!isEqual(angles2[0], CoordSysT::MIN_ANGLE2)) { appendElement(&angles2, CoordSysT::MIN_ANGLE2); }
-    if (!isEqual(angles3[0], CoordSysT::MIN_ANGLE3)) { appendElement(&angles3, CoordSysT::MIN_ANGLE3); }
+    if (!isEqual(angles0[0], CoordSysT::MIN_ANGLE0)) { insertedAngles0[numInserted0++] = CoordSysT::MIN_ANGLE0; }
+    if (!isEqual(angles1[0], CoordSysT::MIN_ANGLE1)) { insertedAngles1[numInserted1++] = CoordSysT::MIN_ANGLE1; }
+    if (!isEqual(angles2[0], CoordSysT::MIN_ANGLE2)) { insertedAngles2[numInserted2++] = CoordSysT::MIN_ANGLE2; }
+    if (!isEqual(angles3[0], CoordSysT::MIN_ANGLE3)) { insertedAngles3[numInserted3++] = CoordSysT::MIN_ANGLE3; }
 
     const float maxAngle0 = CoordSysT::MAX_ANGLE0;
     const float maxAngle1 = CoordSysT::MAX_ANGLE1;
     const float maxAngle2 = CoordSysT::MAX_ANGLE2;
     const float maxAngle3 = CoordSysT::MAX_ANGLE3;
 
-    if (!isEqual(angles0[angles0.size() - 1], maxAngle0)) { appendElement(&angles0, maxAngle0); }
-    if (!isEqual(angles2[angles2.size() - 1], maxAngle2)) { appendElement(&angles2, maxAngle2); }
-    if (!isEqual(angles3[angles3.size() - 1], maxAngle3)) { appendElement(&angles3, maxAngle3); }
+    if (!isEqual(angles0[angles0.size() - 1], maxAngle0)) { insertedAngles0[numInserted0++] = maxAngle0; }
+    if (!isEqual(angles2[angles2.size() - 1], maxAngle2)) { insertedAngles2[numInserted2++] = maxAngle2; }
+    if (!isEqual(angles3[angles3.size() - 1], maxAngle3)) { insertedAngles3[numInserted3++] = maxAngle3; }
 
     if (!samples_->isIsotropic() &&
         !isEqual(angles1[angles1.size() - 1], maxAngle1)) {
-        appendElement(&angles1, maxAngle1);
+        insertedAngles1[numInserted1++] = maxAngle1;
     }
 
-    bool sizeEqual = (angles0.size() != samples_->getNumAngles0() ||
-                      angles1.size() != samples_->getNumAngles1() ||
-                      angles2.size() != samples_->getNumAngles2() ||
-                      angles3.size() != samples_->getNumAngles3());
-    if (sizeEqual) {
-        std::sort(angles0.data(), angles0.data() + angles0.size());
-        std::sort(angles1.data(), angles1.data() + angles1.size());
-        std::sort(angles2.data(), angles2.data() + angles2.size());
-        std::sort(angles3.data(), angles3.data() + angles3.size());
+    if (numInserted0 == 0 &&
+        numInserted1 == 0 &&
+        numInserted2 == 0 &&
+        numInserted3 == 0) {
+        return false;
+    }
+
+    insertedAngles0.conservativeResize(numInserted0);
+    insertedAngles1.conservativeResize(numInserted1);
+    insertedAngles2.conservativeResize(numInserted2);
+    insertedAngles3.conservativeResize(numInserted3);
+
+    // The original BRDF shares spectra until angles are inserted.
+    CoordinatesBrdf<CoordSysT> origBrdf(*this);
 
-        CoordinatesBrdf<CoordSysT> origBrdf(*this);
+    samples_->insertAngles(insertedAngles0, insertedAngles1, insertedAngles2, insertedAngles3);
 
-        samples_->resizeAngles(angles0.size(), angles1.size(), angles2.size(), angles3.size());
-        samples_->getAngles0() = angles0;
-        samples_->getAngles1() = angles1;
-        samples_->getAngles2() = angles2;
-        samples_->getAngles3() = angles3;
+    // Only the spectra at inserted angles are extrapolated.
+    std::vector<bool> inserted0(samples_->getNumAngles0());
+    std::vector<bool> inserted1(samples_->getNumAngles1());
+    std::vector<bool> inserted2(samples_->getNumAngles2());
+    std::vector<bool> inserted3(samples_->getNumAngles3());
 
-        samples_->updateAngleAttributes();
-        initializeSpectra(origBrdf);
+    for (int i = 0; i < samples_->getNumAngles0(); ++i) {
+        inserted0[i] = (insertedAngles0 == samples_->getAngle0(i)).any();
+    }
+
+    for (int i = 0; i < samples_->getNumAngles1(); ++i) {
+        inserted1[i] = (insertedAngles1 == samples_->getAngle1(i)).any();
+    }
+
+    for (int i = 0; i < samples_->getNumAngles2(); ++i) {
+        inserted2[i] = (insertedAngles2 == samples_->getAngle2(i)).any();
+    }
 
-        expanded = true;
+    for (int i = 0; i < samples_->getNumAngles3(); ++i) {
+        inserted3[i] = (insertedAngles3 == samples_->getAngle3(i)).any();
     }
 
-    return expanded;
+    for (int i0 = 0; i0 < samples_->getNumAngles0(); ++i0) {
+    for (int i1 = 0; i1 < samples_->getNumAngles1(); ++i1) {
+    for (int i2 = 0; i2 < samples_->getNumAngles2(); ++i2) {
+    for (int i3 = 0; i3 < samples_->getNumAngles3(); ++i3) {
+        if (!inserted0[i0] && !inserted1[i1] && !inserted2[i2] && !inserted3[i3]) continue;
+
+        Vec3 inDir, outDir;
+        getInOutDirection(i0, i1, i2, i3, &inDir, &outDir);
+        fixDownwardDir(&inDir);
+        fixDownwardDir(&outDir);
+
+        Spectrum sp;
+        Sampler::getSpectrum<LinearInterpolator>(origBrdf, inDir, outDir, &sp);
+
+        samples_->setSpectrum(i0, i1, i2, i3, sp.cwiseMax(0.0));
+    }}}}
+
+    return true;
 }
 
 template <typename CoordSysT>
@@ -371,6 +531,30 @@ inline void CoordinatesBrdf<CoordSysT>::setAngle3(int index, float angle)
     samples_->setAngle3(index, clamp(angle, CoordSysT::MIN_ANGLE3, CoordSysT::MAX_ANGLE3));
 }
 
+template <typename CoordSysT>
+inline void CoordinatesBrdf<CoordSysT>::setAngles0(const Arrayf& angles)
+{
+    samples_->setAngles0(angles.cwiseMax(CoordSysT::MIN_ANGLE0).cwiseMin(CoordSysT::MAX_ANGLE0));
+}
+
+template <typename CoordSysT>
+inline void CoordinatesBrdf<CoordSysT>::setAngles1(const Arrayf& angles)
+{
+    samples_->setAngles1(angles.cwiseMax(CoordSysT::MIN_ANGLE1).cwiseMin(CoordSysT::MAX_ANGLE1));
+}
+
+template <typename CoordSysT>
+inline void CoordinatesBrdf<CoordSysT>::setAngles2(const Arrayf& angles)
+{
+    samples_->setAngles2(angles.cwiseMax(CoordSysT::MIN_ANGLE2).cwiseMin(CoordSysT::MAX_ANGLE2));
+}
+
+template <typename CoordSysT>
+inline void CoordinatesBrdf<CoordSysT>::setAngles3(const Arrayf& angles)
+{
+    samples_->setAngles3(angles.cwiseMax(CoordSysT::MIN_ANGLE3).cwiseMin(CoordSysT::MAX_ANGLE3));
+}
+
 template <typename CoordSysT>
 void CoordinatesBrdf<CoordSysT>::initializeEqualIntervalAngles()
 {
@@ -0,0 +1,153 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_COORDINATES_BRDF_SLICE_H
+#define LIBBSDF_COORDINATES_BRDF_SLICE_H
+
+#include <cassert>
+
+#include <libbsdf/Brdf/Brdf.h>
+#include <libbsdf/Brdf/BrdfSlice.h>
+#include <libbsdf/Brdf/IncomingCell.h>
+#include <libbsdf/Brdf/LinearInterpolator.h>
+#include <libbsdf/Common/FastMath.h>
+#include <libbsdf/Common/SpecularCoordinateSystem.h>
+#include <libbsdf/Common/SphericalCoordinateSystem.h>
+
+namespace lb {
+
+/*!
+ * \class   CoordinatesBrdfSlice
+ * \brief   The CoordinatesBrdfSlice class provides the slice of a BRDF whose angle0 and angle1 are incoming angles.
+ *
+ * The incoming angles, the rotations by them, and the cell of sample points of angle0 and angle1 are
+ * computed once. Each outgoing direction is converted to angle2 and angle3, which are interpolated within the cell.
+ * The result is the same as lb::CoordinatesBrdf::getSpectrum() with linear interpolation.
+ *
+ * CoordSysT is lb::SphericalCoordinateSystem or lb::SpecularCoordinateSystem.
+ */
+template <typename CoordSysT>
+class CoordinatesBrdfSlice : public BrdfSlice
+{
+public:
+    /*! Constructs a slice of a BRDF at an incoming direction. \a brdf uses the coordinate system of CoordSysT. */
+    CoordinatesBrdfSlice(const Brdf& brdf, const Vec3& inDir);
+
+    using BrdfSlice::getSpectrum;
+
+    /*!
+     * Gets the spectrum of the BRDF at an outgoing direction.
+     * \a spectrum is an array of getBrdf().getSampleSet()->getNumWavelengths() values.
+     */
+    void getSpectrum(const Vec3& outDir, float* spectrum) const;
+
+    /*! Gets the spectrum of the BRDF at an outgoing direction. \a context is not used. */
+    void getSpectrum(const Vec3&    outDir,
+                     LookupContext* context,
+                     float*         spectrum) const;
+
+    /*! Gets the value of the BRDF at an outgoing direction and the index of wavelength. */
+    float getValue(const Vec3& outDir, int wavelengthIndex) const;
+
+private:
+    /*! Converts from an outgoing direction to angle2 and angle3 using the incoming angles. */
+    void fromOutDirXyz(const Vec3& outDir, float* angle2, float* angle3) const;
+
+    const SampleSet& samples_; /*!< The sample set of the BRDF. */
+
+    IncomingCell cell_; /*!< The cell of sample points of angle0 and angle1. */
+
+    float inTheta_; /*!< The polar angle of the incoming direction. */
+    float inPhi_;   /*!< The azimuthal angle of the incoming direction. */
+
+    float cosInTheta_; /*!< The cosine of the incoming polar angle. */
+    float sinInTheta_; /*!< The sine of the incoming polar angle. */
+    float cosInPhi_;   /*!< The cosine of the incoming azimuthal angle. */
+    float sinInPhi_;   /*!< The sine of the incoming azimuthal angle. */
+};
+
+/*
+ * Implementation
+ */
+
+template <typename CoordSysT>
+CoordinatesBrdfSlice<CoordSysT>::CoordinatesBrdfSlice(const Brdf& brdf, const Vec3& inDir)
+                                                      : BrdfSlice(brdf, inDir),
+                                                        samples_(*brdf.getSampleSet())
+{
+    assert(inDir.z() >= 0.0);
+
+    SphericalCoordinateSystem::fromXyz(inDir, &inTheta_, &inPhi_);
+
+    cosInTheta_ = fastCos(inTheta_);
+    sinInTheta_ = fastSin(inTheta_);
+    cosInPhi_ = fastCos(inPhi_);
+    sinInPhi_ = fastSin(inPhi_);
+
+    if (samples_.isIsotropic()) {
+        LinearInterpolator::findIncomingCell(samples_, inTheta_, &cell_);
+    }
+    else {
+        LinearInterpolator::findIncomingCell(samples_, inTheta_, inPhi_, &cell_);
+    }
+}
+
+template <>
+inline void CoordinatesBrdfSlice<SphericalCoordinateSystem>::fromOutDirXyz(const Vec3&  outDir,
+                                                                           float*       outTheta,
+                                                                           float*       outPhi) const
+{
+    SphericalCoordinateSystem::fromXyz(outDir, outTheta, outPhi);
+
+    // outPhi is relative to inPhi for isotropic data.
+    if (samples_.isIsotropic()) {
+        *outPhi = *outPhi - inPhi_;
+        if (*outPhi < 0.0f) {
+            *outPhi += 2.0f * PI_F;
+        }
+    }
+}
+
+template <>
+inline void CoordinatesBrdfSlice<SpecularCoordinateSystem>::fromOutDirXyz(const Vec3&   outDir,
+                                                                          float*        specTheta,
+                                                                          float*        specPhi) const
+{
+    SpecularCoordinateSystem::fromOutDirXyz(outDir,
+                                            cosInTheta_, sinInTheta_,
+                                            cosInPhi_, sinInPhi_,
+                                            specTheta, specPhi);
+}
+
+template <typename CoordSysT>
+void CoordinatesBrdfSlice<CoordSysT>::getSpectrum(const Vec3& outDir, float* spectrum) const
+{
+    float angle2, angle3;
+    fromOutDirXyz(outDir, &angle2, &angle3);
+    LinearInterpolator::getSpectrum(samples_, cell_, angle2, angle3, spectrum);
+}
+
+template <typename CoordSysT>
+void CoordinatesBrdfSlice<CoordSysT>::getSpectrum(const Vec3&       outDir,
+                                                  LookupContext*    /*context*/,
+                                                  float*            spectrum) const
+{
+    getSpectrum(outDir, spectrum);
+}
+
+template <typename CoordSysT>
+float CoordinatesBrdfSlice<CoordSysT>::getValue(const Vec3& outDir, int wavelengthIndex) const
+{
+    float angle2, angle3;
+    fromOutDirXyz(outDir, &angle2, &angle3);
+    return LinearInterpolator::getValue(samples_, cell_, angle2, angle3, wavelengthIndex);
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_COORDINATES_BRDF_SLICE_H
@@ -0,0 +1,283 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_COORDINATES_DIRECTION_TABLE_H
+#define LIBBSDF_COORDINATES_DIRECTION_TABLE_H
+
+#include <cmath>
+#include <vector>
+
+#include <libbsdf/Brdf/Brdf.h>
+#include <libbsdf/Brdf/DirectionTable.h>
+#include <libbsdf/Brdf/SampleSet.h>
+#include <libbsdf/Common/HalfDifferenceCoordinateSystem.h>
+#include <libbsdf/Common/SpecularCoordinateSystem.h>
+#include <libbsdf/Common/SphericalCoordinateSystem.h>
+#include <libbsdf/Common/Utility.h>
+
+namespace lb {
+
+/*!
+ * \class   CoordinatesDirectionTable
+ * \brief   The CoordinatesDirectionTable class provides the precomputed directions at the sample points of a coordinate system.
+ *
+ * The table is separable. Directions and rotations depending on angle0 and angle1 and the directions
+ * depending on angle2 and angle3 are computed in the constructor, and the directions at a sample point are
+ * composed without trigonometric functions. Directions are the same as CoordSysT::toXyz() followed by normalization.
+ *
+ * CoordSysT is lb::SphericalCoordinateSystem, lb::SpecularCoordinateSystem, or lb::HalfDifferenceCoordinateSystem.
+ */
+template <typename CoordSysT>
+class CoordinatesDirectionTable : public DirectionTable
+{
+public:
+    /*! Constructs a table of the sample points of a BRDF. \a brdf uses the coordinate system of CoordSysT. */
+    explicit CoordinatesDirectionTable(const Brdf& brdf);
+
+    /*! Gets normalized incoming and outgoing directions at a set of angle indices. */
+    void getInOutDirection(int index0, int index1, int index2, int index3,
+                           Vec3* inDir, Vec3* outDir) const;
+
+    /*!
+     * Gets normalized incoming and outgoing directions at the sample points with a set of indices of
+     * angle0 and angle1. \sa DirectionTable::getInOutDirections()
+     */
+    void getInOutDirections(int index0, int index1,
+                            Vec3* inDirs, Vec3* outDirs) const;
+
+private:
+    typedef std::vector<Vec3, Eigen::aligned_allocator<Vec3> > DirectionList;
+
+    /*! Computes the directions and rotations from the angles of a sample set. */
+    void initializeDirections(const SampleSet& samples);
+
+    /*! Composes normalized incoming and outgoing directions at a set of angle indices. */
+    void computeInOutDirection(int index0, int index1, int index2, int index3,
+                               Vec3* inDir, Vec3* outDir) const;
+
+    int numAngles0_; /*!< The number of angles0. */
+    int numAngles2_; /*!< The number of angles2. */
+    int numAngles3_; /*!< The number of angles3. */
+
+    DirectionList dirs01_; /*!< The directions at index0 + numAngles0 * index1. */
+    DirectionList dirs23_; /*!< The directions at index2 + numAngles2 * index3. */
+
+    Arrayf cos0_; /*!< The cosines of the rotation angles of angle0. */
+    Arrayf sin0_; /*!< The sines of the rotation angles of angle0. */
+    Arrayf cos1_; /*!< The cosines of the rotation angles of angle1. */
+    Arrayf sin1_; /*!< The sines of the rotation angles of angle1. */
+};
+
+/*
+ * Implementation
+ */
+
+template <typename CoordSysT>
+CoordinatesDirectionTable<CoordSysT>::CoordinatesDirectionTable(const Brdf& brdf)
+                                                                : DirectionTable(brdf)
+{
+    const SampleSet* ss = brdf.getSampleSet();
+
+    numAngles0_ = ss->getNumAngles0();
+    numAngles2_ = ss->getNumAngles2();
+    numAngles3_ = ss->getNumAngles3();
+
+    initializeDirections(*ss);
+}
+
+template <typename CoordSysT>
+void CoordinatesDirectionTable<CoordSysT>::getInOutDirection(int index0, int index1, int index2, int index3,
+                                                             Vec3* inDir, Vec3* outDir) const
+{
+    computeInOutDirection(index0, index1, index2, index3, inDir, outDir);
+}
+
+template <typename CoordSysT>
+void CoordinatesDirectionTable<CoordSysT>::getInOutDirections(int index0, int index1,
+                                                              Vec3* inDirs, Vec3* outDirs) const
+{
+    for (int i2 = 0; i2 < numAngles2_; ++i2) {
+    for (int i3 = 0; i3 < numAngles3_; ++i3) {
+        int index = i3 + numAngles3_ * i2;
+        computeInOutDirection(index0, index1, i2, i3, &inDirs[index], &outDirs[index]);
+    }}
+}
+
+/*
+ * The incoming direction depends only on angle0 and angle1, and the outgoing direction
+ * depends only on angle2 and angle3. Both are normalized in the table.
+ */
+
+template <>
+inline void CoordinatesDirectionTable<SphericalCoordinateSystem>::initializeDirections(const SampleSet& samples)
+{
+    const Arrayf& angles0 = samples.getAngles0();
+    const Arrayf& angles1 = samples.getAngles1();
+    const Arrayf& angles2 = samples.getAngles2();
+    const Arrayf& angles3 = samples.getAngles3();
+
+    const int numAngles1 = samples.getNumAngles1();
+
+    dirs01_.resize(numAngles0_ * numAngles1);
+    dirs23_.resize(numAngles2_ * numAngles3_);
+
+    Vec3 inDir, outDir;
+    for (int i0 = 0; i0 < numAngles0_; ++i0) {
+    for (int i1 = 0; i1 < numAngles1; ++i1) {
+        SphericalCoordinateSystem::toXyz(angles0[i0], angles1[i1], angles2[0], angles3[0], &inDir, &outDir);
+        inDir.normalize();
+        dirs01_[i0 + numAngles0_ * i1] = inDir;
+    }}
+
+    for (int i2 = 0; i2 < numAngles2_; ++i2) {
+    for (int i3 = 0; i3 < numAngles3_; ++i3) {
+        SphericalCoordinateSystem::toXyz(angles0[0], angles1[0], angles2[i2], angles3[i3], &inDir, &outDir);
+        outDir.normalize();
+        dirs23_[i2 + numAngles2_ * i3] = outDir;
+    }}
+}
+
+template <>
+inline void CoordinatesDirectionTable<SphericalCoordinateSystem>::computeInOutDirection(int index0, int index1,
+                                                                                        int index2, int index3,
+                                                                                        Vec3* inDir, Vec3* outDir) const
+{
+    *inDir = dirs01_[index0 + numAngles0_ * index1];
+    *outDir = dirs23_[index2 + numAngles2_ * index3];
+}
+
+/*
+ * The table has the normalized incoming directions, the unrotated specular directions,
+ * and the rotations by inTheta and inPhi.
+ */
+
+template <>
+inline void CoordinatesDirectionTable<SpecularCoordinateSystem>::initializeDirections(const SampleSet& samples)
+{
+    const Arrayf& angles0 = samples.getAngles0();
+    const Arrayf& angles1 = samples.getAngles1();
+    const Arrayf& angles2 = samples.getAngles2();
+    const Arrayf& angles3 = samples.getAngles3();
+
+    const int numAngles1 = samples.getNumAngles1();
+
+    dirs01_.resize(numAngles0_ * numAngles1);
+    dirs23_.resize(numAngles2_ * numAngles3_);
+
+    for (int i0 = 0; i0 < numAngles0_; ++i0) {
+    for (int i1 = 0; i1 < numAngles1; ++i1) {
+        Vec3 inDir = SphericalCoordinateSystem::toXyz(angles0[i0], angles1[i1]);
+        inDir.normalize();
+        dirs01_[i0 + numAngles0_ * i1] = inDir;
+    }}
+
+    for (int i2 = 0; i2 < numAngles2_; ++i2) {
+    for (int i3 = 0; i3 < numAngles3_; ++i3) {
+        dirs23_[i2 + numAngles2_ * i3] = SphericalCoordinateSystem::toXyz(angles2[i2], angles3[i3]);
+    }}
+
+    cos0_.resize(numAngles0_);
+    sin0_.resize(numAngles0_);
+    for (int i = 0; i < numAngles0_; ++i) {
+        cos0_[i] = std::cos(angles0[i]);
+        sin0_[i] = std::sin(angles0[i]);
+    }
+
+    cos1_.resize(numAngles1);
+    sin1_.resize(numAngles1);
+    for (int i = 0; i < numAngles1; ++i) {
+        cos1_[i] = std::cos(angles1[i]);
+        sin1_[i] = std::sin(angles1[i]);
+    }
+}
+
+template <>
+inline void CoordinatesDirectionTable<SpecularCoordinateSystem>::computeInOutDirection(int index0, int index1,
+                                                                                       int index2, int index3,
+                                                                                       Vec3* inDir, Vec3* outDir) const
+{
+    *inDir = dirs01_[index0 + numAngles0_ * index1];
+
+    const Vec3& specDir = dirs23_[index2 + numAngles2_ * index3];
+
+    // Rotations by inTheta and inPhi.
+    Vec2f rotThVec(cos0_[index0] * specDir[0] - sin0_[index0] * specDir[2],
+                   sin0_[index0] * specDir[0] + cos0_[index0] * specDir[2]);
+    Vec2f rotPhVec(cos1_[index1] * rotThVec[0] - sin1_[index1] * specDir[1],
+                   sin1_[index1] * rotThVec[0] + cos1_[index1] * specDir[1]);
+
+    *outDir = Vec3(rotPhVec[0], rotPhVec[1], rotThVec[1]);
+    outDir->normalize();
+}
+
+/*
+ * The table has the halfway and difference vectors, and the rotations by -halfTheta and -halfPhi.
+ */
+
+template <>
+inline void CoordinatesDirectionTable<HalfDifferenceCoordinateSystem>::initializeDirections(const SampleSet& samples)
+{
+    const Arrayf& angles0 = samples.getAngles0();
+    const Arrayf& angles1 = samples.getAngles1();
+    const Arrayf& angles2 = samples.getAngles2();
+    const Arrayf& angles3 = samples.getAngles3();
+
+    const int numAngles1 = samples.getNumAngles1();
+
+    dirs01_.resize(numAngles0_ * numAngles1);
+    dirs23_.resize(numAngles2_ * numAngles3_);
+
+    for (int i0 = 0; i0 < numAngles0_; ++i0) {
+    for (int i1 = 0; i1 < numAngles1; ++i1) {
+        dirs01_[i0 + numAngles0_ * i1] = SphericalCoordinateSystem::toXyz(angles0[i0], angles1[i1]);
+    }}
+
+    for (int i2 = 0; i2 < numAngles2_; ++i2) {
+    for (int i3 = 0; i3 < numAngles3_; ++i3) {
+        dirs23_[i2 + numAngles2_ * i3] = SphericalCoordinateSystem::toXyz(angles2[i2], angles3[i3]);
+    }}
+
+    cos0_.resize(numAngles0_);
+    sin0_.resize(numAngles0_);
+    for (int i = 0; i < numAngles0_; ++i) {
+        cos0_[i] = std::cos(-angles0[i]);
+        sin0_[i] = std::sin(-angles0[i]);
+    }
+
+    cos1_.resize(numAngles1);
+    sin1_.resize(numAngles1);
+    for (int i = 0; i < numAngles1; ++i) {
+        cos1_[i] = std::cos(-angles1[i]);
+        sin1_[i] = std::sin(-angles1[i]);
+    }
+}
+
+template <>
+inline void CoordinatesDirectionTable<HalfDifferenceCoordinateSystem>::computeInOutDirection(int index0, int index1,
+                                                                                             int index2, int index3,
+                                                                                             Vec3* inDir, Vec3* outDir) const
+{
+    const Vec3& halfDir = dirs01_[index0 + numAngles0_ * index1];
+    const Vec3& diffDir = dirs23_[index2 + numAngles2_ * index3];
+
+    // Rotations by -halfTheta and -halfPhi.
+    Vec2f rotThVec(cos0_[index0] * diffDir[0] - sin0_[index0] * diffDir[2],
+                   sin0_[index0] * diffDir[0] + cos0_[index0] * diffDir[2]);
+    Vec2f rotPhVec(cos1_[index1] * rotThVec[0] - sin1_[index1] * diffDir[1],
+                   sin1_[index1] * rotThVec[0] + cos1_[index1] * diffDir[1]);
+
+    *inDir = Vec3(rotPhVec[0], rotPhVec[1], rotThVec[1]);
+    *outDir = reflect(*inDir, halfDir);
+
+    inDir->normalize();
+    outDir->normalize();
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_COORDINATES_DIRECTION_TABLE_H
@@ -0,0 +1,67 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_DIRECTION_TABLE_H
+#define LIBBSDF_DIRECTION_TABLE_H
+
+#include <libbsdf/Common/Vector.h>
+
+namespace lb {
+
+class Brdf;
+
+/*!
+ * \class   DirectionTable
+ * \brief   The DirectionTable class provides the incoming and outgoing directions at the sample points of a BRDF.
+ *
+ * A table is created by Brdf::createDirectionTable() for the angles of sample points at that time.
+ * Derived classes precompute directions. This class computes them with Brdf::getInOutDirection().
+ *
+ * The BRDF must outlive the table, and the table must not be used after angles are changed.
+ * The functions are const and a table can be shared between threads.
+ */
+class DirectionTable
+{
+public:
+    /*! Constructs a table of the sample points of a BRDF. */
+    explicit DirectionTable(const Brdf& brdf);
+
+    virtual ~DirectionTable();
+
+    /*! Gets the BRDF. */
+    const Brdf& getBrdf() const;
+
+    /*! Gets normalized incoming and outgoing directions at a set of angle indices. */
+    virtual void getInOutDirection(int index0, int index1, int index2, int index3,
+                                   Vec3* inDir, Vec3* outDir) const;
+
+    /*!
+     * Gets normalized incoming and outgoing directions at the sample points with a set of indices of
+     * angle0 and angle1. \a inDirs and \a outDirs are arrays of numAngles2 * numAngles3 directions, and
+     * the directions at index2 and index3 are assigned to the elements of index3 + numAngles3 * index2.
+     */
+    virtual void getInOutDirections(int index0, int index1,
+                                    Vec3* inDirs, Vec3* outDirs) const;
+
+protected:
+    const Brdf& brdf_; /*!< The BRDF of the table. */
+
+private:
+    /*! Copy operator is disabled. */
+    DirectionTable& operator=(const DirectionTable&);
+};
+
+/*
+ * Implementation
+ */
+
+inline const Brdf& DirectionTable::getBrdf() const { return brdf_; }
+
+} // namespace lb
+
+#endif // LIBBSDF_DIRECTION_TABLE_H
@@ -54,6 +54,12 @@ public:
     /*! Copies and constructs a BRDF. */
     HalfDifferenceCoordinatesBrdf(const HalfDifferenceCoordinatesBrdf& brdf);
 
+    /*! Moves and constructs a BRDF. \a brdf can only be destroyed or assigned. */
+    HalfDifferenceCoordinatesBrdf(HalfDifferenceCoordinatesBrdf&& brdf);
+
+    /*! Moves a BRDF. */
+    HalfDifferenceCoordinatesBrdf& operator=(HalfDifferenceCoordinatesBrdf&& brdf);
+
     virtual ~HalfDifferenceCoordinatesBrdf();
 
     /*! Virtual copy constructor. */
@@ -70,20 +76,20 @@ public:
                          float diffTheta, float diffPhi) const;
 
     /*! Gets the spectrum of the BRDF at a set of angle indices. */
-    Spectrum& getSpectrum(int halfThetaIndex, int halfPhiIndex,
-                          int diffThetaIndex, int diffPhiIndex);
+    SpectrumMap getSpectrum(int halfThetaIndex, int halfPhiIndex,
+                            int diffThetaIndex, int diffPhiIndex);
 
     /*! Gets the spectrum of the BRDF at a set of angle indices. */
-    const Spectrum& getSpectrum(int halfThetaIndex, int halfPhiIndex,
-                                int diffThetaIndex, int diffPhiIndex) const;
+    ConstSpectrumMap getSpectrum(int halfThetaIndex, int halfPhiIndex,
+                                 int diffThetaIndex, int diffPhiIndex) const;
 
     /*! Gets the spectrum of the isotropic BRDF at a set of angle indices. */
-    Spectrum& getSpectrum(int halfThetaIndex,
-                          int diffThetaIndex, int diffPhiIndex);
+    SpectrumMap getSpectrum(int halfThetaIndex,
+                            int diffThetaIndex, int diffPhiIndex);
 
     /*! Gets the spectrum of the isotropic BRDF at a set of angle indices. */
-    const Spectrum& getSpectrum(int halfThetaIndex,
-                                int diffThetaIndex, int diffPhiIndex) const;
+    ConstSpectrumMap getSpectrum(int halfThetaIndex,
+                                 int diffThetaIndex, int diffPhiIndex) const;
 
     /*! Sets the spectrum of the BRDF at a set of angle indices. */
     void setSpectrum(int halfThetaIndex, int halfPhiIndex,
@@ -100,6 +106,11 @@ public:
     void setDiffTheta(int index, float angle); /*!< Sets the polar angle of a difference vector. */
     void setDiffPhi  (int index, float angle); /*!< Sets the azimuthal angle of a difference vector. */
 
+    void setHalfThetaAngles(const Arrayf& angles); /*!< Sets the polar angles of a halfway vector. */
+    void setHalfPhiAngles  (const Arrayf& angles); /*!< Sets the azimuthal angles of a halfway vector. */
+    void setDiffThetaAngles(const Arrayf& angles); /*!< Sets the polar angles of a difference vector. */
+    void setDiffPhiAngles  (const Arrayf& angles); /*!< Sets the azimuthal angles of a difference vector. */
+
     int getNumHalfTheta() const; /*!< Gets the number of polar angles of a halfway vector. */
     int getNumHalfPhi()   const; /*!< Gets the number of azimuthal angles of a halfway vector. */
     int getNumDiffTheta() const; /*!< Gets the number of polar angles of a difference vector. */
@@ -126,28 +137,28 @@ inline Spectrum HalfDifferenceCoordinatesBrdf::getSpectrum(float halfTheta, floa
     return sp;
 }
 
-inline Spectrum& HalfDifferenceCoordinatesBrdf::getSpectrum(int halfThetaIndex, int halfPhiIndex,
-                                                            int diffThetaIndex, int diffPhiIndex)
+inline SpectrumMap HalfDifferenceCoordinatesBrdf::getSpectrum(int halfThetaIndex, int halfPhiIndex,
+                                                              int diffThetaIndex, int diffPhiIndex)
 {
     return samples_->getSpectrum(halfThetaIndex, halfPhiIndex, diffThetaIndex, diffPhiIndex);
 }
 
-inline const Spectrum& HalfDifferenceCoordinatesBrdf::getSpectrum(int halfThetaIndex, int halfPhiIndex,
-                                                                  int diffThetaIndex, int diffPhiIndex) const
+inline ConstSpectrumMap HalfDifferenceCoordinatesBrdf::getSpectrum(int halfThetaIndex, int halfPhiIndex,
+                                                                   int diffThetaIndex, int diffPhiIndex) const
 {
-    return samples_->getSpectrum(halfThetaIndex, halfPhiIndex, diffThetaIndex, diffPhiIndex);
+    return getSampleSet()->getSpectrum(halfThetaIndex, halfPhiIndex, diffThetaIndex, diffPhiIndex);
 }
 
-inline Spectrum& HalfDifferenceCoordinatesBrdf::getSpectrum(int halfThetaIndex,
-                                                            int diffThetaIndex, int diffPhiIndex)
+inline SpectrumMap HalfDifferenceCoordinatesBrdf::getSpectrum(int halfThetaIndex,
+                                                              int diffThetaIndex, int diffPhiIndex)
 {
     return samples_->getSpectrum(halfThetaIndex, diffThetaIndex, diffPhiIndex);
 }
 
-inline const Spectrum& HalfDifferenceCoordinatesBrdf::getSpectrum(int halfThetaIndex,
-                                                                  int diffThetaIndex, int diffPhiIndex) const
+inline ConstSpectrumMap HalfDifferenceCoordinatesBrdf::getSpectrum(int halfThetaIndex,
+                                                                   int diffThetaIndex, int diffPhiIndex) const
 {
-    return samples_->getSpectrum(halfThetaIndex, diffThetaIndex, diffPhiIndex);
+    return getSampleSet()->getSpectrum(halfThetaIndex, diffThetaIndex, diffPhiIndex);
 }
 
 inline void HalfDifferenceCoordinatesBrdf::setSpectrum(int halfThetaIndex, int halfPhiIndex,
@@ -167,6 +178,11 @@ inline void HalfDifferenceCoordinatesBrdf::setHalfPhi  (int index, float angle)
 inline void HalfDifferenceCoordinatesBrdf::setDiffTheta(int index, float angle) { setAngle2(index, angle); }
 inline void HalfDifferenceCoordinatesBrdf::setDiffPhi  (int index, float angle) { setAngle3(index, angle); }
 
+inline void HalfDifferenceCoordinatesBrdf::setHalfThetaAngles(const Arrayf& angles) { setAngles0(angles); }
+inline void HalfDifferenceCoordinatesBrdf::setHalfPhiAngles  (const Arrayf& angles) { setAngles1(angles); }
+inline void HalfDifferenceCoordinatesBrdf::setDiffThetaAngles(const Arrayf& angles) { setAngles2(angles); }
+inline void HalfDifferenceCoordinatesBrdf::setDiffPhiAngles  (const Arrayf& angles) { setAngles3(angles); }
+
 inline int HalfDifferenceCoordinatesBrdf::getNumHalfTheta() const { return samples_->getNumAngles0(); }
 inline int HalfDifferenceCoordinatesBrdf::getNumHalfPhi()   const { return samples_->getNumAngles1(); }
 inline int HalfDifferenceCoordinatesBrdf::getNumDiffTheta() const { return samples_->getNumAngles2(); }
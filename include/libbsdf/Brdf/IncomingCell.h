@@ -0,0 +1,49 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_INCOMING_CELL_H
+#define LIBBSDF_INCOMING_CELL_H
+
+namespace lb {
+
+/*!
+ * \class   IncomingCell
+ * \brief   The IncomingCell class holds the sample points of angle0 and angle1 surrounding fixed angles.
+ *
+ * A cell is found by LinearInterpolator::findIncomingCell() for coordinate systems in which angle0 and
+ * angle1 depend only on an incoming direction. The remaining angles are interpolated within the cell.
+ * Corners with zero weights, such as the upper corners of angles at sample points, are omitted.
+ */
+class IncomingCell
+{
+public:
+    IncomingCell();
+
+private:
+    friend class LinearInterpolator;
+
+    bool isotropic_; /*!< This attribute holds whether the cell was found with angle0 only. */
+
+    int numCorners_; /*!< The number of corners with nonzero weights. */
+
+    int indices0_[4]; /*!< The indices of angle0 at the corners. */
+    int indices1_[4]; /*!< The indices of angle1 at the corners. */
+
+    float weights_[4]; /*!< The weights of multilinear interpolation at the corners. */
+};
+
+/*
+ * Implementation
+ */
+
+inline IncomingCell::IncomingCell() : isotropic_(false),
+                                      numCorners_(0) {}
+
+} // namespace lb
+
+#endif // LIBBSDF_INCOMING_CELL_H
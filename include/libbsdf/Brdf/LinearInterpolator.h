@@ -9,7 +9,10 @@
 #ifndef LIBBSDF_LINEAR_INTERPOLATOR_H
 #define LIBBSDF_LINEAR_INTERPOLATOR_H
 
+#include <libbsdf/Brdf/IncomingCell.h>
+#include <libbsdf/Brdf/LookupContext.h>
 #include <libbsdf/Brdf/SampleSet.h>
+#include <libbsdf/Common/Simd.h>
 #include <libbsdf/Common/Vector.h>
 #include <libbsdf/Common/Utility.h>
 
@@ -22,11 +25,15 @@ class SampleSet2D;
  * \brief   The LinearInterpolator class provides the functions for linear interpolation.
  *
  * \a angle1 is not used for isotropic BRDFs.
+ * getSpectra() interpolates a batch of queries in SIMD lanes.
  */
 class LinearInterpolator
 {
 public:
-    /*! Gets the interpolated spectrum of sample points at a set of angles. */
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * Memory is not allocated if \a spectrum already has samples.getNumWavelengths() elements.
+     */
     static void getSpectrum(const SampleSet&    samples,
                             float               angle0,
                             float               angle1,
@@ -34,13 +41,85 @@ public:
                             float               angle3,
                             Spectrum*           spectrum);
 
-    /*! Gets the interpolated spectrum of sample points at a set of angles. */
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * Memory is not allocated if \a spectrum already has samples.getNumWavelengths() elements.
+     */
     static void getSpectrum(const SampleSet&    samples,
                             float               angle0,
                             float               angle2,
                             float               angle3,
                             Spectrum*           spectrum);
 
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * \a spectrum is an array of samples.getNumWavelengths() values. Memory is not allocated.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle1,
+                            float               angle2,
+                            float               angle3,
+                            float*              spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * \a spectrum is an array of samples.getNumWavelengths() values. Memory is not allocated.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle2,
+                            float               angle3,
+                            float*              spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * The cell found in the last query of \a context is reused if angles are in the same or an adjacent cell.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle1,
+                            float               angle2,
+                            float               angle3,
+                            LookupContext*      context,
+                            Spectrum*           spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * The cell found in the last query of \a context is reused if angles are in the same or an adjacent cell.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle2,
+                            float               angle3,
+                            LookupContext*      context,
+                            Spectrum*           spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * The cell found in the last query of \a context is reused if angles are in the same or an adjacent cell.
+     * \a spectrum is an array of samples.getNumWavelengths() values. Memory is not allocated.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle1,
+                            float               angle2,
+                            float               angle3,
+                            LookupContext*      context,
+                            float*              spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * The cell found in the last query of \a context is reused if angles are in the same or an adjacent cell.
+     * \a spectrum is an array of samples.getNumWavelengths() values. Memory is not allocated.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle2,
+                            float               angle3,
+                            LookupContext*      context,
+                            float*              spectrum);
+
     /*! Gets the interpolated value of sample points at a set of angles and the index of wavelength. */
     static float getValue(const SampleSet&  samples,
                           float             angle0,
@@ -56,6 +135,66 @@ public:
                           float             angle3,
                           int               wavelengthIndex);
 
+    /*!
+     * Gets the interpolated spectra of sample points at the sets of angles of \a numQueries queries.
+     * Each array of angles has \a numQueries values. The spectrum of the i-th query is written to
+     * \a spectra[i * samples.getNumWavelengths()] and following values.
+     */
+    static void getSpectra(const SampleSet& samples,
+                           int              numQueries,
+                           const float*     angles0,
+                           const float*     angles1,
+                           const float*     angles2,
+                           const float*     angles3,
+                           float*           spectra);
+
+    /*!
+     * Gets the interpolated spectra of isotropic sample points at the sets of angles of \a numQueries queries.
+     * Each array of angles has \a numQueries values. The spectrum of the i-th query is written to
+     * \a spectra[i * samples.getNumWavelengths()] and following values.
+     */
+    static void getSpectra(const SampleSet& samples,
+                           int              numQueries,
+                           const float*     angles0,
+                           const float*     angles2,
+                           const float*     angles3,
+                           float*           spectra);
+
+    /*!
+     * Finds the cell of angle0 and angle1 for the queries with fixed incoming angles.
+     * The cell is valid until the angles of \a samples are modified.
+     */
+    static void findIncomingCell(const SampleSet&   samples,
+                                 float              angle0,
+                                 float              angle1,
+                                 IncomingCell*      cell);
+
+    /*! Finds the cell of angle0 for the queries of isotropic data with a fixed incoming polar angle. */
+    static void findIncomingCell(const SampleSet&   samples,
+                                 float              angle0,
+                                 IncomingCell*      cell);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at angle2 and angle3 within the cell of fixed angle0 and angle1.
+     * The result is the same as getSpectrum() with all angles.
+     * \a spectrum is an array of samples.getNumWavelengths() values. Memory is not allocated.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            const IncomingCell& cell,
+                            float               angle2,
+                            float               angle3,
+                            float*              spectrum);
+
+    /*!
+     * Gets the interpolated value of sample points at angle2 and angle3 within the cell of fixed angle0 and angle1
+     * and the index of wavelength.
+     */
+    static float getValue(const SampleSet&      samples,
+                          const IncomingCell&   cell,
+                          float                 angle2,
+                          float                 angle3,
+                          int                   wavelengthIndex);
+
     /*! Gets the interpolated spectrum of sample points at a set of angles. */
     static void getSpectrum(const SampleSet2D&  ss2,
                             float               theta,
@@ -68,21 +207,159 @@ public:
                             Spectrum*           spectrum);
 
 private:
+    /*!
+     * Finds the indices of the 16 sample points surrounding a set of angles
+     * and the weights of multilinear interpolation.
+     */
+    static void findSamples(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle1,
+                            float               angle2,
+                            float               angle3,
+                            int*                indices,
+                            float*              weights);
+
+    /*!
+     * Finds the indices of the 8 sample points surrounding a set of angles of isotropic data
+     * and the weights of multilinear interpolation.
+     */
+    static void findSamples(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle2,
+                            float               angle3,
+                            int*                indices,
+                            float*              weights);
+
+    /*!
+     * Finds the indices of the sample points at the corners of a cell.
+     * The cell has 8 corners if \a isotropic is true. Otherwise, it has 16 corners.
+     */
+    static void findCornerIndices(const SampleSet&  samples,
+                                  const int*        lowerIndices,
+                                  const int*        upperIndices,
+                                  bool              isotropic,
+                                  int*              indices);
+
+    /*! Computes the weights of multilinear interpolation at the corners of a cell. */
+    static void computeCornerWeights(const Vec4&    angles,
+                                     const Vec4&    lowerAngles,
+                                     const Vec4&    upperAngles,
+                                     const int*     lowerIndices,
+                                     const int*     upperIndices,
+                                     bool           isotropic,
+                                     float*         weights);
+
+    /*!
+     * Finds the indices of the sample points surrounding angle2 and angle3 within the cell of fixed angle0 and angle1
+     * and the weights of multilinear interpolation. Returns the number of sample points.
+     */
+    static int findSamples(const SampleSet&     samples,
+                           const IncomingCell&  cell,
+                           float                angle2,
+                           float                angle3,
+                           int*                 indices,
+                           float*               weights);
+
+    /*! Computes the weight of the upper bound of an angle. The weight is 0 if bounds have the same index. */
+    static float computeUpperWeight(float   angle,
+                                    float   lowerAngle,
+                                    float   upperAngle,
+                                    int     lowerIndex,
+                                    int     upperIndex);
+
+    /*!
+     * Finds neighbor indices and angles starting from the bounds of the last cell if \a cached is true.
+     * Returns false if the bounds are unchanged.
+     */
+    static bool findCachedBounds(const Arrayf&              angles,
+                                 const AngleLookupTable&    lookupTable,
+                                 float                      angle,
+                                 bool                       equalIntervalAngles,
+                                 bool                       cached,
+                                 int*                       lowerIndex,
+                                 int*                       upperIndex,
+                                 float*                     lowerAngle,
+                                 float*                     upperAngle);
+
+    /*! Computes the weighted sum of the spectra at sample indices. */
+    static void sumSpectra(const SampleSet& samples,
+                           const int*       indices,
+                           const float*     weights,
+                           int              numSamples,
+                           float*           spectrum);
+
+    /*!
+     * Computes the weighted sum of the spectra at sample indices.
+     * The number of wavelengths and the distance between them in the array of spectra are
+     * fixed at compile time unless \a NumWavelengths and \a WavelengthStride are Eigen::Dynamic.
+     */
+    template <int NumWavelengths, int WavelengthStride>
+    static void sumSpectra(const SampleSet& samples,
+                           const int*       indices,
+                           const float*     weights,
+                           int              numSamples,
+                           float*           spectrum);
+
+    /*!
+     * Computes the weighted sum of the spectra stored in half or bfloat16 precision at sample indices.
+     * Values are converted to single precision while they are summed.
+     */
+    template <int NumWavelengths, SpectrumPrecision Precision>
+    static void sumCompactSpectra(const SampleSet&  samples,
+                                  const int*        indices,
+                                  const float*      weights,
+                                  int               numSamples,
+                                  float*            spectrum);
+
+    /*! Computes the weighted sum of the values at sample indices and the index of wavelength. */
+    static float sumValues(const SampleSet& samples,
+                           const int*       indices,
+                           const float*     weights,
+                           int              numSamples,
+                           int              wavelengthIndex);
+
     /*!
      * Finds neighbor indices and angles.
+     * \a lookupTable is used to find the indices of angles at unequal intervals.
      *
      * \param lowerIndex Found index of the sample point at the lower bound.
      * \param upperIndex Found index of the sample point at the upper bound.
      * \param lowerAngle Found angle of the sample point at the lower bound.
      * \param upperAngle Found angle of the sample point at the upper bound.
      */
-    static void findBounds(const Arrayf&    angles,
-                           float            angle,
-                           bool             equalIntervalAngles,
-                           int*             lowerIndex,
-                           int*             upperIndex,
-                           Vec4::Scalar*    lowerAngle,
-                           Vec4::Scalar*    upperAngle);
+    static void findBounds(const Arrayf&            angles,
+                           const AngleLookupTable&  lookupTable,
+                           float                    angle,
+                           bool                     equalIntervalAngles,
+                           int*                     lowerIndex,
+                           int*                     upperIndex,
+                           Vec4::Scalar*            lowerAngle,
+                           Vec4::Scalar*            upperAngle);
+
+    /*!
+     * Gets the interpolated spectra of SIMD_WIDTH queries in SIMD lanes.
+     * Each array of angles has SIMD_WIDTH values. \a angles1 is 0 for isotropic data.
+     * The spectra of the first \a numLanes queries are written to \a spectra.
+     */
+    static void getLaneSpectra(const SampleSet& samples,
+                               const float*     angles0,
+                               const float*     angles1,
+                               const float*     angles2,
+                               const float*     angles3,
+                               int              numLanes,
+                               float*           spectra);
+
+    /*!
+     * Finds neighbor indices and the weights of upper bounds for SIMD_WIDTH angles.
+     * Weights are 0 if \a angles has a single angle.
+     */
+    static void findLaneBounds(const Arrayf&            angles,
+                               const AngleLookupTable&  lookupTable,
+                               bool                     equalIntervalAngles,
+                               const float*             laneAngles,
+                               int*                     lowerIndices,
+                               int*                     upperIndices,
+                               float*                   upperWeights);
 };
 
 } // namespace lb
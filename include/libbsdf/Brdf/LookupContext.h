@@ -0,0 +1,64 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_LOOKUP_CONTEXT_H
+#define LIBBSDF_LOOKUP_CONTEXT_H
+
+namespace lb {
+
+class SampleSet;
+
+/*!
+ * \class   LookupContext
+ * \brief   The LookupContext class holds the last cell of sample points found by an interpolator.
+ *
+ * Coherent queries, such as a sweep of outgoing directions with a fixed incoming direction,
+ * reuse the cell if angles are in the same or an adjacent cell, and skip searching for bounds
+ * and computing the indices of sample points.
+ * A context is used by one thread. reset() must be called after the angles or the symmetry of
+ * the sample set are modified.
+ */
+class LookupContext
+{
+public:
+    LookupContext();
+
+    /*! Discards the last cell. */
+    void reset();
+
+private:
+    friend class LinearInterpolator;
+
+    const SampleSet* samples_; /*!< The sample set of the last cell. */
+
+    bool isotropic_; /*!< This attribute holds whether the last cell was found with three angles. */
+
+    int lowerIndices_[4]; /*!< The indices of angles at the lower bounds of the last cell. */
+    int upperIndices_[4]; /*!< The indices of angles at the upper bounds of the last cell. */
+
+    float lowerAngles_[4]; /*!< The angles at the lower bounds of the last cell. */
+    float upperAngles_[4]; /*!< The angles at the upper bounds of the last cell. */
+
+    int indices_[16]; /*!< The indices of sample points at the corners of the last cell. */
+};
+
+/*
+ * Implementation
+ */
+
+inline LookupContext::LookupContext() : samples_(0),
+                                        isotropic_(false) {}
+
+inline void LookupContext::reset()
+{
+    samples_ = 0;
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_LOOKUP_CONTEXT_H
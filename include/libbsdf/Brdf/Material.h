@@ -35,6 +35,12 @@ public:
              SampleSet2D*   reflectionTis = 0,
              SampleSet2D*   transmissionTis = 0);
 
+    /*! Moves and constructs a material. \a material can only be destroyed or assigned. */
+    Material(Material&& material);
+
+    /*! Moves a material. */
+    Material& operator=(Material&& material);
+
     virtual ~Material();
 
     /*! Gets the BSDF data. */
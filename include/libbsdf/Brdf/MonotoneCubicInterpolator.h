@@ -0,0 +1,191 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_MONOTONE_CUBIC_INTERPOLATOR_H
+#define LIBBSDF_MONOTONE_CUBIC_INTERPOLATOR_H
+
+#include <libbsdf/Brdf/MonotoneCubicSlopeTable.h>
+
+namespace lb {
+
+/*!
+ * \class   MonotoneCubicInterpolator
+ * \brief   The MonotoneCubicInterpolator class provides the functions for monotone cubic interpolation.
+ *
+ * Spectra are interpolated with the monotone cubic Hermite splines of Fritsch and Carlson along each axis.
+ * Interpolated values do not overshoot the sample points of the cell. Slopes along angle3 are computed from
+ * all angles3 in lb::MonotoneCubicSlopeTable.
+ * Slopes along the other angles are computed from four interpolated values around the cell.
+ * Angle1 and angle3 are periodic if they cover [0, 2 * PI].
+ *
+ * \a angle1 is not used for isotropic BRDFs.
+ */
+class MonotoneCubicInterpolator
+{
+public:
+    /*! Gets the interpolated spectrum of sample points at a set of angles. */
+    static void getSpectrum(const MonotoneCubicSlopeTable&    table,
+                            float                             angle0,
+                            float                             angle1,
+                            float                             angle2,
+                            float                             angle3,
+                            Spectrum*                         spectrum);
+
+    /*! Gets the interpolated spectrum of sample points at a set of angles. */
+    static void getSpectrum(const MonotoneCubicSlopeTable&    table,
+                            float                             angle0,
+                            float                             angle2,
+                            float                             angle3,
+                            Spectrum*                         spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * \a spectrum is an array of table.getSampleSet()->getNumWavelengths() values.
+     */
+    static void getSpectrum(const MonotoneCubicSlopeTable&    table,
+                            float                             angle0,
+                            float                             angle1,
+                            float                             angle2,
+                            float                             angle3,
+                            float*                            spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at a set of angles.
+     * \a spectrum is an array of table.getSampleSet()->getNumWavelengths() values.
+     */
+    static void getSpectrum(const MonotoneCubicSlopeTable&    table,
+                            float                             angle0,
+                            float                             angle2,
+                            float                             angle3,
+                            float*                            spectrum);
+
+    /*! Gets the interpolated value of sample points at a set of angles and the index of wavelength. */
+    static float getValue(const MonotoneCubicSlopeTable&    table,
+                          float                             angle0,
+                          float                             angle1,
+                          float                             angle2,
+                          float                             angle3,
+                          int                               wavelengthIndex);
+
+    /*! Gets the interpolated value of sample points at a set of angles and the index of wavelength. */
+    static float getValue(const MonotoneCubicSlopeTable&    table,
+                          float                             angle0,
+                          float                             angle2,
+                          float                             angle3,
+                          int                               wavelengthIndex);
+
+private:
+    /*!
+     * Interpolates \a numWavelengths values from the index of wavelength at a set of angles.
+     * \a angle1 is not used for isotropic BRDFs.
+     */
+    static void interpolate(const MonotoneCubicSlopeTable&    table,
+                            float                             angle0,
+                            float                             angle1,
+                            float                             angle2,
+                            float                             angle3,
+                            int                               wavelengthIndex,
+                            int                               numWavelengths,
+                            float*                            values);
+
+    /*!
+     * Interpolates each group of \a numPoints values along an axis and stores the results
+     * at the beginning of \a values. Returns the number of results.
+     */
+    static int reduce(float*        values,
+                      int           numValues,
+                      int           numPoints,
+                      const float*  sampleAngles,
+                      float         angle);
+
+    /*!
+     * Finds the indices and angles of four sample points around the cell containing \a angle.
+     * The outer sample points are the same as the inner ones at the ends of angles unless \a periodic.
+     * Returns the number of sample points, which is 1 if \a angles has a single angle, otherwise 4.
+     */
+    static int findSamplePoints(const Arrayf&           angles,
+                                const AngleLookupTable& lookupTable,
+                                bool                    equalIntervalAngles,
+                                bool                    periodic,
+                                float                   angle,
+                                int*                    indices,
+                                float*                  sampleAngles);
+};
+
+/*
+ * Implementation
+ */
+
+inline void MonotoneCubicInterpolator::getSpectrum(const MonotoneCubicSlopeTable&    table,
+                                                   float                             angle0,
+                                                   float                             angle1,
+                                                   float                             angle2,
+                                                   float                             angle3,
+                                                   Spectrum*                         spectrum)
+{
+    int numWavelengths = table.getSampleSet()->getNumWavelengths();
+    spectrum->resize(numWavelengths);
+    interpolate(table, angle0, angle1, angle2, angle3, 0, numWavelengths, spectrum->data());
+}
+
+inline void MonotoneCubicInterpolator::getSpectrum(const MonotoneCubicSlopeTable&    table,
+                                                   float                             angle0,
+                                                   float                             angle2,
+                                                   float                             angle3,
+                                                   Spectrum*                         spectrum)
+{
+    int numWavelengths = table.getSampleSet()->getNumWavelengths();
+    spectrum->resize(numWavelengths);
+    interpolate(table, angle0, 0.0f, angle2, angle3, 0, numWavelengths, spectrum->data());
+}
+
+inline void MonotoneCubicInterpolator::getSpectrum(const MonotoneCubicSlopeTable&    table,
+                                                   float                             angle0,
+                                                   float                             angle1,
+                                                   float                             angle2,
+                                                   float                             angle3,
+                                                   float*                            spectrum)
+{
+    interpolate(table, angle0, angle1, angle2, angle3, 0, table.getSampleSet()->getNumWavelengths(), spectrum);
+}
+
+inline void MonotoneCubicInterpolator::getSpectrum(const MonotoneCubicSlopeTable&    table,
+                                                   float                             angle0,
+                                                   float                             angle2,
+                                                   float                             angle3,
+                                                   float*                            spectrum)
+{
+    interpolate(table, angle0, 0.0f, angle2, angle3, 0, table.getSampleSet()->getNumWavelengths(), spectrum);
+}
+
+inline float MonotoneCubicInterpolator::getValue(const MonotoneCubicSlopeTable&    table,
+                                                 float                             angle0,
+                                                 float                             angle1,
+                                                 float                             angle2,
+                                                 float                             angle3,
+                                                 int                               wavelengthIndex)
+{
+    float value;
+    interpolate(table, angle0, angle1, angle2, angle3, wavelengthIndex, 1, &value);
+    return value;
+}
+
+inline float MonotoneCubicInterpolator::getValue(const MonotoneCubicSlopeTable&    table,
+                                                 float                             angle0,
+                                                 float                             angle2,
+                                                 float                             angle3,
+                                                 int                               wavelengthIndex)
+{
+    float value;
+    interpolate(table, angle0, 0.0f, angle2, angle3, wavelengthIndex, 1, &value);
+    return value;
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_MONOTONE_CUBIC_INTERPOLATOR_H
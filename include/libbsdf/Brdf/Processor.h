@@ -14,6 +14,8 @@
 #ifndef LIBBSDF_PROCESSOR_H
 #define LIBBSDF_PROCESSOR_H
 
+#include <memory>
+
 #include <libbsdf/Common/Global.h>
 
 namespace lb {
@@ -36,6 +38,12 @@ void divideByCosineOutTheta(Brdf* brdf);
  */
 SphericalCoordinatesBrdf* fillSymmetricBrdf(SphericalCoordinatesBrdf* brdf);
 
+/*!
+ * \brief Fills omitted data using plane symmetry.
+ * \return A new BRDF with appended angles.
+ */
+std::unique_ptr<SphericalCoordinatesBrdf> fillSymmetricBrdf(const SphericalCoordinatesBrdf& brdf);
+
 /*! \brief Fills the samples at the incoming polar angle of 0 using rotational symmetry. */
 void fillIncomingPolar0Data(Brdf* brdf);
 
@@ -46,6 +54,16 @@ void fillIncomingPolar0Data(Brdf* brdf);
 SphericalCoordinatesBrdf* rotateOutPhi(const SphericalCoordinatesBrdf&  brdf,
                                        float                            rotationAngle);
 
+/*!
+ * \brief Rotates a BRDF using an outgoing azimuthal angle.
+ *
+ * The angles and spectra of \a brdf are moved into the returned BRDF.
+ *
+ * \return A BRDF with rotated angles.
+ */
+std::unique_ptr<SphericalCoordinatesBrdf> rotateOutPhi(SphericalCoordinatesBrdf&&  brdf,
+                                                       float                       rotationAngle);
+
 /*! \brief Fixes the energy conservation of the BRDF with each incoming direction. */
 void fixEnergyConservation(SpecularCoordinatesBrdf* brdf);
 
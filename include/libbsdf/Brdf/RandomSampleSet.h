@@ -182,13 +182,16 @@ const Spectrum& RandomSampleSet<CoordSysT>::estimateSpectrum(const AngleList&
 template <typename CoordSysT>
 void RandomSampleSet<CoordSysT>::setupBrdf(SphericalCoordinatesBrdf* brdf)
 {
+    // Copy shared spectra before they are modified in parallel.
+    brdf->getSampleSet()->makeSpectraUnique();
+
     for (int inThIndex = 0;  inThIndex < brdf->getNumInTheta();   ++inThIndex)  {
     for (int inPhIndex = 0;  inPhIndex < brdf->getNumInPhi();     ++inPhIndex)  {
     for (int outThIndex = 0; outThIndex < brdf->getNumOutTheta(); ++outThIndex) {
         RandomSampleSet::AngleList angles;
         SampleMap::iterator it;
         #pragma omp parallel for private(angles, it)
-        for (int outPhIndex = 0; outPhIndex < brdf->getNumOutPhi(); ++outPhIndex) {
+        for (int outPhIndex = 0; outPhIndex < brdf->getSampleSet()->getNumStoredAngles3(); ++outPhIndex) {
             angles.resize(4);
             angles.at(0) = brdf->getInTheta(inThIndex);
             angles.at(1) = brdf->getInPhi(inPhIndex);
@@ -223,6 +226,9 @@ void RandomSampleSet<CoordSysT>::setupBrdf(SpecularCoordinatesBrdf* brdf,
                                            float                    weight2,
                                            float                    weight3)
 {
+    // Copy shared spectra before they are modified in parallel.
+    brdf->getSampleSet()->makeSpectraUnique();
+
     for (int inThIndex = 0; inThIndex < brdf->getNumInTheta();   ++inThIndex) {
     for (int inPhIndex = 0; inPhIndex < brdf->getNumInPhi();     ++inPhIndex) {
     for (int spThIndex = 0; spThIndex < brdf->getNumSpecTheta(); ++spThIndex) {
@@ -230,7 +236,7 @@ void RandomSampleSet<CoordSysT>::setupBrdf(SpecularCoordinatesBrdf* brdf,
         SampleMap::iterator it;
         float w3;
         #pragma omp parallel for private(angles, it, w3)
-        for (int spPhIndex = 0; spPhIndex < brdf->getNumSpecPhi(); ++spPhIndex) {
+        for (int spPhIndex = 0; spPhIndex < brdf->getSampleSet()->getNumStoredAngles3(); ++spPhIndex) {
             angles.resize(4);
             angles.at(0) = brdf->getInTheta(inThIndex);
             angles.at(1) = brdf->getInPhi(inPhIndex);
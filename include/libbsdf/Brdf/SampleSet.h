@@ -10,9 +10,14 @@
 #define LIBBSDF_SAMPLE_SET_H
 
 #include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
+#include <libbsdf/Common/AngleLookupTable.h>
 #include <libbsdf/Common/Array.h>
 #include <libbsdf/Common/Global.h>
+#include <libbsdf/Common/Half.h>
 #include <libbsdf/Common/Vector.h>
 
 namespace lb {
@@ -31,35 +36,75 @@ namespace lb {
  *   - \a angle3 (e.g. outgoing azimuthal angle of a spherical coordinate system)
  *
  * \a angle1 is not used for isotropic BRDFs.
+ *
+ * Spectra are stored in a contiguous array and accessed through lb::SpectrumMap.
+ * With lb::INTERLEAVED_LAYOUT, the spectrum of a sample point occupies getNumWavelengths()
+ * consecutive elements. With lb::PLANAR_LAYOUT, the values of a wavelength at all sample points
+ * are consecutive, which suits lookups of a single wavelength.
+ *
+ * Spectra can be stored in half or bfloat16 precision to save memory. In that case, spectra are
+ * read-only. lb::SpectrumMap and getSpectra() are not available, and values are read with
+ * getSpectrum(int, Spectrum*) or getValue(int, int), which convert them to single precision.
+ *
+ * With lb::PLANE_SYMMETRY, the spectra at angle3 in (PI, 2 * PI] are not stored and indices of them
+ * are mapped to the mirrored angle3 in getIndex(). Sample points are accessed with all angle3 as usual.
+ *
+ * The array of spectra can be backed by an external memory block such as a memory-mapped file
+ * with setExternalSpectra(). The memory block is not copied.
+ *
+ * Copies of a sample set share the array of spectra. The array is copied on the first mutable access
+ * with getSpectrum(), setSpectrum(), or getSpectra() if it is shared. Before spectra are modified
+ * in parallel, makeSpectraUnique() must be called in a single thread.
  */
 class SampleSet
 {
 public:
-    /*! Constructs the sample points of a BRDF. */
-    SampleSet(int           numAngles0,
-              int           numAngles1,
-              int           numAngles2,
-              int           numAngles3,
-              ColorModel    colorModel = RGB_MODEL,
-              int           numWavelengths = 3);
+    /*!
+     * Constructs the sample points of a BRDF.
+     * If \a spectraAllocated is false, the array of spectra is not allocated and must be set with
+     * setExternalSpectra() before spectra are accessed.
+     */
+    SampleSet(int               numAngles0,
+              int               numAngles1,
+              int               numAngles2,
+              int               numAngles3,
+              ColorModel        colorModel = RGB_MODEL,
+              int               numWavelengths = 3,
+              SpectrumLayout    spectrumLayout = INTERLEAVED_LAYOUT,
+              bool              spectraAllocated = true);
+
+    /*! Copies and constructs the sample points. Spectra are shared until either is modified. */
+    SampleSet(const SampleSet& samples);
+
+    /*! Moves and constructs the sample points. \a samples can only be destroyed or assigned. */
+    SampleSet(SampleSet&& samples);
+
+    /*! Moves the sample points. \a samples can only be destroyed or assigned. */
+    SampleSet& operator=(SampleSet&& samples);
 
     /*! Gets the spectrum at a set of angle indices. */
-    Spectrum& getSpectrum(int index0, int index1, int index2, int index3);
+    SpectrumMap getSpectrum(int index0, int index1, int index2, int index3);
 
     /*! Gets the spectrum at a set of angle indices of isotropic data. */
-    Spectrum& getSpectrum(int index0, int index2, int index3);
+    SpectrumMap getSpectrum(int index0, int index2, int index3);
 
     /*! Gets the spectrum at a set of angle indices. */
-    const Spectrum& getSpectrum(int index0, int index1, int index2, int index3) const;
+    ConstSpectrumMap getSpectrum(int index0, int index1, int index2, int index3) const;
 
     /*! Gets the spectrum at a set of angle indices of isotropic data. */
-    const Spectrum& getSpectrum(int index0, int index2, int index3) const;
+    ConstSpectrumMap getSpectrum(int index0, int index2, int index3) const;
 
     /*! Gets the spectrum at an index. */
-    Spectrum& getSpectrum(int index);
+    SpectrumMap getSpectrum(int index);
 
     /*! Gets the spectrum at an index. */
-    const Spectrum& getSpectrum(int index) const;
+    ConstSpectrumMap getSpectrum(int index) const;
+
+    /*! Gets the spectrum at an index converted from the storage precision. */
+    void getSpectrum(int index, Spectrum* spectrum) const;
+
+    /*! Gets the value at an index and the index of wavelength converted from the storage precision. */
+    float getValue(int index, int wavelengthIndex) const;
 
     /*! Sets the spectrum at a set of angle indices. */
     void setSpectrum(int index0, int index1, int index2, int index3,
@@ -69,11 +114,92 @@ public:
     void setSpectrum(int index0, int index2, int index3,
                      const Spectrum& spectrum);
 
-    /*! Gets all spectra. */
-    SpectrumList& getSpectra();
+    /*!
+     * Gets all spectra as a contiguous array.
+     * The value at a sample index and the index of wavelength is the element of
+     * index * getSampleStride() + wavelengthIndex * getWavelengthStride().
+     */
+    ArrayfMap getSpectra();
+
+    /*!
+     * Gets all spectra as a contiguous array.
+     * The value at a sample index and the index of wavelength is the element of
+     * index * getSampleStride() + wavelengthIndex * getWavelengthStride().
+     */
+    ConstArrayfMap getSpectra() const;
+
+    /*!
+     * Copies spectra into an owned array if the array is shared with another sample set.
+     * This must be called in a single thread before spectra are modified in parallel.
+     */
+    void makeSpectraUnique();
+
+    /*!
+     * Uses an external memory block as the array of spectra in single precision without copying.
+     * \a spectra must have getNumSamples() * getNumWavelengths() elements in \a spectrumLayout.
+     * \a storage keeps the memory block alive while the sample set uses it.
+     */
+    void setExternalSpectra(float*                          spectra,
+                            SpectrumLayout                  spectrumLayout,
+                            const std::shared_ptr<void>&    storage);
+
+    /*!
+     * Uses an external memory block as the array of spectra in half or bfloat16 precision
+     * without copying. Spectra are read-only.
+     */
+    void setExternalSpectra(const uint16_t*                 spectra,
+                            SpectrumLayout                  spectrumLayout,
+                            SpectrumPrecision               spectrumPrecision,
+                            const std::shared_ptr<void>&    storage);
+
+    /*! Gets the number of sample points stored in the array of spectra. */
+    int getNumSamples() const;
+
+    /*! Gets the symmetry of spectra. */
+    SymmetryType getSymmetry() const;
+
+    /*!
+     * Sets the symmetry of spectra and converts the array of spectra.
+     * Spectra of omitted sample points are discarded and restored from symmetric sample points.
+     * If \a convertSpectra is false, the array of spectra is reallocated and must be initialized.
+     * The array is not allocated if the sample set was constructed without the array of spectra.
+     * With lb::PLANE_SYMMETRY, each angle3 in (PI, 2 * PI] must have the mirrored angle3 in [0, PI].
+     * Angles must not be changed while the symmetry is set.
+     * Returns false if angles do not have the symmetry.
+     */
+    bool setSymmetry(SymmetryType symmetry, bool convertSpectra = true);
+
+    /*!
+     * Gets the number of angles3 whose spectra are stored. Stored angles3 are the first angles3 in the array.
+     * It is less than getNumAngles3() with lb::PLANE_SYMMETRY.
+     */
+    int getNumStoredAngles3() const;
+
+    /*! Gets the memory layout of spectra. */
+    SpectrumLayout getSpectrumLayout() const;
+
+    /*! Converts spectra to a memory layout. */
+    void setSpectrumLayout(SpectrumLayout spectrumLayout);
+
+    /*! Gets the storage precision of spectra. */
+    SpectrumPrecision getSpectrumPrecision() const;
+
+    /*!
+     * Converts spectra to a storage precision. The maximum and root mean square errors of
+     * the conversion are assigned to \a maxError and \a rmsError if they are not null.
+     */
+    void setSpectrumPrecision(SpectrumPrecision  spectrumPrecision,
+                              float*             maxError = 0,
+                              float*             rmsError = 0);
+
+    /*! Gets spectra stored in half or bfloat16 precision. */
+    const uint16_t* getCompactSpectra() const;
+
+    /*! Gets the distance between the elements of adjacent sample points in the array of spectra. */
+    int getSampleStride() const;
 
-    /*! Gets all spectra. */
-    const SpectrumList& getSpectra() const;
+    /*! Gets the distance between the elements of adjacent wavelengths in the array of spectra. */
+    int getWavelengthStride() const;
 
     float getAngle0(int index) const; /*!< Gets the angle0 at an index. */
     float getAngle1(int index) const; /*!< Gets the angle1 at an index. */
@@ -85,6 +211,15 @@ public:
     void setAngle2(int index, float angle); /*!< Sets the angle2 at an index. */
     void setAngle3(int index, float angle); /*!< Sets the angle3 at an index. */
 
+    /*!
+     * Sets the array of angle0. The size of \a angles must be equal to the number of angles0.
+     * Angle attributes are updated once for the array.
+     */
+    void setAngles0(const Arrayf& angles);
+    void setAngles1(const Arrayf& angles); /*!< Sets the array of angle1. \sa setAngles0() */
+    void setAngles2(const Arrayf& angles); /*!< Sets the array of angle2. \sa setAngles0() */
+    void setAngles3(const Arrayf& angles); /*!< Sets the array of angle3. \sa setAngles0() */
+
     Arrayf& getAngles0(); /*!< Gets The array of angle0. */
     Arrayf& getAngles1(); /*!< Gets The array of angle1. */
     Arrayf& getAngles2(); /*!< Gets The array of angle2. */
@@ -105,6 +240,11 @@ public:
     bool isEqualIntervalAngles2() const; /*!< Returns true if angles2 are set at equal intervals. */
     bool isEqualIntervalAngles3() const; /*!< Returns true if angles3 are set at equal intervals. */
 
+    const AngleLookupTable& getAngleLookupTable0() const; /*!< Gets the lookup table of angles0. */
+    const AngleLookupTable& getAngleLookupTable1() const; /*!< Gets the lookup table of angles1. */
+    const AngleLookupTable& getAngleLookupTable2() const; /*!< Gets the lookup table of angles2. */
+    const AngleLookupTable& getAngleLookupTable3() const; /*!< Gets the lookup table of angles3. */
+
     /*! Gets the color model. */
     ColorModel getColorModel() const;
 
@@ -152,20 +292,78 @@ public:
     /*! Resizes the number of wavelengths. Wavelengths and spectra must be initialized. */
     void resizeWavelengths(int numWavelengths);
 
-private:
+    /*!
+     * \brief Inserts angles into the arrays of angles.
+     *
+     * Existing spectra are moved to the indices after insertion. Spectra at inserted angles
+     * must be initialized. Inserted angles must be sorted in ascending order and must not
+     * be equal to existing angles. Symmetric spectra are expanded and spectra are converted
+     * to single precision.
+     */
+    void insertAngles(const Arrayf& insertedAngles0,
+                      const Arrayf& insertedAngles1,
+                      const Arrayf& insertedAngles2,
+                      const Arrayf& insertedAngles3);
+
     /*! Gets the index of the spectrum from a set of angle indices. */
     int getIndex(int index0, int index1, int index2, int index3) const;
 
     /*! Gets the index of the spectrum from a set of angle indices of isotropic data. */
     int getIndex(int index0, int index2, int index3) const;
 
+private:
+    /*! Copy operator is disabled. */
+    SampleSet& operator=(const SampleSet&);
+
+    /*! Allocates an owned array of spectra in single precision. Spectra are not initialized. */
+    void allocateSpectra();
+
+    /*! Copies spectra in an external or shared memory block into an owned array. */
+    void detachSpectra();
+
+    /*!
+     * Computes the indices of stored angles3 for each angle3 with lb::PLANE_SYMMETRY.
+     * Returns false if angles3 are not symmetric.
+     */
+    bool computePlaneSymmetricIndices(std::vector<int>* storedIndices3, int* numStoredAngles3) const;
+
+    /*!
+     * Merges sorted \a angles and \a insertedAngles into \a mergedAngles.
+     * \a indices returns the merged index of each element of \a angles.
+     */
+    static void mergeAngles(const Arrayf&       angles,
+                            const Arrayf&       insertedAngles,
+                            Arrayf*             mergedAngles,
+                            std::vector<int>*   indices);
+
     /*! Updates the attributes whether angles are set at equal intervals. */
     void updateEqualIntervalAngles();
 
+    /*! Builds the lookup tables of angles. */
+    void updateAngleLookupTables();
+
     /*! Updates the attributes whether sample points are containd in one side of the plane of incidence. */
     void updateOneSide();
 
-    SpectrumList spectra_; /*!< The list of spectrum for each pair of incoming and outgoing directions. */
+    /*! The contiguous array of spectra for each pair of incoming and outgoing directions. */
+    float* spectra_;
+
+    /*! The array of spectra stored in half or bfloat16 precision. */
+    const uint16_t* compactSpectra_;
+
+    /*! The memory block of spectra. It is an owned array or an external block such as a mapped file. */
+    std::shared_ptr<void> spectraStorage_;
+
+    SpectrumLayout spectrumLayout_; /*!< The memory layout of spectra. */
+
+    SpectrumPrecision spectrumPrecision_; /*!< The storage precision of spectra. */
+
+    SymmetryType symmetry_; /*!< The symmetry of spectra. */
+
+    /*! The indices of stored angles3 for each angle3. This is used with lb::PLANE_SYMMETRY. */
+    std::vector<int> storedIndices3_;
+
+    int numStoredAngles3_; /*!< The number of angles3 whose spectra are stored. */
 
     Arrayf angles0_; /*!< The array of angle0. */
     Arrayf angles1_; /*!< The array of angle1. */
@@ -182,6 +380,11 @@ private:
     bool equalIntervalAngles2_; /*!< This attribute holds whether angles2 are set at equal intervals. */
     bool equalIntervalAngles3_; /*!< This attribute holds whether angles3 are set at equal intervals. */
 
+    AngleLookupTable angleLookupTable0_; /*!< The lookup table to find the interval of angles0 containing an angle. */
+    AngleLookupTable angleLookupTable1_; /*!< The lookup table to find the interval of angles1 containing an angle. */
+    AngleLookupTable angleLookupTable2_; /*!< The lookup table to find the interval of angles2 containing an angle. */
+    AngleLookupTable angleLookupTable3_; /*!< The lookup table to find the interval of angles3 containing an angle. */
+
     ColorModel colorModel_; /*!< The color model of spectra. */
 
     Arrayf wavelengths_; /*!< The array of wavelengths. */
@@ -190,43 +393,134 @@ private:
     bool oneSide_;
 };
 
-inline Spectrum& SampleSet::getSpectrum(int index0, int index1, int index2, int index3)
+inline SpectrumMap SampleSet::getSpectrum(int index0, int index1, int index2, int index3)
 {
-    return spectra_.at(getIndex(index0, index1, index2, index3));
+    return getSpectrum(getIndex(index0, index1, index2, index3));
 }
 
-inline Spectrum& SampleSet::getSpectrum(int index0, int index2, int index3)
+inline SpectrumMap SampleSet::getSpectrum(int index0, int index2, int index3)
 {
-    return spectra_.at(getIndex(index0, index2, index3));
+    return getSpectrum(getIndex(index0, index2, index3));
 }
 
-inline const Spectrum& SampleSet::getSpectrum(int index0, int index1, int index2, int index3) const
+inline ConstSpectrumMap SampleSet::getSpectrum(int index0, int index1, int index2, int index3) const
 {
-    return spectra_.at(getIndex(index0, index1, index2, index3));
+    return getSpectrum(getIndex(index0, index1, index2, index3));
 }
 
-inline const Spectrum& SampleSet::getSpectrum(int index0, int index2, int index3) const
+inline ConstSpectrumMap SampleSet::getSpectrum(int index0, int index2, int index3) const
 {
-    return spectra_.at(getIndex(index0, index2, index3));
+    return getSpectrum(getIndex(index0, index2, index3));
 }
 
-inline       Spectrum& SampleSet::getSpectrum(int index)       { return spectra_.at(index); }
-inline const Spectrum& SampleSet::getSpectrum(int index) const { return spectra_.at(index); }
+inline SpectrumMap SampleSet::getSpectrum(int index)
+{
+    assert(index >= 0 && index < getNumSamples());
+    assert(spectrumPrecision_ == SINGLE_PRECISION);
+
+    makeSpectraUnique();
+
+    return SpectrumMap(spectra_ + index * getSampleStride(),
+                       wavelengths_.size(),
+                       Eigen::InnerStride<>(getWavelengthStride()));
+}
+
+inline ConstSpectrumMap SampleSet::getSpectrum(int index) const
+{
+    assert(index >= 0 && index < getNumSamples());
+    assert(spectrumPrecision_ == SINGLE_PRECISION);
+
+    return ConstSpectrumMap(spectra_ + index * getSampleStride(),
+                            wavelengths_.size(),
+                            Eigen::InnerStride<>(getWavelengthStride()));
+}
 
 inline void SampleSet::setSpectrum(int index0, int index1, int index2, int index3,
                                    const Spectrum& spectrum)
 {
-    spectra_.at(getIndex(index0, index1, index2, index3)) = spectrum;
+    assert(spectrum.size() == wavelengths_.size());
+    getSpectrum(index0, index1, index2, index3) = spectrum;
 }
 
 inline void SampleSet::setSpectrum(int index0, int index2, int index3,
                                    const Spectrum& spectrum)
 {
-    spectra_.at(getIndex(index0, index2, index3)) = spectrum;
+    assert(spectrum.size() == wavelengths_.size());
+    getSpectrum(index0, index2, index3) = spectrum;
+}
+
+inline void SampleSet::getSpectrum(int index, Spectrum* spectrum) const
+{
+    assert(index >= 0 && index < getNumSamples());
+
+    if (spectrumPrecision_ == SINGLE_PRECISION) {
+        *spectrum = getSpectrum(index);
+        return;
+    }
+
+    int numWavelengths = getNumWavelengths();
+    int wavelengthStride = getWavelengthStride();
+    const uint16_t* values = &compactSpectra_[index * getSampleStride()];
+
+    spectrum->resize(numWavelengths);
+    for (int i = 0; i < numWavelengths; ++i) {
+        (*spectrum)[i] = toFloat(values[i * wavelengthStride], spectrumPrecision_);
+    }
+}
+
+inline float SampleSet::getValue(int index, int wavelengthIndex) const
+{
+    assert(index >= 0 && index < getNumSamples());
+    assert(wavelengthIndex >= 0 && wavelengthIndex < getNumWavelengths());
+
+    int offset = index * getSampleStride() + wavelengthIndex * getWavelengthStride();
+
+    if (spectrumPrecision_ == SINGLE_PRECISION) {
+        return spectra_[offset];
+    }
+    else {
+        return toFloat(compactSpectra_[offset], spectrumPrecision_);
+    }
+}
+
+inline ArrayfMap SampleSet::getSpectra()
+{
+    assert(spectrumPrecision_ == SINGLE_PRECISION);
+
+    makeSpectraUnique();
+    return ArrayfMap(spectra_, getNumSamples() * getNumWavelengths());
+}
+
+inline ConstArrayfMap SampleSet::getSpectra() const
+{
+    assert(spectrumPrecision_ == SINGLE_PRECISION);
+    return ConstArrayfMap(spectra_, getNumSamples() * getNumWavelengths());
+}
+
+inline int SampleSet::getNumSamples() const
+{
+    return numAngles0_ * numAngles1_ * numAngles2_ * numStoredAngles3_;
 }
 
-inline       SpectrumList& SampleSet::getSpectra()       { return spectra_; }
-inline const SpectrumList& SampleSet::getSpectra() const { return spectra_; }
+inline SymmetryType SampleSet::getSymmetry() const { return symmetry_; }
+
+inline int SampleSet::getNumStoredAngles3() const { return numStoredAngles3_; }
+
+inline SpectrumLayout SampleSet::getSpectrumLayout() const { return spectrumLayout_; }
+
+inline SpectrumPrecision SampleSet::getSpectrumPrecision() const { return spectrumPrecision_; }
+
+inline const uint16_t* SampleSet::getCompactSpectra() const { return compactSpectra_; }
+
+inline int SampleSet::getSampleStride() const
+{
+    return (spectrumLayout_ == PLANAR_LAYOUT) ? 1 : static_cast<int>(wavelengths_.size());
+}
+
+inline int SampleSet::getWavelengthStride() const
+{
+    return (spectrumLayout_ == PLANAR_LAYOUT) ? getNumSamples() : 1;
+}
 
 inline float SampleSet::getAngle0(int index) const { return angles0_[index]; }
 inline float SampleSet::getAngle1(int index) const { return angles1_[index]; }
@@ -257,6 +551,39 @@ inline void SampleSet::setAngle3(int index, float angle)
     equalIntervalAngles3_ = isEqualInterval(angles3_);
 }
 
+inline void SampleSet::setAngles0(const Arrayf& angles)
+{
+    assert(angles.size() == numAngles0_);
+    angles0_ = angles;
+    equalIntervalAngles0_ = isEqualInterval(angles0_);
+    angleLookupTable0_.build(angles0_);
+}
+
+inline void SampleSet::setAngles1(const Arrayf& angles)
+{
+    assert(angles.size() == numAngles1_);
+    angles1_ = angles;
+    equalIntervalAngles1_ = isEqualInterval(angles1_);
+    angleLookupTable1_.build(angles1_);
+}
+
+inline void SampleSet::setAngles2(const Arrayf& angles)
+{
+    assert(angles.size() == numAngles2_);
+    angles2_ = angles;
+    equalIntervalAngles2_ = isEqualInterval(angles2_);
+    angleLookupTable2_.build(angles2_);
+}
+
+inline void SampleSet::setAngles3(const Arrayf& angles)
+{
+    assert(angles.size() == numAngles3_);
+    angles3_ = angles;
+    equalIntervalAngles3_ = isEqualInterval(angles3_);
+    angleLookupTable3_.build(angles3_);
+    updateOneSide();
+}
+
 inline Arrayf& SampleSet::getAngles0() { return angles0_; }
 inline Arrayf& SampleSet::getAngles1() { return angles1_; }
 inline Arrayf& SampleSet::getAngles2() { return angles2_; }
@@ -277,6 +604,11 @@ inline bool SampleSet::isEqualIntervalAngles1() const { return equalIntervalAngl
 inline bool SampleSet::isEqualIntervalAngles2() const { return equalIntervalAngles2_; }
 inline bool SampleSet::isEqualIntervalAngles3() const { return equalIntervalAngles3_; }
 
+inline const AngleLookupTable& SampleSet::getAngleLookupTable0() const { return angleLookupTable0_; }
+inline const AngleLookupTable& SampleSet::getAngleLookupTable1() const { return angleLookupTable1_; }
+inline const AngleLookupTable& SampleSet::getAngleLookupTable2() const { return angleLookupTable2_; }
+inline const AngleLookupTable& SampleSet::getAngleLookupTable3() const { return angleLookupTable3_; }
+
 inline ColorModel SampleSet::getColorModel() const { return colorModel_; }
 
 inline void SampleSet::setColorModel(ColorModel colorModel)
@@ -303,11 +635,22 @@ inline bool SampleSet::isIsotropic() const { return (numAngles1_ == 1); }
 
 inline bool SampleSet::isOneSide() const { return oneSide_; }
 
+inline void SampleSet::makeSpectraUnique()
+{
+    if (spectraStorage_.use_count() > 1) {
+        detachSpectra();
+    }
+}
+
 inline int SampleSet::getIndex(int index0, int index1, int index2, int index3) const
 {
     assert(index0 >= 0 && index1 >= 0 && index2 >= 0 && index3 >= 0);
     assert(index0 < numAngles0_ && index1 < numAngles1_ && index2 < numAngles2_ && index3 < numAngles3_);
 
+    if (symmetry_ == PLANE_SYMMETRY) {
+        index3 = storedIndices3_[index3];
+    }
+
     int index = index0
               + numAngles0_ * index1
               + numAngles0_ * numAngles1_ * index2
@@ -320,6 +663,10 @@ inline int SampleSet::getIndex(int index0, int index2, int index3) const
     assert(index0 >= 0 && index2 >= 0 && index3 >= 0);
     assert(index0 < numAngles0_ && index2 < numAngles2_ && index3 < numAngles3_);
 
+    if (symmetry_ == PLANE_SYMMETRY) {
+        index3 = storedIndices3_[index3];
+    }
+
     int index = index0
               + numAngles0_ * index2
               + numAngles0_ * numAngles2_ * index3;
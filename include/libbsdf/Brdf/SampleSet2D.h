@@ -10,6 +10,7 @@
 #define LIBBSDF_SAMPLE_SET_2D_H
 
 #include <libbsdf/Brdf/LinearInterpolator.h>
+#include <libbsdf/Common/AngleLookupTable.h>
 #include <libbsdf/Common/Global.h>
 #include <libbsdf/Common/SphericalCoordinateSystem.h>
 #include <libbsdf/Common/Vector.h>
@@ -33,6 +34,18 @@ public:
                 int         numWavelengths = 3,
                 bool        equalIntervalAngles = false);
 
+    /*! Copies and constructs a 2D sample array. */
+    SampleSet2D(const SampleSet2D& samples);
+
+    /*! Moves and constructs a 2D sample array. */
+    SampleSet2D(SampleSet2D&& samples);
+
+    /*! Copies a 2D sample array. */
+    SampleSet2D& operator=(const SampleSet2D& samples);
+
+    /*! Moves a 2D sample array. */
+    SampleSet2D& operator=(SampleSet2D&& samples);
+
     /*! Gets the spectrum at a direction. */
     Spectrum getSpectrum(const Vec3& dir) const;
 
@@ -78,6 +91,18 @@ public:
     void setTheta(int index, float angle); /*!< Sets the polar angle at an index. */
     void setPhi  (int index, float angle); /*!< Sets the azimuthal angle at an index. */
 
+    /*!
+     * Sets the array of polar angles. The size of \a angles must be equal to the number of polar angles.
+     * Angle attributes are updated once for the array.
+     */
+    void setThetaArray(const Arrayf& angles);
+
+    /*!
+     * Sets the array of azimuthal angles. The size of \a angles must be equal to the number of azimuthal angles.
+     * Angle attributes are updated once for the array.
+     */
+    void setPhiArray(const Arrayf& angles);
+
     Arrayf& getThetaArray(); /*!< Gets the array of polar angles. */
     Arrayf& getPhiArray();   /*!< Gets the array of azimuthal angles. */
 
@@ -93,6 +118,12 @@ public:
     /*! Returns true if azimuthal angles are set at equal intervals. */
     bool isEqualIntervalPhi() const;
 
+    /*! Gets the lookup table of polar angles. */
+    const AngleLookupTable& getThetaLookupTable() const;
+
+    /*! Gets the lookup table of azimuthal angles. */
+    const AngleLookupTable& getPhiLookupTable() const;
+
     /*! Gets the color model. */
     ColorModel getColorModel() const;
 
@@ -135,6 +166,9 @@ private:
     bool equalIntervalTheta_; /*!< This attribute holds whether polar angles are set at equal intervals. */
     bool equalIntervalPhi_;   /*!< This attribute holds whether azimuthal angles are set at equal intervals. */
 
+    AngleLookupTable thetaLookupTable_; /*!< The lookup table to find the interval of polar angles containing an angle. */
+    AngleLookupTable phiLookupTable_;   /*!< The lookup table to find the interval of azimuthal angles containing an angle. */
+
     ColorModel colorModel_; /*!< The color model of spectra. */
 
     Arrayf wavelengths_; /*!< The array of wavelengths. */
@@ -216,6 +250,22 @@ inline void SampleSet2D::setPhi(int index, float angle)
     equalIntervalPhi_ = isEqualInterval(phiAngles_);
 }
 
+inline void SampleSet2D::setThetaArray(const Arrayf& angles)
+{
+    assert(angles.size() == numTheta_);
+    thetaAngles_ = angles.cwiseMax(0.0f).cwiseMin(SphericalCoordinateSystem::MAX_ANGLE0);
+    equalIntervalTheta_ = isEqualInterval(thetaAngles_);
+    thetaLookupTable_.build(thetaAngles_);
+}
+
+inline void SampleSet2D::setPhiArray(const Arrayf& angles)
+{
+    assert(angles.size() == numPhi_);
+    phiAngles_ = angles.cwiseMax(0.0f).cwiseMin(SphericalCoordinateSystem::MAX_ANGLE1);
+    equalIntervalPhi_ = isEqualInterval(phiAngles_);
+    phiLookupTable_.build(phiAngles_);
+}
+
 inline Arrayf& SampleSet2D::getThetaArray() { return thetaAngles_; }
 inline Arrayf& SampleSet2D::getPhiArray()   { return phiAngles_; }
 
@@ -228,6 +278,9 @@ inline int SampleSet2D::getNumPhi()   const { return numPhi_; }
 inline bool SampleSet2D::isEqualIntervalTheta() const { return equalIntervalTheta_; }
 inline bool SampleSet2D::isEqualIntervalPhi()   const { return equalIntervalPhi_; }
 
+inline const AngleLookupTable& SampleSet2D::getThetaLookupTable() const { return thetaLookupTable_; }
+inline const AngleLookupTable& SampleSet2D::getPhiLookupTable()   const { return phiLookupTable_; }
+
 inline ColorModel SampleSet2D::getColorModel() const { return colorModel_; }
 
 inline void SampleSet2D::setColorModel(ColorModel colorModel)
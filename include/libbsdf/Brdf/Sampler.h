@@ -9,8 +9,12 @@
 #ifndef LIBBSDF_SAMPLER_H
 #define LIBBSDF_SAMPLER_H
 
+#include <algorithm>
 #include <cassert>
 
+#include <libbsdf/Brdf/LookupContext.h>
+#include <libbsdf/Common/CoordinateSystemBatch.h>
+#include <libbsdf/Common/FastMath.h>
 #include <libbsdf/Common/Global.h>
 #include <libbsdf/Common/SphericalCoordinateSystem.h>
 
@@ -34,6 +38,40 @@ public:
                             const Vec3&         outDir,
                             Spectrum*           spectrum);
 
+    /*!
+     * Gets the interpolated spectrum of sample points at incoming and outgoing directions.
+     * \a spectrum is an array of samples.getNumWavelengths() values.
+     */
+    template <typename CoordSysT, typename InterpolatorT>
+    static void getSpectrum(const SampleSet&    samples,
+                            const Vec3&         inDir,
+                            const Vec3&         outDir,
+                            float*              spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at incoming and outgoing directions.
+     * \a context holds the last cell for coherent queries.
+     * \a spectrum is an array of samples.getNumWavelengths() values.
+     */
+    template <typename CoordSysT, typename InterpolatorT>
+    static void getSpectrum(const SampleSet&    samples,
+                            const Vec3&         inDir,
+                            const Vec3&         outDir,
+                            LookupContext*      context,
+                            float*              spectrum);
+
+    /*!
+     * Gets the spectrum of sample points at incoming and outgoing directions using a random number.
+     * \a randomNumber is a uniform random number in [0, 1] passed to InterpolatorT.
+     * \a spectrum is an array of samples.getNumWavelengths() values.
+     */
+    template <typename CoordSysT, typename InterpolatorT>
+    static void getSpectrumStochastic(const SampleSet&  samples,
+                                      const Vec3&       inDir,
+                                      const Vec3&       outDir,
+                                      float             randomNumber,
+                                      float*            spectrum);
+
     /*!
      * Gets the interpolated value of sample points at incoming and outgoing directions
      * and the index of wavelength.
@@ -44,6 +82,31 @@ public:
                           const Vec3&       outDir,
                           int               wavelengthIndex);
 
+    /*!
+     * Gets the interpolated spectra of sample points at \a numQueries pairs of incoming and outgoing directions.
+     * Directions are converted to angles in blocks by CoordinateSystemBatch and
+     * InterpolatorT::getSpectra() interpolates each block.
+     * The spectrum of the i-th query is written to \a spectra[i * samples.getNumWavelengths()] and following values.
+     */
+    template <typename CoordSysT, typename InterpolatorT>
+    static void getSpectra(const SampleSet& samples,
+                           const Vec3*      inDirs,
+                           const Vec3*      outDirs,
+                           int              numQueries,
+                           float*           spectra);
+
+    /*!
+     * Gets the interpolated values of sample points at \a numQueries pairs of incoming and outgoing directions
+     * and the index of wavelength.
+     */
+    template <typename CoordSysT, typename InterpolatorT>
+    static void getValues(const SampleSet&  samples,
+                          const Vec3*       inDirs,
+                          const Vec3*       outDirs,
+                          int               numQueries,
+                          int               wavelengthIndex,
+                          float*            values);
+
     /*! Gets the interpolated spectrum of sample points at incoming and outgoing directions. */
     template <typename InterpolatorT>
     static void getSpectrum(const Brdf& brdf,
@@ -51,6 +114,27 @@ public:
                             const Vec3& outDir,
                             Spectrum*   spectrum);
 
+    /*!
+     * Gets the interpolated spectrum of sample points at incoming and outgoing directions.
+     * \a spectrum is an array of brdf.getSampleSet()->getNumWavelengths() values.
+     */
+    template <typename InterpolatorT>
+    static void getSpectrum(const Brdf& brdf,
+                            const Vec3& inDir,
+                            const Vec3& outDir,
+                            float*      spectrum);
+
+    /*!
+     * Gets the interpolated spectrum of sample points at incoming and outgoing directions.
+     * \a context holds the last cell for coherent queries.
+     */
+    template <typename InterpolatorT>
+    static void getSpectrum(const Brdf&     brdf,
+                            const Vec3&     inDir,
+                            const Vec3&     outDir,
+                            LookupContext*  context,
+                            Spectrum*       spectrum);
+
     /*!
      * Gets the interpolated value of sample points at incoming and outgoing directions
      * and the index of wavelength.
@@ -68,8 +152,20 @@ public:
                             Spectrum*           spectrum);
     
 private:
+    /*! The number of queries converted to angles at a time in getSpectra(). */
+    static const int BLOCK_SIZE = 256;
+
+    /*! Copies the components of directions to structure-of-arrays buffers. */
+    static void toStructureOfArrays(const Vec3* inDirs,
+                                    const Vec3* outDirs,
+                                    int         numDirs,
+                                    float       inXyz[3][BLOCK_SIZE],
+                                    float       outXyz[3][BLOCK_SIZE]);
+
     static bool isIsotropic(const SampleSet& samples);
     static bool isIsotropic(const SampleSet2D& ss2);
+
+    static int getNumWavelengths(const SampleSet& samples);
     
     static const SampleSet* getSampleSet(const Brdf& brdf);
     
@@ -101,6 +197,65 @@ inline void Sampler::getSpectrum(const SampleSet&   samples,
     }
 }
 
+template <typename CoordSysT, typename InterpolatorT>
+inline void Sampler::getSpectrum(const SampleSet&   samples,
+                                 const Vec3&        inDir,
+                                 const Vec3&        outDir,
+                                 float*             spectrum)
+{
+    assert(inDir.z() >= 0.0);
+
+    float angle0, angle1, angle2, angle3;
+    if (isIsotropic(samples)) {
+        CoordSysT::fromXyz(inDir, outDir, &angle0, &angle2, &angle3);
+        InterpolatorT::getSpectrum(samples, angle0, angle2, angle3, spectrum);
+    }
+    else {
+        CoordSysT::fromXyz(inDir, outDir, &angle0, &angle1, &angle2, &angle3);
+        InterpolatorT::getSpectrum(samples, angle0, angle1, angle2, angle3, spectrum);
+    }
+}
+
+template <typename CoordSysT, typename InterpolatorT>
+inline void Sampler::getSpectrum(const SampleSet&   samples,
+                                 const Vec3&        inDir,
+                                 const Vec3&        outDir,
+                                 LookupContext*     context,
+                                 float*             spectrum)
+{
+    assert(inDir.z() >= 0.0);
+
+    float angle0, angle1, angle2, angle3;
+    if (isIsotropic(samples)) {
+        CoordSysT::fromXyz(inDir, outDir, &angle0, &angle2, &angle3);
+        InterpolatorT::getSpectrum(samples, angle0, angle2, angle3, context, spectrum);
+    }
+    else {
+        CoordSysT::fromXyz(inDir, outDir, &angle0, &angle1, &angle2, &angle3);
+        InterpolatorT::getSpectrum(samples, angle0, angle1, angle2, angle3, context, spectrum);
+    }
+}
+
+template <typename CoordSysT, typename InterpolatorT>
+inline void Sampler::getSpectrumStochastic(const SampleSet& samples,
+                                           const Vec3&      inDir,
+                                           const Vec3&      outDir,
+                                           float            randomNumber,
+                                           float*           spectrum)
+{
+    assert(inDir.z() >= 0.0);
+
+    float angle0, angle1, angle2, angle3;
+    if (isIsotropic(samples)) {
+        CoordSysT::fromXyz(inDir, outDir, &angle0, &angle2, &angle3);
+        InterpolatorT::getSpectrum(samples, angle0, angle2, angle3, randomNumber, spectrum);
+    }
+    else {
+        CoordSysT::fromXyz(inDir, outDir, &angle0, &angle1, &angle2, &angle3);
+        InterpolatorT::getSpectrum(samples, angle0, angle1, angle2, angle3, randomNumber, spectrum);
+    }
+}
+
 template <typename CoordSysT, typename InterpolatorT>
 inline float Sampler::getValue(const SampleSet& samples,
                                const Vec3&      inDir,
@@ -120,6 +275,94 @@ inline float Sampler::getValue(const SampleSet& samples,
     }
 }
 
+template <typename CoordSysT, typename InterpolatorT>
+inline void Sampler::getSpectra(const SampleSet&    samples,
+                                const Vec3*         inDirs,
+                                const Vec3*         outDirs,
+                                int                 numQueries,
+                                float*              spectra)
+{
+    const bool isotropic = isIsotropic(samples);
+    const int numWavelengths = getNumWavelengths(samples);
+
+    float inXyz[3][BLOCK_SIZE], outXyz[3][BLOCK_SIZE];
+    const float* blockInDirs[3] = { inXyz[0], inXyz[1], inXyz[2] };
+    const float* blockOutDirs[3] = { outXyz[0], outXyz[1], outXyz[2] };
+
+    float angles0[BLOCK_SIZE], angles1[BLOCK_SIZE], angles2[BLOCK_SIZE], angles3[BLOCK_SIZE];
+    for (int i = 0; i < numQueries; i += BLOCK_SIZE) {
+        int numBlockQueries = std::min(numQueries - i, static_cast<int>(BLOCK_SIZE));
+        toStructureOfArrays(inDirs + i, outDirs + i, numBlockQueries, inXyz, outXyz);
+
+        float* blockSpectra = spectra + i * numWavelengths;
+        if (isotropic) {
+            CoordinateSystemBatch<CoordSysT>::fromXyz(numBlockQueries, blockInDirs, blockOutDirs,
+                                                      angles0, angles2, angles3);
+            InterpolatorT::getSpectra(samples, numBlockQueries, angles0, angles2, angles3, blockSpectra);
+        }
+        else {
+            CoordinateSystemBatch<CoordSysT>::fromXyz(numBlockQueries, blockInDirs, blockOutDirs,
+                                                      angles0, angles1, angles2, angles3);
+            InterpolatorT::getSpectra(samples, numBlockQueries, angles0, angles1, angles2, angles3, blockSpectra);
+        }
+    }
+}
+
+template <typename CoordSysT, typename InterpolatorT>
+inline void Sampler::getValues(const SampleSet& samples,
+                               const Vec3*      inDirs,
+                               const Vec3*      outDirs,
+                               int              numQueries,
+                               int              wavelengthIndex,
+                               float*           values)
+{
+    const bool isotropic = isIsotropic(samples);
+
+    float inXyz[3][BLOCK_SIZE], outXyz[3][BLOCK_SIZE];
+    const float* blockInDirs[3] = { inXyz[0], inXyz[1], inXyz[2] };
+    const float* blockOutDirs[3] = { outXyz[0], outXyz[1], outXyz[2] };
+
+    float angles0[BLOCK_SIZE], angles1[BLOCK_SIZE], angles2[BLOCK_SIZE], angles3[BLOCK_SIZE];
+    for (int i = 0; i < numQueries; i += BLOCK_SIZE) {
+        int numBlockQueries = std::min(numQueries - i, static_cast<int>(BLOCK_SIZE));
+        toStructureOfArrays(inDirs + i, outDirs + i, numBlockQueries, inXyz, outXyz);
+
+        float* blockValues = values + i;
+        if (isotropic) {
+            CoordinateSystemBatch<CoordSysT>::fromXyz(numBlockQueries, blockInDirs, blockOutDirs,
+                                                      angles0, angles2, angles3);
+            for (int j = 0; j < numBlockQueries; ++j) {
+                blockValues[j] = InterpolatorT::getValue(samples, angles0[j], angles2[j], angles3[j],
+                                                         wavelengthIndex);
+            }
+        }
+        else {
+            CoordinateSystemBatch<CoordSysT>::fromXyz(numBlockQueries, blockInDirs, blockOutDirs,
+                                                      angles0, angles1, angles2, angles3);
+            for (int j = 0; j < numBlockQueries; ++j) {
+                blockValues[j] = InterpolatorT::getValue(samples, angles0[j], angles1[j], angles2[j], angles3[j],
+                                                         wavelengthIndex);
+            }
+        }
+    }
+}
+
+inline void Sampler::toStructureOfArrays(const Vec3*    inDirs,
+                                         const Vec3*    outDirs,
+                                         int            numDirs,
+                                         float          inXyz[3][BLOCK_SIZE],
+                                         float          outXyz[3][BLOCK_SIZE])
+{
+    for (int i = 0; i < numDirs; ++i) {
+        assert(inDirs[i].z() >= 0.0);
+
+        for (int j = 0; j < 3; ++j) {
+            inXyz[j][i] = inDirs[i][j];
+            outXyz[j][i] = outDirs[i][j];
+        }
+    }
+}
+
 template <typename InterpolatorT>
 inline void Sampler::getSpectrum(const Brdf&    brdf,
                                  const Vec3&    inDir,
@@ -141,6 +384,49 @@ inline void Sampler::getSpectrum(const Brdf&    brdf,
     }
 }
 
+template <typename InterpolatorT>
+inline void Sampler::getSpectrum(const Brdf&    brdf,
+                                 const Vec3&    inDir,
+                                 const Vec3&    outDir,
+                                 float*         spectrum)
+{
+    assert(inDir.z() >= 0.0);
+
+    const SampleSet* ss = getSampleSet(brdf);
+
+    float angle0, angle1, angle2, angle3;
+    if (isIsotropic(*ss)) {
+        fromXyz(brdf, inDir, outDir, &angle0, &angle2, &angle3);
+        InterpolatorT::getSpectrum(*ss, angle0, angle2, angle3, spectrum);
+    }
+    else {
+        fromXyz(brdf, inDir, outDir, &angle0, &angle1, &angle2, &angle3);
+        InterpolatorT::getSpectrum(*ss, angle0, angle1, angle2, angle3, spectrum);
+    }
+}
+
+template <typename InterpolatorT>
+inline void Sampler::getSpectrum(const Brdf&    brdf,
+                                 const Vec3&    inDir,
+                                 const Vec3&    outDir,
+                                 LookupContext* context,
+                                 Spectrum*      spectrum)
+{
+    assert(inDir.z() >= 0.0);
+
+    const SampleSet* ss = getSampleSet(brdf);
+
+    float angle0, angle1, angle2, angle3;
+    if (isIsotropic(*ss)) {
+        fromXyz(brdf, inDir, outDir, &angle0, &angle2, &angle3);
+        InterpolatorT::getSpectrum(*ss, angle0, angle2, angle3, context, spectrum);
+    }
+    else {
+        fromXyz(brdf, inDir, outDir, &angle0, &angle1, &angle2, &angle3);
+        InterpolatorT::getSpectrum(*ss, angle0, angle1, angle2, angle3, context, spectrum);
+    }
+}
+
 template <typename InterpolatorT>
 inline float Sampler::getValue(const Brdf&  brdf,
                                const Vec3&  inDir,
@@ -169,7 +455,7 @@ inline void Sampler::getSpectrum(const SampleSet2D& ss2,
 {
     float inTheta, inPhi;
     if (isIsotropic(ss2)) {
-        inTheta = std::acos(inDir[2]);
+        inTheta = fastAcos(inDir[2]);
         InterpolatorT::getSpectrum(ss2, inTheta, spectrum);
     }
     else {
@@ -54,10 +54,23 @@ public:
     /*! Copies and constructs a BRDF. */
     SpecularCoordinatesBrdf(const SpecularCoordinatesBrdf& brdf);
 
+    /*! Moves and constructs a BRDF. \a brdf can only be destroyed or assigned. */
+    SpecularCoordinatesBrdf(SpecularCoordinatesBrdf&& brdf);
+
+    /*! Moves a BRDF. */
+    SpecularCoordinatesBrdf& operator=(SpecularCoordinatesBrdf&& brdf);
+
     virtual ~SpecularCoordinatesBrdf();
 
     /*! Virtual copy constructor. */
     virtual SpecularCoordinatesBrdf* clone() const;
+
+    /*!
+     * Binds an incoming direction and returns the slice of the BRDF.
+     * Incoming angles and the sample points of them are found once, and the slice interpolates
+     * the remaining two angles at each outgoing direction.
+     */
+    virtual std::unique_ptr<BrdfSlice> bindIncoming(const Vec3& inDir) const;
     
     using BaseBrdf::getSpectrum;
 
@@ -70,20 +83,20 @@ public:
                          float specTheta, float specPhi) const;
 
     /*! Gets the spectrum of the BRDF at a set of angle indices. */
-    Spectrum& getSpectrum(int inThetaIndex, int inPhiIndex,
-                          int specThetaIndex, int specPhiIndex);
+    SpectrumMap getSpectrum(int inThetaIndex, int inPhiIndex,
+                            int specThetaIndex, int specPhiIndex);
 
     /*! Gets the spectrum of the BRDF at a set of angle indices. */
-    const Spectrum& getSpectrum(int inThetaIndex, int inPhiIndex,
-                                int specThetaIndex, int specPhiIndex) const;
+    ConstSpectrumMap getSpectrum(int inThetaIndex, int inPhiIndex,
+                                 int specThetaIndex, int specPhiIndex) const;
 
     /*! Gets the spectrum of the isotropic BRDF at a set of angle indices. */
-    Spectrum& getSpectrum(int inThetaIndex,
-                          int specThetaIndex, int specPhiIndex);
+    SpectrumMap getSpectrum(int inThetaIndex,
+                            int specThetaIndex, int specPhiIndex);
 
     /*! Gets the spectrum of the isotropic BRDF at a set of angle indices. */
-    const Spectrum& getSpectrum(int inThetaIndex,
-                                int specThetaIndex, int specPhiIndex) const;
+    ConstSpectrumMap getSpectrum(int inThetaIndex,
+                                 int specThetaIndex, int specPhiIndex) const;
 
     /*! Sets the spectrum of the BRDF at a set of angle indices. */
     void setSpectrum(int inThetaIndex, int inPhiIndex,
@@ -100,6 +113,11 @@ public:
     void setSpecTheta(int index, float angle); /*!< Sets the polar angle of a specular direction. */
     void setSpecPhi  (int index, float angle); /*!< Sets the azimuthal angle of a specular direction. */
 
+    void setInThetaAngles  (const Arrayf& angles); /*!< Sets the polar angles of an incoming direction. */
+    void setInPhiAngles    (const Arrayf& angles); /*!< Sets the azimuthal angles of an incoming direction. */
+    void setSpecThetaAngles(const Arrayf& angles); /*!< Sets the polar angles of a specular direction. */
+    void setSpecPhiAngles  (const Arrayf& angles); /*!< Sets the azimuthal angles of a specular direction. */
+
     int getNumInTheta()   const; /*!< Gets the number of polar angles of an incoming direction. */
     int getNumInPhi()     const; /*!< Gets the number of azimuthal angles of an incoming direction. */
     int getNumSpecTheta() const; /*!< Gets the number of polar angles of a specular direction. */
@@ -127,28 +145,28 @@ inline Spectrum SpecularCoordinatesBrdf::getSpectrum(float inTheta, float inPhi,
     return sp;
 }
 
-inline Spectrum& SpecularCoordinatesBrdf::getSpectrum(int inThetaIndex, int inPhiIndex,
-                                                      int specThetaIndex, int specPhiIndex)
+inline SpectrumMap SpecularCoordinatesBrdf::getSpectrum(int inThetaIndex, int inPhiIndex,
+                                                        int specThetaIndex, int specPhiIndex)
 {
     return samples_->getSpectrum(inThetaIndex, inPhiIndex, specThetaIndex, specPhiIndex);
 }
 
-inline const Spectrum& SpecularCoordinatesBrdf::getSpectrum(int inThetaIndex, int inPhiIndex,
-                                                            int specThetaIndex, int specPhiIndex) const
+inline ConstSpectrumMap SpecularCoordinatesBrdf::getSpectrum(int inThetaIndex, int inPhiIndex,
+                                                             int specThetaIndex, int specPhiIndex) const
 {
-    return samples_->getSpectrum(inThetaIndex, inPhiIndex, specThetaIndex, specPhiIndex);
+    return getSampleSet()->getSpectrum(inThetaIndex, inPhiIndex, specThetaIndex, specPhiIndex);
 }
 
-inline Spectrum& SpecularCoordinatesBrdf::getSpectrum(int inThetaIndex,
-                                                      int specThetaIndex, int specPhiIndex)
+inline SpectrumMap SpecularCoordinatesBrdf::getSpectrum(int inThetaIndex,
+                                                        int specThetaIndex, int specPhiIndex)
 {
     return samples_->getSpectrum(inThetaIndex, specThetaIndex, specPhiIndex);
 }
 
-inline const Spectrum&  SpecularCoordinatesBrdf::getSpectrum(int inThetaIndex,
+inline ConstSpectrumMap SpecularCoordinatesBrdf::getSpectrum(int inThetaIndex,
                                                              int specThetaIndex, int specPhiIndex) const
 {
-    return samples_->getSpectrum(inThetaIndex, specThetaIndex, specPhiIndex);
+    return getSampleSet()->getSpectrum(inThetaIndex, specThetaIndex, specPhiIndex);
 }
 
 inline void SpecularCoordinatesBrdf::setSpectrum(int inThetaIndex, int inPhiIndex,
@@ -168,6 +186,11 @@ inline void SpecularCoordinatesBrdf::setInPhi    (int index, float angle) { setA
 inline void SpecularCoordinatesBrdf::setSpecTheta(int index, float angle) { setAngle2(index, angle); }
 inline void SpecularCoordinatesBrdf::setSpecPhi  (int index, float angle) { setAngle3(index, angle); }
 
+inline void SpecularCoordinatesBrdf::setInThetaAngles  (const Arrayf& angles) { setAngles0(angles); }
+inline void SpecularCoordinatesBrdf::setInPhiAngles    (const Arrayf& angles) { setAngles1(angles); }
+inline void SpecularCoordinatesBrdf::setSpecThetaAngles(const Arrayf& angles) { setAngles2(angles); }
+inline void SpecularCoordinatesBrdf::setSpecPhiAngles  (const Arrayf& angles) { setAngles3(angles); }
+
 inline int SpecularCoordinatesBrdf::getNumInTheta()   const { return samples_->getNumAngles0(); }
 inline int SpecularCoordinatesBrdf::getNumInPhi()     const { return samples_->getNumAngles1(); }
 inline int SpecularCoordinatesBrdf::getNumSpecTheta() const { return samples_->getNumAngles2(); }
@@ -47,10 +47,23 @@ public:
     /*! Copies and constructs a BRDF. */
     SphericalCoordinatesBrdf(const SphericalCoordinatesBrdf& brdf);
 
+    /*! Moves and constructs a BRDF. \a brdf can only be destroyed or assigned. */
+    SphericalCoordinatesBrdf(SphericalCoordinatesBrdf&& brdf);
+
+    /*! Moves a BRDF. */
+    SphericalCoordinatesBrdf& operator=(SphericalCoordinatesBrdf&& brdf);
+
     virtual ~SphericalCoordinatesBrdf();
 
     /*! Virtual copy constructor. */
     virtual SphericalCoordinatesBrdf* clone() const;
+
+    /*!
+     * Binds an incoming direction and returns the slice of the BRDF.
+     * Incoming angles and the sample points of them are found once, and the slice interpolates
+     * the remaining two angles at each outgoing direction.
+     */
+    virtual std::unique_ptr<BrdfSlice> bindIncoming(const Vec3& inDir) const;
     
     using BaseBrdf::getSpectrum;
 
@@ -63,20 +76,20 @@ public:
                          float outTheta, float outPhi) const;
     
     /*! Gets the spectrum of the BRDF at a set of angle indices. */
-    Spectrum& getSpectrum(int inThetaIndex, int inPhiIndex,
-                          int outThetaIndex, int outPhiIndex);
+    SpectrumMap getSpectrum(int inThetaIndex, int inPhiIndex,
+                            int outThetaIndex, int outPhiIndex);
 
     /*! Gets the spectrum of the BRDF at a set of angle indices. */
-    const Spectrum& getSpectrum(int inThetaIndex, int inPhiIndex,
-                                int outThetaIndex, int outPhiIndex) const;
+    ConstSpectrumMap getSpectrum(int inThetaIndex, int inPhiIndex,
+                                 int outThetaIndex, int outPhiIndex) const;
 
     /*! Gets the spectrum of the isotropic BRDF at a set of angle indices. */
-    Spectrum& getSpectrum(int inThetaIndex,
-                          int outThetaIndex, int outPhiIndex);
+    SpectrumMap getSpectrum(int inThetaIndex,
+                            int outThetaIndex, int outPhiIndex);
 
     /*! Gets the spectrum of the isotropic BRDF at a set of angle indices. */
-    const Spectrum& getSpectrum(int inThetaIndex,
-                                int outThetaIndex, int outPhiIndex) const;
+    ConstSpectrumMap getSpectrum(int inThetaIndex,
+                                 int outThetaIndex, int outPhiIndex) const;
 
     /*! Sets the spectrum of the BRDF at a set of angle indices. */
     void setSpectrum(int inThetaIndex, int inPhiIndex,
@@ -93,6 +106,11 @@ public:
     void setOutTheta(int index, float angle); /*!< Sets the polar angle of an outgoing direction. */
     void setOutPhi  (int index, float angle); /*!< Sets the azimuthal angle of an outgoing direction. */
 
+    void setInThetaAngles (const Arrayf& angles); /*!< Sets the polar angles of an incoming direction. */
+    void setInPhiAngles   (const Arrayf& angles); /*!< Sets the azimuthal angles of an incoming direction. */
+    void setOutThetaAngles(const Arrayf& angles); /*!< Sets the polar angles of an outgoing direction. */
+    void setOutPhiAngles  (const Arrayf& angles); /*!< Sets the azimuthal angles of an outgoing direction. */
+
     int getNumInTheta()  const; /*!< Gets the number of polar angles of an incoming direction. */
     int getNumInPhi()    const; /*!< Gets the number of azimuthal angles of an incoming direction. */
     int getNumOutTheta() const; /*!< Gets the number of polar angles of an outgoing direction. */
@@ -119,28 +137,28 @@ inline Spectrum SphericalCoordinatesBrdf::getSpectrum(float inTheta, float inPhi
     return sp;
 }
 
-inline Spectrum& SphericalCoordinatesBrdf::getSpectrum(int inThetaIndex, int inPhiIndex,
-                                                       int outThetaIndex, int outPhiIndex)
+inline SpectrumMap SphericalCoordinatesBrdf::getSpectrum(int inThetaIndex, int inPhiIndex,
+                                                         int outThetaIndex, int outPhiIndex)
 {
     return samples_->getSpectrum(inThetaIndex, inPhiIndex, outThetaIndex, outPhiIndex);
 }
 
-inline const Spectrum& SphericalCoordinatesBrdf::getSpectrum(int inThetaIndex, int inPhiIndex,
-                                                             int outThetaIndex, int outPhiIndex) const
+inline ConstSpectrumMap SphericalCoordinatesBrdf::getSpectrum(int inThetaIndex, int inPhiIndex,
+                                                              int outThetaIndex, int outPhiIndex) const
 {
-    return samples_->getSpectrum(inThetaIndex, inPhiIndex, outThetaIndex, outPhiIndex);
+    return getSampleSet()->getSpectrum(inThetaIndex, inPhiIndex, outThetaIndex, outPhiIndex);
 }
 
-inline Spectrum& SphericalCoordinatesBrdf::getSpectrum(int inThetaIndex,
-                                                       int outThetaIndex, int outPhiIndex)
+inline SpectrumMap SphericalCoordinatesBrdf::getSpectrum(int inThetaIndex,
+                                                         int outThetaIndex, int outPhiIndex)
 {
     return samples_->getSpectrum(inThetaIndex, outThetaIndex, outPhiIndex);
 }
 
-inline const Spectrum& SphericalCoordinatesBrdf::getSpectrum(int inThetaIndex,
-                                                             int outThetaIndex, int outPhiIndex) const
+inline ConstSpectrumMap SphericalCoordinatesBrdf::getSpectrum(int inThetaIndex,
+                                                              int outThetaIndex, int outPhiIndex) const
 {
-    return samples_->getSpectrum(inThetaIndex, outThetaIndex, outPhiIndex);
+    return getSampleSet()->getSpectrum(inThetaIndex, outThetaIndex, outPhiIndex);
 }
 
 inline void SphericalCoordinatesBrdf::setSpectrum(int inThetaIndex, int inPhiIndex,
@@ -160,6 +178,11 @@ inline void SphericalCoordinatesBrdf::setInPhi   (int index, float angle) { setA
 inline void SphericalCoordinatesBrdf::setOutTheta(int index, float angle) { setAngle2(index, angle); }
 inline void SphericalCoordinatesBrdf::setOutPhi  (int index, float angle) { setAngle3(index, angle); }
 
+inline void SphericalCoordinatesBrdf::setInThetaAngles (const Arrayf& angles) { setAngles0(angles); }
+inline void SphericalCoordinatesBrdf::setInPhiAngles   (const Arrayf& angles) { setAngles1(angles); }
+inline void SphericalCoordinatesBrdf::setOutThetaAngles(const Arrayf& angles) { setAngles2(angles); }
+inline void SphericalCoordinatesBrdf::setOutPhiAngles  (const Arrayf& angles) { setAngles3(angles); }
+
 inline int SphericalCoordinatesBrdf::getNumInTheta()  const { return samples_->getNumAngles0(); }
 inline int SphericalCoordinatesBrdf::getNumInPhi()    const { return samples_->getNumAngles1(); }
 inline int SphericalCoordinatesBrdf::getNumOutTheta() const { return samples_->getNumAngles2(); }
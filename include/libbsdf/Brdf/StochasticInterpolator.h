@@ -0,0 +1,185 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_STOCHASTIC_INTERPOLATOR_H
+#define LIBBSDF_STOCHASTIC_INTERPOLATOR_H
+
+#include <libbsdf/Brdf/SampleSet.h>
+
+namespace lb {
+
+/*!
+ * \class   StochasticInterpolator
+ * \brief   The StochasticInterpolator class provides the functions for stochastic linear interpolation.
+ *
+ * One of the sample points surrounding a set of angles is chosen with the probability equal to
+ * its weight of multilinear interpolation. The spectrum of the sample point is an unbiased estimate
+ * of linear interpolation with a single fetch, which is suitable for Monte Carlo integration.
+ * Weights are clamped to [0, 1], so spectra are not extrapolated outside sample points.
+ *
+ * \a randomNumber is a uniform random number in [0, 1]. \a angle1 is not used for isotropic BRDFs.
+ */
+class StochasticInterpolator
+{
+public:
+    /*! Gets the spectrum of a sample point chosen around a set of angles. */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle1,
+                            float               angle2,
+                            float               angle3,
+                            float               randomNumber,
+                            Spectrum*           spectrum);
+
+    /*! Gets the spectrum of a sample point chosen around a set of angles. */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle2,
+                            float               angle3,
+                            float               randomNumber,
+                            Spectrum*           spectrum);
+
+    /*!
+     * Gets the spectrum of a sample point chosen around a set of angles.
+     * \a spectrum is an array of samples.getNumWavelengths() values.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle1,
+                            float               angle2,
+                            float               angle3,
+                            float               randomNumber,
+                            float*              spectrum);
+
+    /*!
+     * Gets the spectrum of a sample point chosen around a set of angles.
+     * \a spectrum is an array of samples.getNumWavelengths() values.
+     */
+    static void getSpectrum(const SampleSet&    samples,
+                            float               angle0,
+                            float               angle2,
+                            float               angle3,
+                            float               randomNumber,
+                            float*              spectrum);
+
+    /*! Gets the value of a sample point chosen around a set of angles at the index of wavelength. */
+    static float getValue(const SampleSet&  samples,
+                          float             angle0,
+                          float             angle1,
+                          float             angle2,
+                          float             angle3,
+                          float             randomNumber,
+                          int               wavelengthIndex);
+
+    /*! Gets the value of a sample point chosen around a set of angles at the index of wavelength. */
+    static float getValue(const SampleSet&  samples,
+                          float             angle0,
+                          float             angle2,
+                          float             angle3,
+                          float             randomNumber,
+                          int               wavelengthIndex);
+
+private:
+    /*!
+     * Chooses the index of a sample point around a set of angles.
+     * \a angle1 is not used for isotropic BRDFs.
+     */
+    static int findSample(const SampleSet&  samples,
+                          float             angle0,
+                          float             angle1,
+                          float             angle2,
+                          float             angle3,
+                          float             randomNumber);
+
+    /*!
+     * Chooses the lower or upper index of the interval containing \a angle with the probability
+     * equal to its weight. \a randomNumber is rescaled to [0, 1] for the next axis.
+     */
+    static int chooseIndex(const Arrayf&            angles,
+                           const AngleLookupTable&  lookupTable,
+                           bool                     equalIntervalAngles,
+                           float                    angle,
+                           float*                   randomNumber);
+};
+
+/*
+ * Implementation
+ */
+
+inline void StochasticInterpolator::getSpectrum(const SampleSet&    samples,
+                                                float               angle0,
+                                                float               angle1,
+                                                float               angle2,
+                                                float               angle3,
+                                                float               randomNumber,
+                                                Spectrum*           spectrum)
+{
+    spectrum->resize(samples.getNumWavelengths());
+    getSpectrum(samples, angle0, angle1, angle2, angle3, randomNumber, spectrum->data());
+}
+
+inline void StochasticInterpolator::getSpectrum(const SampleSet&    samples,
+                                                float               angle0,
+                                                float               angle2,
+                                                float               angle3,
+                                                float               randomNumber,
+                                                Spectrum*           spectrum)
+{
+    spectrum->resize(samples.getNumWavelengths());
+    getSpectrum(samples, angle0, 0.0f, angle2, angle3, randomNumber, spectrum->data());
+}
+
+inline void StochasticInterpolator::getSpectrum(const SampleSet&    samples,
+                                                float               angle0,
+                                                float               angle1,
+                                                float               angle2,
+                                                float               angle3,
+                                                float               randomNumber,
+                                                float*              spectrum)
+{
+    int index = findSample(samples, angle0, angle1, angle2, angle3, randomNumber);
+    for (int i = 0; i < samples.getNumWavelengths(); ++i) {
+        spectrum[i] = samples.getValue(index, i);
+    }
+}
+
+inline void StochasticInterpolator::getSpectrum(const SampleSet&    samples,
+                                                float               angle0,
+                                                float               angle2,
+                                                float               angle3,
+                                                float               randomNumber,
+                                                float*              spectrum)
+{
+    getSpectrum(samples, angle0, 0.0f, angle2, angle3, randomNumber, spectrum);
+}
+
+inline float StochasticInterpolator::getValue(const SampleSet&  samples,
+                                              float             angle0,
+                                              float             angle1,
+                                              float             angle2,
+                                              float             angle3,
+                                              float             randomNumber,
+                                              int               wavelengthIndex)
+{
+    int index = findSample(samples, angle0, angle1, angle2, angle3, randomNumber);
+    return samples.getValue(index, wavelengthIndex);
+}
+
+inline float StochasticInterpolator::getValue(const SampleSet&  samples,
+                                              float             angle0,
+                                              float             angle2,
+                                              float             angle3,
+                                              float             randomNumber,
+                                              int               wavelengthIndex)
+{
+    return getValue(samples, angle0, 0.0f, angle2, angle3, randomNumber, wavelengthIndex);
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_STOCHASTIC_INTERPOLATOR_H
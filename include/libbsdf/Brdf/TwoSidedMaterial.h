@@ -27,6 +27,12 @@ public:
      */
     TwoSidedMaterial(Material* frontMaterial, Material* backMaterial);
 
+    /*! Moves and constructs a two-sided material. \a material can only be destroyed or assigned. */
+    TwoSidedMaterial(TwoSidedMaterial&& material);
+
+    /*! Moves a two-sided material. */
+    TwoSidedMaterial& operator=(TwoSidedMaterial&& material);
+
     virtual ~TwoSidedMaterial();
 
     Material* getFrontMaterial(); /*!< Gets a front side material. */
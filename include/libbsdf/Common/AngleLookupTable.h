@@ -0,0 +1,95 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_ANGLE_LOOKUP_TABLE_H
+#define LIBBSDF_ANGLE_LOOKUP_TABLE_H
+
+#include <algorithm>
+#include <vector>
+
+#include <libbsdf/Common/Array.h>
+
+namespace lb {
+
+/*!
+ * \class   AngleLookupTable
+ * \brief   The AngleLookupTable class maps an angle to its position in a sorted array of angles in constant time.
+ *
+ * The range of angles is divided into buckets of equal width. Each bucket holds the index
+ * found by std::lower_bound() at its lower end, and a query scans only the angles in its bucket.
+ * The bucket width is the smallest interval of angles unless the number of buckets exceeds a limit.
+ * If angles are modified after build(), results are still correct but queries may be slower.
+ */
+class AngleLookupTable
+{
+public:
+    AngleLookupTable();
+
+    /*! Builds the table for an array of angles sorted in ascending order. */
+    void build(const Arrayf& angles);
+
+    /*! Clears the table. findLowerBound() uses a binary search until the table is built. */
+    void clear();
+
+    /*! Returns true if the table has been built. */
+    bool isBuilt() const;
+
+    /*!
+     * Finds the index of the first angle that is not less than \a angle.
+     * The result is equal to that of std::lower_bound().
+     */
+    int findLowerBound(const Arrayf& angles, float angle) const;
+
+private:
+    std::vector<int> indices_; /*!< The index found by std::lower_bound() for each bucket. */
+
+    float minAngle_; /*!< The angle at the lower end of the first bucket. */
+
+    float bucketScale_; /*!< The reciprocal of the width of buckets. */
+};
+
+/*
+ * Implementation
+ */
+
+inline bool AngleLookupTable::isBuilt() const { return !indices_.empty(); }
+
+inline int AngleLookupTable::findLowerBound(const Arrayf& angles, float angle) const
+{
+    const int numAngles = static_cast<int>(angles.size());
+
+    if (indices_.empty()) {
+        const float* anglePtr = std::lower_bound(angles.data(), angles.data() + numAngles, angle);
+        return static_cast<int>(anglePtr - angles.data());
+    }
+
+    const int backBucket = static_cast<int>(indices_.size()) - 1;
+    float position = (angle - minAngle_) * bucketScale_;
+
+    int bucket;
+    if (position > 0.0f) {
+        bucket = (position < backBucket) ? static_cast<int>(position) : backBucket;
+    }
+    else {
+        bucket = 0;
+    }
+
+    int index = std::min(indices_[bucket], numAngles);
+    while (index < numAngles && angles[index] < angle) {
+        ++index;
+    }
+    while (index > 0 && !(angles[index - 1] < angle)) {
+        --index;
+    }
+
+    return index;
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_ANGLE_LOOKUP_TABLE_H
@@ -26,6 +26,9 @@ namespace lb {
 typedef Eigen::ArrayXf Arrayf;
 typedef Eigen::ArrayXd Arrayd;
 
+typedef Eigen::Map<Arrayf>       ArrayfMap;
+typedef Eigen::Map<const Arrayf> ConstArrayfMap;
+
 /*! \brief Copies an array. */
 template <typename SrcT, typename DestT>
 void copyArray(const SrcT& srcArray, DestT* destArray);
@@ -37,6 +40,8 @@ void appendElement(ArrayT* arrayf, ScalarT value);
 /*!
  * \brief Interpolates arrays using centripetal Catmull-Rom spline at \a pos in [\a pos1,\a pos2].
  * \param array Interpolated array.
+ *
+ * The elements of \a T are single-precision values. Splines of elements are computed together.
  */
 template <typename T>
 void catmullRomSpline(float pos0, float pos1, float pos2, float pos3,
@@ -51,6 +56,13 @@ T toRadians(const T& degrees);
 template <typename T>
 bool isEqualInterval(const T& array);
 
+/*!
+ * \brief Returns true if an array of angles covers [0, 2 * PI].
+ *        The first and last angles are the same direction.
+ */
+template <typename T>
+bool isFullCircle(const T& angles);
+
 /*
  * Implementation
  */
@@ -68,16 +80,8 @@ template <typename ArrayT, typename ScalarT>
 inline void appendElement(ArrayT* arrayf, ScalarT value)
 {
     ArrayT& a = *arrayf;
-    std::vector<ScalarT> orig(a.data(), a.data() + a.size());
-    orig.push_back(value);
-    a.resize(a.size() + 1);
-
-#if (_MSC_VER >= 1600) // Visual Studio 2010
-    std::copy(orig.begin(), orig.end(),
-              stdext::checked_array_iterator<ArrayT::Scalar*>(a.data(), a.size()));
-#else
-    std::copy(orig.begin(), orig.end(), a.data());
-#endif
+    a.conservativeResize(a.size() + 1);
+    a[a.size() - 1] = value;
 }
 
 template <typename T>
@@ -91,14 +95,9 @@ void catmullRomSpline(float pos0, float pos1, float pos2, float pos3,
     
     array->resize(array0.size());
 
-    CentripetalCatmullRomSpline ccrs;
-    #pragma omp parallel for private(ccrs)
-    for (int i = 0; i < array->size(); ++i) {
-        ccrs.initialize(Vec2(pos0, array0[i]), Vec2(pos1, array1[i]), Vec2(pos2, array2[i]), Vec2(pos3, array3[i]));
-
-        typedef typename T::Scalar ScalarType;
-        (*array)[i] = static_cast<ScalarType>(ccrs.interpolateY(pos));
-    }
+    CentripetalCatmullRomSpline::interpolateMultipleY(pos0, pos1, pos2, pos3,
+                                                      array0.data(), array1.data(), array2.data(), array3.data(),
+                                                      static_cast<int>(array0.size()), pos, array->data());
 }
 
 template <typename T>
@@ -123,6 +122,14 @@ inline bool isEqualInterval(const T& array)
     return true;
 }
 
+template <typename T>
+inline bool isFullCircle(const T& angles)
+{
+    return (angles.size() > 2 &&
+            isEqual(angles[0], 0.0f) &&
+            isEqual(angles[angles.size() - 1], 2.0f * PI_F));
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_ARRAY_H
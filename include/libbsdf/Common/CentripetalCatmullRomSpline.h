@@ -37,9 +37,50 @@ public:
     /*! Evaluates the spline at \a t in [0,1]. */
     Vec2 evaluate(const Vec2::Scalar& t);
 
-    /*! Interpolates the Y-component of position using X-component. */
+    /*!
+     * Interpolates the Y-component of position using X-component.
+     * If the X-component is monotonic in [0,1], the parameter is found with Newton's method.
+     * Otherwise, bisection is used.
+     */
     Vec2::Scalar interpolateY(const Vec2::Scalar& x);
 
+    /*! Interpolates the Y-component of position using X-component. The parameter is always found by bisection. */
+    Vec2::Scalar interpolateYByBisection(const Vec2::Scalar& x);
+
+    /*!
+     * Interpolates the Y-components of \a numSplines splines at \a x.
+     * The splines share the X-components of control points and have their own Y-components.
+     * Splines are computed in blocks of lanes. The result of each spline is the same as interpolateY().
+     */
+    static void interpolateMultipleY(const Vec2::Scalar&    pos0X,
+                                     const Vec2::Scalar&    pos1X,
+                                     const Vec2::Scalar&    pos2X,
+                                     const Vec2::Scalar&    pos3X,
+                                     const float*           pos0Ys,
+                                     const float*           pos1Ys,
+                                     const float*           pos2Ys,
+                                     const float*           pos3Ys,
+                                     int                    numSplines,
+                                     const Vec2::Scalar&    x,
+                                     float*                 ys);
+
+    /*!
+     * Initializes parameters with the tangents at \a pos1 and \a pos2 computed in advance by computeTangents().
+     * The spline is the same as initialize() with four positions.
+     */
+    void initializeWithTangents(const Vec2& pos1,
+                                const Vec2& pos2,
+                                const Vec2& tan1,
+                                const Vec2& tan2);
+
+    /*! Computes the tangents at \a pos1 and \a pos2 of the segment between them. */
+    static void computeTangents(const Vec2& pos0,
+                                const Vec2& pos1,
+                                const Vec2& pos2,
+                                const Vec2& pos3,
+                                Vec2*       tan1,
+                                Vec2*       tan2);
+
 private:
     /*! Computes the coefficients of cubic Hermite spline using positions and tangents. */
     void computeCoefficients(const Vec2& pos1,
@@ -47,8 +88,19 @@ private:
                              const Vec2& tan1,
                              const Vec2& tan2);
 
+    /*! Returns true if the X-component of the cubic polynomial is monotonic in [0,1]. */
+    bool isMonotonicX() const;
+
+    /*! Finds the parameter of \a x by bisection. */
+    Vec2::Scalar bisectX(const Vec2::Scalar& x);
+
+    /*! Finds the parameter of \a x with Newton's method safeguarded by bisection. */
+    Vec2::Scalar solveX(const Vec2::Scalar& x) const;
+
     Vec2 pos0_, pos1_, pos2_, pos3_;
     Vec2 coeff0_, coeff1_, coeff2_, coeff3_;
+
+    bool monotonicX_; /*!< This attribute holds whether the X-component is monotonic in [0,1]. */
 };
 
 inline Vec2 CentripetalCatmullRomSpline::evaluate(const Vec2::Scalar& t)
@@ -58,6 +110,17 @@ inline Vec2 CentripetalCatmullRomSpline::evaluate(const Vec2::Scalar& t)
     return coeff0_ + coeff1_ * t + coeff2_ * t2 + coeff3_ * t3;
 }
 
+inline void CentripetalCatmullRomSpline::initializeWithTangents(const Vec2& pos1,
+                                                                const Vec2& pos2,
+                                                                const Vec2& tan1,
+                                                                const Vec2& tan2)
+{
+    pos1_ = pos1;
+    pos2_ = pos2;
+
+    computeCoefficients(pos1, pos2, tan1, tan2);
+}
+
 inline void CentripetalCatmullRomSpline::computeCoefficients(const Vec2& pos1,
                                                              const Vec2& pos2,
                                                              const Vec2& tan1,
@@ -67,6 +130,8 @@ inline void CentripetalCatmullRomSpline::computeCoefficients(const Vec2& pos1,
     coeff1_ = tan1;
     coeff2_ = -3.0 * pos1 + 3.0 * pos2 - 2.0 * tan1 - tan2;
     coeff3_ = 2.0 * pos1 - 2.0 * pos2 + tan1 + tan2;
+
+    monotonicX_ = isMonotonicX();
 }
 
 } // namespace lb
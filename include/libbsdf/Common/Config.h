@@ -0,0 +1,31 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+/*!
+ * \file    Config.h
+ * \brief   The Config.h header file includes the build options of libbsdf.
+ *
+ * This file has the default options of CMake. CMake generates Config.h with the selected options from
+ * Config.h.in into the "generated" directory of the build directory, which precedes this file in the
+ * include path of the library. The options change inline functions in headers, so applications of
+ * a library built with non-default options must also put the generated directory first in the include path.
+ */
+
+#ifndef LIBBSDF_CONFIG_H
+#define LIBBSDF_CONFIG_H
+
+/*! Defined if trigonometric functions in BRDF lookups use polynomial approximations. */
+/* #undef LIBBSDF_USE_FAST_MATH */
+
+/*! Defined if SIMD lanes use AVX2 instructions. */
+/* #undef LIBBSDF_USE_AVX2 */
+
+/*! Defined if SIMD lanes use SSE2 instructions. */
+#define LIBBSDF_USE_SSE2
+
+#endif // LIBBSDF_CONFIG_H
@@ -0,0 +1,180 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_COORDINATE_SYSTEM_BATCH_H
+#define LIBBSDF_COORDINATE_SYSTEM_BATCH_H
+
+#include <algorithm>
+
+#include <libbsdf/Common/Simd.h>
+
+namespace lb {
+
+/*!
+ * \struct  CoordinateSystemBatch
+ * \brief   The CoordinateSystemBatch struct provides the functions to convert arrays of directions and angles.
+ *
+ * Directions are structure-of-arrays buffers. \a inDirs and \a outDirs are arrays of three pointers
+ * to the x, y, and z components of directions. Each buffer has \a numDirs values.
+ * Directions are converted in SIMD lanes with the polynomial approximations in SimdMath.h.
+ *
+ * CoordSysT must provide toXyz() and fromXyz() for FloatLanes.
+ */
+template <typename CoordSysT>
+struct CoordinateSystemBatch
+{
+    /*! Converts from arrays of four angles to incoming and outgoing directions. */
+    static void toXyz(int           numDirs,
+                      const float*  angles0,
+                      const float*  angles1,
+                      const float*  angles2,
+                      const float*  angles3,
+                      float* const* inDirs,
+                      float* const* outDirs);
+
+    /*! Converts from incoming and outgoing directions to arrays of four angles. */
+    static void fromXyz(int                 numDirs,
+                        const float* const* inDirs,
+                        const float* const* outDirs,
+                        float*              angles0,
+                        float*              angles1,
+                        float*              angles2,
+                        float*              angles3);
+
+    /*! Converts from incoming and outgoing directions to arrays of three angles for isotropic data. */
+    static void fromXyz(int                 numDirs,
+                        const float* const* inDirs,
+                        const float* const* outDirs,
+                        float*              angles0,
+                        float*              angles2,
+                        float*              angles3);
+
+private:
+    /*! Loads SIMD_WIDTH values from \a offset. Lanes out of \a numValues are padded with the last value. */
+    static FloatLanes loadPaddedLanes(const float* values, int offset, int numValues);
+
+    /*! Stores lanes to the values from \a offset without exceeding \a numValues. */
+    static void storePartialLanes(float* values, int offset, int numValues, FloatLanes lanes);
+};
+
+/*
+ * Implementation
+ */
+
+template <typename CoordSysT>
+void CoordinateSystemBatch<CoordSysT>::toXyz(int            numDirs,
+                                             const float*   angles0,
+                                             const float*   angles1,
+                                             const float*   angles2,
+                                             const float*   angles3,
+                                             float* const*  inDirs,
+                                             float* const*  outDirs)
+{
+    FloatLanes inDir[3], outDir[3];
+    for (int i = 0; i < numDirs; i += SIMD_WIDTH) {
+        CoordSysT::toXyz(loadPaddedLanes(angles0, i, numDirs),
+                         loadPaddedLanes(angles1, i, numDirs),
+                         loadPaddedLanes(angles2, i, numDirs),
+                         loadPaddedLanes(angles3, i, numDirs),
+                         inDir, outDir);
+
+        for (int j = 0; j < 3; ++j) {
+            storePartialLanes(inDirs[j], i, numDirs, inDir[j]);
+            storePartialLanes(outDirs[j], i, numDirs, outDir[j]);
+        }
+    }
+}
+
+template <typename CoordSysT>
+void CoordinateSystemBatch<CoordSysT>::fromXyz(int                  numDirs,
+                                               const float* const*  inDirs,
+                                               const float* const*  outDirs,
+                                               float*               angles0,
+                                               float*               angles1,
+                                               float*               angles2,
+                                               float*               angles3)
+{
+    FloatLanes inDir[3], outDir[3];
+    FloatLanes angle0, angle1, angle2, angle3;
+    for (int i = 0; i < numDirs; i += SIMD_WIDTH) {
+        for (int j = 0; j < 3; ++j) {
+            inDir[j] = loadPaddedLanes(inDirs[j], i, numDirs);
+            outDir[j] = loadPaddedLanes(outDirs[j], i, numDirs);
+        }
+
+        CoordSysT::fromXyz(inDir, outDir, &angle0, &angle1, &angle2, &angle3);
+
+        storePartialLanes(angles0, i, numDirs, angle0);
+        storePartialLanes(angles1, i, numDirs, angle1);
+        storePartialLanes(angles2, i, numDirs, angle2);
+        storePartialLanes(angles3, i, numDirs, angle3);
+    }
+}
+
+template <typename CoordSysT>
+void CoordinateSystemBatch<CoordSysT>::fromXyz(int                  numDirs,
+                                               const float* const*  inDirs,
+                                               const float* const*  outDirs,
+                                               float*               angles0,
+                                               float*               angles2,
+                                               float*               angles3)
+{
+    FloatLanes inDir[3], outDir[3];
+    FloatLanes angle0, angle2, angle3;
+    for (int i = 0; i < numDirs; i += SIMD_WIDTH) {
+        for (int j = 0; j < 3; ++j) {
+            inDir[j] = loadPaddedLanes(inDirs[j], i, numDirs);
+            outDir[j] = loadPaddedLanes(outDirs[j], i, numDirs);
+        }
+
+        CoordSysT::fromXyz(inDir, outDir, &angle0, &angle2, &angle3);
+
+        storePartialLanes(angles0, i, numDirs, angle0);
+        storePartialLanes(angles2, i, numDirs, angle2);
+        storePartialLanes(angles3, i, numDirs, angle3);
+    }
+}
+
+template <typename CoordSysT>
+inline FloatLanes CoordinateSystemBatch<CoordSysT>::loadPaddedLanes(const float*    values,
+                                                                    int             offset,
+                                                                    int             numValues)
+{
+    if (offset + SIMD_WIDTH <= numValues) {
+        return loadLanes(values + offset);
+    }
+
+    float laneValues[SIMD_WIDTH];
+    for (int i = 0; i < SIMD_WIDTH; ++i) {
+        laneValues[i] = values[std::min(offset + i, numValues - 1)];
+    }
+
+    return loadLanes(laneValues);
+}
+
+template <typename CoordSysT>
+inline void CoordinateSystemBatch<CoordSysT>::storePartialLanes(float*      values,
+                                                                int         offset,
+                                                                int         numValues,
+                                                                FloatLanes  lanes)
+{
+    if (offset + SIMD_WIDTH <= numValues) {
+        storeLanes(values + offset, lanes);
+        return;
+    }
+
+    float laneValues[SIMD_WIDTH];
+    storeLanes(laneValues, lanes);
+    for (int i = 0; offset + i < numValues; ++i) {
+        values[offset + i] = laneValues[i];
+    }
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_COORDINATE_SYSTEM_BATCH_H
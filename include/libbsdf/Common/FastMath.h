@@ -0,0 +1,91 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+/*!
+ * \file    FastMath.h
+ * \brief   The FastMath.h header file includes the trigonometric functions used by BRDF lookups.
+ *
+ * If LIBBSDF_USE_FAST_MATH is defined, the functions are evaluated with the polynomials of SimdMath.h
+ * and the maximum absolute errors are 5e-7 radians for fastAcos() and fastAtan2(), and
+ * 1e-6 for fastSin() and fastCos() in [-100, 100]. Otherwise, the functions of the standard library are used.
+ *
+ * LIBBSDF_USE_FAST_MATH is defined in Config.h with the USE_FAST_MATH option of CMake.
+ */
+
+#ifndef LIBBSDF_FAST_MATH_H
+#define LIBBSDF_FAST_MATH_H
+
+#include <cmath>
+
+#include <libbsdf/Common/Config.h>
+
+#if defined(LIBBSDF_USE_FAST_MATH)
+#include <libbsdf/Common/SimdMath.h>
+#endif
+
+namespace lb {
+
+/*! \brief Computes the arc cosine of a value. */
+float fastAcos(float value);
+
+/*! \brief Computes the arc tangent of \a y / \a x in [-PI, PI]. */
+float fastAtan2(float y, float x);
+
+/*! \brief Computes the sine of a value. */
+float fastSin(float value);
+
+/*! \brief Computes the cosine of a value. */
+float fastCos(float value);
+
+/*
+ * Implementation
+ */
+
+#if defined(LIBBSDF_USE_FAST_MATH)
+
+// A value is computed in all lanes and the first lane is returned.
+inline float fastAcos(float value)
+{
+    float values[SIMD_WIDTH];
+    storeLanes(values, acosLanes(setLanes(value)));
+    return values[0];
+}
+
+inline float fastAtan2(float y, float x)
+{
+    float values[SIMD_WIDTH];
+    storeLanes(values, atan2Lanes(setLanes(y), setLanes(x)));
+    return values[0];
+}
+
+inline float fastSin(float value)
+{
+    float values[SIMD_WIDTH];
+    storeLanes(values, sinLanes(setLanes(value)));
+    return values[0];
+}
+
+inline float fastCos(float value)
+{
+    float values[SIMD_WIDTH];
+    storeLanes(values, cosLanes(setLanes(value)));
+    return values[0];
+}
+
+#else
+
+inline float fastAcos(float value) { return std::acos(value); }
+inline float fastAtan2(float y, float x) { return std::atan2(y, x); }
+inline float fastSin(float value) { return std::sin(value); }
+inline float fastCos(float value) { return std::cos(value); }
+
+#endif
+
+} // namespace lb
+
+#endif // LIBBSDF_FAST_MATH_H
@@ -31,6 +31,12 @@ const float EPSILON_F = std::numeric_limits<float>::epsilon();
 /*! \brief The data type of a spectrum. */
 typedef Eigen::ArrayXf Spectrum;
 
+/*! \brief The data type of a spectrum mapped onto contiguous storage. */
+typedef Eigen::Map<Spectrum, Eigen::Unaligned, Eigen::InnerStride<> > SpectrumMap;
+
+/*! \brief The data type of a read-only spectrum mapped onto contiguous storage. */
+typedef Eigen::Map<const Spectrum, Eigen::Unaligned, Eigen::InnerStride<> > ConstSpectrumMap;
+
 /*! \brief The data type of spectra. */
 typedef std::vector<Spectrum, Eigen::aligned_allocator<Spectrum> > SpectrumList;
 
@@ -43,6 +49,29 @@ enum ColorModel {
     SPECTRAL_MODEL
 };
 
+/*! \brief The memory layouts of spectra. */
+enum SpectrumLayout {
+    INTERLEAVED_LAYOUT = 0, /*!< The wavelengths of each sample point are adjacent. */
+    PLANAR_LAYOUT           /*!< The sample points of each wavelength are adjacent. */
+};
+
+/*! \brief The storage precisions of spectra. */
+enum SpectrumPrecision {
+    SINGLE_PRECISION = 0, /*!< 32-bit floating-point numbers. */
+    HALF_PRECISION,       /*!< IEEE 754 16-bit floating-point numbers. */
+    BFLOAT16_PRECISION    /*!< 16-bit floating-point numbers with the exponent range of single precision. */
+};
+
+/*!
+ * \brief The symmetries of spectra that reduce stored sample points.
+ *
+ * Rotational symmetry about the normal is represented by isotropic data with a single angle1.
+ */
+enum SymmetryType {
+    NO_SYMMETRY = 0, /*!< All sample points are stored. */
+    PLANE_SYMMETRY   /*!< Symmetric about the plane of angle3 = 0 and PI. Only angle3 in [0, PI] are stored. */
+};
+
 /*! \brief The data type of scatter. */
 enum DataType {
     UNKNOWN_DATA = 0,
@@ -61,6 +90,7 @@ enum FileType {
     INTEGRA_DDT_FILE,
     INTEGRA_SDR_FILE,
     INTEGRA_SDT_FILE,
+    LBB_FILE,
     LIGHTTOOLS_FILE,
     MERL_BINARY_FILE,
     ZEMAX_FILE
@@ -0,0 +1,159 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+/*!
+ * \file    Half.h
+ * \brief   The Half.h header file includes the conversion functions of 16-bit floating-point numbers.
+ *
+ * Half precision is IEEE 754 binary16. bfloat16 is the upper 16 bits of single precision.
+ * Values are rounded to the nearest even. F16C instructions are used if they are enabled.
+ */
+
+#ifndef LIBBSDF_HALF_H
+#define LIBBSDF_HALF_H
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+#include <libbsdf/Common/Global.h>
+
+namespace lb {
+
+/*! \brief Converts a single-precision value to half precision. */
+uint16_t floatToHalf(float value);
+
+/*! \brief Converts a half-precision value to single precision. */
+float halfToFloat(uint16_t value);
+
+/*! \brief Converts a single-precision value to bfloat16. */
+uint16_t floatToBfloat16(float value);
+
+/*! \brief Converts a bfloat16 value to single precision. */
+float bfloat16ToFloat(uint16_t value);
+
+/*! \brief Converts a 16-bit value stored with a precision to single precision. */
+float toFloat(uint16_t value, SpectrumPrecision precision);
+
+/*! \brief Converts a single-precision value to a 16-bit value with a precision. */
+uint16_t fromFloat(float value, SpectrumPrecision precision);
+
+/*
+ * Implementation
+ */
+
+inline uint16_t floatToHalf(float value)
+{
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+    return static_cast<uint16_t>(_cvtss_sh(value, 0));
+#else
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    uint32_t sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    uint16_t half;
+    if (bits >= 0x47800000u) {
+        // Infinity or NaN
+        half = (bits > 0x7f800000u) ? 0x7e00 : 0x7c00;
+    }
+    else if (bits < 0x38800000u) {
+        // Subnormal or zero. Adding 0.5 aligns the mantissa and rounds it.
+        const uint32_t denormMagicBits = 126u << 23;
+        float denormMagic, f;
+        std::memcpy(&denormMagic, &denormMagicBits, sizeof(denormMagic));
+        std::memcpy(&f, &bits, sizeof(f));
+        f += denormMagic;
+        std::memcpy(&bits, &f, sizeof(bits));
+        half = static_cast<uint16_t>(bits - denormMagicBits);
+    }
+    else {
+        uint32_t mantissaOdd = (bits >> 13) & 1;
+        bits += (static_cast<uint32_t>(15 - 127) << 23) + 0xfff;
+        bits += mantissaOdd;
+        half = static_cast<uint16_t>(bits >> 13);
+    }
+
+    return half | static_cast<uint16_t>(sign >> 16);
+#endif
+}
+
+inline float halfToFloat(uint16_t value)
+{
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+    return _cvtsh_ss(value);
+#else
+    const uint32_t shiftedExp = 0x7c00u << 13;
+
+    uint32_t bits = (value & 0x7fffu) << 13;
+    uint32_t exp = shiftedExp & bits;
+    bits += static_cast<uint32_t>(127 - 15) << 23;
+
+    if (exp == shiftedExp) {
+        // Infinity or NaN
+        bits += static_cast<uint32_t>(128 - 16) << 23;
+    }
+    else if (exp == 0) {
+        // Subnormal or zero
+        const uint32_t magicBits = 113u << 23;
+        float magic, f;
+        std::memcpy(&magic, &magicBits, sizeof(magic));
+        bits += 1u << 23;
+        std::memcpy(&f, &bits, sizeof(f));
+        f -= magic;
+        std::memcpy(&bits, &f, sizeof(bits));
+    }
+
+    bits |= static_cast<uint32_t>(value & 0x8000u) << 16;
+
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+#endif
+}
+
+inline uint16_t floatToBfloat16(float value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    if ((bits & 0x7fffffffu) > 0x7f800000u) {
+        // Keep NaN quiet.
+        return static_cast<uint16_t>((bits >> 16) | 0x40);
+    }
+
+    uint32_t rounding = 0x7fffu + ((bits >> 16) & 1);
+    return static_cast<uint16_t>((bits + rounding) >> 16);
+}
+
+inline float bfloat16ToFloat(uint16_t value)
+{
+    uint32_t bits = static_cast<uint32_t>(value) << 16;
+
+    float f;
+    std::memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+inline float toFloat(uint16_t value, SpectrumPrecision precision)
+{
+    return (precision == BFLOAT16_PRECISION) ? bfloat16ToFloat(value) : halfToFloat(value);
+}
+
+inline uint16_t fromFloat(float value, SpectrumPrecision precision)
+{
+    return (precision == BFLOAT16_PRECISION) ? floatToBfloat16(value) : floatToHalf(value);
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_HALF_H
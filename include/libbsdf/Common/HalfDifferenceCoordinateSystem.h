@@ -56,6 +56,30 @@ struct HalfDifferenceCoordinateSystem
                         float* halfTheta,
                         float* diffTheta, float* diffPhi);
 
+    /*!
+     * Converts from four angles in SIMD lanes to incoming and outgoing directions.
+     * \a inDir and \a outDir are arrays of x, y, and z lanes.
+     */
+    static void toXyz(FloatLanes halfTheta, FloatLanes halfPhi,
+                      FloatLanes diffTheta, FloatLanes diffPhi,
+                      FloatLanes* inDir, FloatLanes* outDir);
+
+    /*!
+     * Converts from incoming and outgoing directions in SIMD lanes to four angles.
+     * \a inDir and \a outDir are arrays of x, y, and z lanes.
+     */
+    static void fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                        FloatLanes* halfTheta, FloatLanes* halfPhi,
+                        FloatLanes* diffTheta, FloatLanes* diffPhi);
+
+    /*!
+     * Converts from incoming and outgoing directions in SIMD lanes to three angles for isotropic data.
+     * \a inDir and \a outDir are arrays of x, y, and z lanes.
+     */
+    static void fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                        FloatLanes* halfTheta,
+                        FloatLanes* diffTheta, FloatLanes* diffPhi);
+
     static const std::string ANGLE0_NAME; /*!< This attribute holds the name of halfTheta. */
     static const std::string ANGLE1_NAME; /*!< This attribute holds the name of halfPhi. */
     static const std::string ANGLE2_NAME; /*!< This attribute holds the name of diffTheta. */
@@ -70,6 +94,16 @@ struct HalfDifferenceCoordinateSystem
     static const float MAX_ANGLE1; /*!< This attribute holds the maximum value of halfPhi. */
     static const float MAX_ANGLE2; /*!< This attribute holds the maximum value of diffTheta. */
     static const float MAX_ANGLE3; /*!< This attribute holds the maximum value of diffPhi. */
+
+private:
+    /*!
+     * Converts from incoming and outgoing directions in SIMD lanes to four angles.
+     * The incoming direction is rotated by \a halfPhiSign times the azimuthal angle of the halfway vector.
+     */
+    static void fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                        float halfPhiSign,
+                        FloatLanes* halfTheta, FloatLanes* halfPhi,
+                        FloatLanes* diffTheta, FloatLanes* diffPhi);
 };
 
 inline void HalfDifferenceCoordinateSystem::toXyz(float halfTheta, float halfPhi,
@@ -93,8 +127,16 @@ inline void HalfDifferenceCoordinateSystem::fromXyz(const Vec3& inDir, const Vec
     Vec3 halfDir = (inDir + outDir).normalized();
     SphericalCoordinateSystem::fromXyz(halfDir, halfTheta, halfPhi);
 
-    Vec2f rotPhVec = Eigen::Rotation2D<Vec2f::Scalar>(*halfPhi) * Vec2f(inDir[0], inDir[1]);
-    Vec2f rotThVec = Eigen::Rotation2D<Vec2f::Scalar>(*halfTheta) * Vec2f(rotPhVec[0], inDir[2]);
+    float cosHalfPhi = fastCos(*halfPhi);
+    float sinHalfPhi = fastSin(*halfPhi);
+    float cosHalfTheta = fastCos(*halfTheta);
+    float sinHalfTheta = fastSin(*halfTheta);
+
+    // Rotations by halfPhi and halfTheta.
+    Vec2f rotPhVec(cosHalfPhi * inDir[0] - sinHalfPhi * inDir[1],
+                   sinHalfPhi * inDir[0] + cosHalfPhi * inDir[1]);
+    Vec2f rotThVec(cosHalfTheta * rotPhVec[0] - sinHalfTheta * inDir[2],
+                   sinHalfTheta * rotPhVec[0] + cosHalfTheta * inDir[2]);
     Vec3 diffDir(rotThVec[0], rotPhVec[1], rotThVec[1]);
     diffDir.normalize();
     SphericalCoordinateSystem::fromXyz(diffDir, diffTheta, diffPhi);
@@ -108,13 +150,120 @@ inline void HalfDifferenceCoordinateSystem::fromXyz(const Vec3& inDir, const Vec
     float halfPhi; // halfPhi is 0 for isotorpic data.
     SphericalCoordinateSystem::fromXyz(halfDir, halfTheta, &halfPhi);
 
-    Vec2f rotPhVec = Eigen::Rotation2D<Vec2f::Scalar>(-halfPhi) * Vec2f(inDir[0], inDir[1]);
-    Vec2f rotThVec = Eigen::Rotation2D<Vec2f::Scalar>(*halfTheta) * Vec2f(rotPhVec[0], inDir[2]);
+    float cosHalfPhi = fastCos(halfPhi);
+    float sinHalfPhi = fastSin(halfPhi);
+    float cosHalfTheta = fastCos(*halfTheta);
+    float sinHalfTheta = fastSin(*halfTheta);
+
+    // Rotations by -halfPhi and halfTheta.
+    Vec2f rotPhVec(cosHalfPhi * inDir[0] + sinHalfPhi * inDir[1],
+                   cosHalfPhi * inDir[1] - sinHalfPhi * inDir[0]);
+    Vec2f rotThVec(cosHalfTheta * rotPhVec[0] - sinHalfTheta * inDir[2],
+                   sinHalfTheta * rotPhVec[0] + cosHalfTheta * inDir[2]);
     Vec3 diffDir(rotThVec[0], rotPhVec[1], rotThVec[1]);
     diffDir.normalize();
     SphericalCoordinateSystem::fromXyz(diffDir, diffTheta, diffPhi);
 }
 
+inline void HalfDifferenceCoordinateSystem::toXyz(FloatLanes halfTheta, FloatLanes halfPhi,
+                                                  FloatLanes diffTheta, FloatLanes diffPhi,
+                                                  FloatLanes* inDir, FloatLanes* outDir)
+{
+    FloatLanes cosHalfTheta = cosLanes(halfTheta);
+    FloatLanes sinHalfTheta = sinLanes(halfTheta);
+    FloatLanes cosHalfPhi = cosLanes(halfPhi);
+    FloatLanes sinHalfPhi = sinLanes(halfPhi);
+
+    FloatLanes halfDir[3];
+    halfDir[0] = mulLanes(sinHalfTheta, cosHalfPhi);
+    halfDir[1] = mulLanes(sinHalfTheta, sinHalfPhi);
+    halfDir[2] = cosHalfTheta;
+
+    FloatLanes diffDir[3];
+    SphericalCoordinateSystem::toXyz(diffTheta, diffPhi, diffDir);
+
+    FloatLanes rotThX = addLanes(mulLanes(cosHalfTheta, diffDir[0]), mulLanes(sinHalfTheta, diffDir[2]));
+    FloatLanes rotThZ = subLanes(mulLanes(cosHalfTheta, diffDir[2]), mulLanes(sinHalfTheta, diffDir[0]));
+
+    inDir[0] = addLanes(mulLanes(cosHalfPhi, rotThX), mulLanes(sinHalfPhi, diffDir[1]));
+    inDir[1] = subLanes(mulLanes(cosHalfPhi, diffDir[1]), mulLanes(sinHalfPhi, rotThX));
+    inDir[2] = rotThZ;
+
+    // The outgoing direction is the reflection of the incoming direction about the halfway vector.
+    FloatLanes dotHalfIn = addLanes(addLanes(mulLanes(halfDir[0], inDir[0]),
+                                             mulLanes(halfDir[1], inDir[1])),
+                                    mulLanes(halfDir[2], inDir[2]));
+    FloatLanes scale = mulLanes(setLanes(2.0f), dotHalfIn);
+    for (int i = 0; i < 3; ++i) {
+        outDir[i] = subLanes(mulLanes(scale, halfDir[i]), inDir[i]);
+    }
+}
+
+inline void HalfDifferenceCoordinateSystem::fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                                                    FloatLanes* halfTheta, FloatLanes* halfPhi,
+                                                    FloatLanes* diffTheta, FloatLanes* diffPhi)
+{
+    fromXyz(inDir, outDir, 1.0f, halfTheta, halfPhi, diffTheta, diffPhi);
+}
+
+inline void HalfDifferenceCoordinateSystem::fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                                                    FloatLanes* halfTheta,
+                                                    FloatLanes* diffTheta, FloatLanes* diffPhi)
+{
+    FloatLanes halfPhi;
+    fromXyz(inDir, outDir, -1.0f, halfTheta, &halfPhi, diffTheta, diffPhi);
+}
+
+inline void HalfDifferenceCoordinateSystem::fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                                                    float halfPhiSign,
+                                                    FloatLanes* halfTheta, FloatLanes* halfPhi,
+                                                    FloatLanes* diffTheta, FloatLanes* diffPhi)
+{
+    FloatLanes halfDir[3];
+    for (int i = 0; i < 3; ++i) {
+        halfDir[i] = addLanes(inDir[i], outDir[i]);
+    }
+
+    FloatLanes invLength = divLanes(setLanes(1.0f),
+                                    sqrtLanes(addLanes(addLanes(mulLanes(halfDir[0], halfDir[0]),
+                                                                mulLanes(halfDir[1], halfDir[1])),
+                                                       mulLanes(halfDir[2], halfDir[2]))));
+    for (int i = 0; i < 3; ++i) {
+        halfDir[i] = mulLanes(halfDir[i], invLength);
+    }
+
+    SphericalCoordinateSystem::fromXyz(halfDir, halfTheta, halfPhi);
+
+    // The cosines and sines of the angles of the halfway vector are computed without trigonometry.
+    FloatLanes lengthXy = sqrtLanes(addLanes(mulLanes(halfDir[0], halfDir[0]), mulLanes(halfDir[1], halfDir[1])));
+    FloatLanes cosHalfTheta = halfDir[2];
+    FloatLanes sinHalfTheta = lengthXy;
+
+    FloatLanes zeroMask = lessLanes(lengthXy, setLanes(std::numeric_limits<float>::min()));
+    FloatLanes invLengthXy = divLanes(setLanes(1.0f), selectLanes(zeroMask, setLanes(1.0f), lengthXy));
+    FloatLanes cosHalfPhi = selectLanes(zeroMask, setLanes(1.0f), mulLanes(halfDir[0], invLengthXy));
+    FloatLanes sinHalfPhi = selectLanes(zeroMask, setLanes(0.0f),
+                                        mulLanes(setLanes(halfPhiSign), mulLanes(halfDir[1], invLengthXy)));
+
+    FloatLanes rotPhX = subLanes(mulLanes(cosHalfPhi, inDir[0]), mulLanes(sinHalfPhi, inDir[1]));
+    FloatLanes rotPhY = addLanes(mulLanes(sinHalfPhi, inDir[0]), mulLanes(cosHalfPhi, inDir[1]));
+
+    FloatLanes diffDir[3];
+    diffDir[0] = subLanes(mulLanes(cosHalfTheta, rotPhX), mulLanes(sinHalfTheta, inDir[2]));
+    diffDir[1] = rotPhY;
+    diffDir[2] = addLanes(mulLanes(sinHalfTheta, rotPhX), mulLanes(cosHalfTheta, inDir[2]));
+
+    FloatLanes invDiffLength = divLanes(setLanes(1.0f),
+                                        sqrtLanes(addLanes(addLanes(mulLanes(diffDir[0], diffDir[0]),
+                                                                    mulLanes(diffDir[1], diffDir[1])),
+                                                           mulLanes(diffDir[2], diffDir[2]))));
+    for (int i = 0; i < 3; ++i) {
+        diffDir[i] = mulLanes(diffDir[i], invDiffLength);
+    }
+
+    SphericalCoordinateSystem::fromXyz(diffDir, diffTheta, diffPhi);
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_HALF_DIFFERENCE_COORDINATE_SYSTEM_H
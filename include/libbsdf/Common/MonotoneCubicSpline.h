@@ -0,0 +1,190 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_MONOTONE_CUBIC_SPLINE_H
+#define LIBBSDF_MONOTONE_CUBIC_SPLINE_H
+
+#include <cmath>
+
+namespace lb {
+
+/*!
+ * \class   MonotoneCubicSpline
+ * \brief   The MonotoneCubicSpline class provides the monotone cubic interpolation of Fritsch and Carlson.
+ *
+ * Slopes of cubic Hermite splines are limited so that an interpolated value does not overshoot
+ * the values of the interval.
+ */
+class MonotoneCubicSpline
+{
+public:
+    /*!
+     * Computes the slopes at all positions. Positions must be sorted in ascending order.
+     * If \a periodic is true, the last position is the same point as the first position.
+     */
+    static void computeSlopes(const float*  positions,
+                              const float*  values,
+                              int           numValues,
+                              bool          periodic,
+                              float*        slopes);
+
+    /*!
+     * Interpolates a value between pos1 and pos2 with slopes computed from four points.
+     * pos0 and pos3 can be the same as pos1 and pos2 at the ends of positions.
+     */
+    static float interpolate(float pos0, float pos1, float pos2, float pos3,
+                             float value0, float value1, float value2, float value3,
+                             float pos);
+
+    /*! Interpolates a value between pos1 and pos2 with the slopes at pos1 and pos2. */
+    static float interpolate(float pos1, float pos2,
+                             float value1, float value2,
+                             float slope1, float slope2,
+                             float pos);
+
+private:
+    /*! Computes the slope at a position from the secants of adjacent intervals. */
+    static float computeSlope(float lowerSecant, float upperSecant);
+
+    /*! Limits the slopes of an interval so that the interpolated values are monotone. */
+    static void limitSlopes(float secant, float* slope1, float* slope2);
+};
+
+/*
+ * Implementation
+ */
+
+inline void MonotoneCubicSpline::computeSlopes(const float* positions,
+                                               const float* values,
+                                               int          numValues,
+                                               bool         periodic,
+                                               float*       slopes)
+{
+    if (numValues == 1) {
+        slopes[0] = 0.0f;
+        return;
+    }
+
+    const int backIndex = numValues - 1;
+
+    for (int i = 1; i < backIndex; ++i) {
+        float lowerSecant = (values[i] - values[i - 1]) / (positions[i] - positions[i - 1]);
+        float upperSecant = (values[i + 1] - values[i]) / (positions[i + 1] - positions[i]);
+        slopes[i] = computeSlope(lowerSecant, upperSecant);
+    }
+
+    float firstSecant = (values[1] - values[0]) / (positions[1] - positions[0]);
+    float lastSecant = (values[backIndex] - values[backIndex - 1]) /
+                       (positions[backIndex] - positions[backIndex - 1]);
+
+    periodic = (periodic && numValues > 2);
+    if (periodic) {
+        slopes[0] = computeSlope(lastSecant, firstSecant);
+        slopes[backIndex] = slopes[0];
+    }
+    else {
+        slopes[0] = firstSecant;
+        slopes[backIndex] = lastSecant;
+    }
+
+    // Limiting slopes only decreases them, so the slopes of the previous intervals stay monotone.
+    for (int i = 0; i < backIndex; ++i) {
+        float secant = (values[i + 1] - values[i]) / (positions[i + 1] - positions[i]);
+        limitSlopes(secant, &slopes[i], &slopes[i + 1]);
+    }
+
+    // The smaller slope at the same point satisfies both the first and last intervals.
+    if (periodic) {
+        if (std::abs(slopes[0]) < std::abs(slopes[backIndex])) {
+            slopes[backIndex] = slopes[0];
+        }
+        else {
+            slopes[0] = slopes[backIndex];
+        }
+    }
+}
+
+inline float MonotoneCubicSpline::interpolate(float pos0, float pos1, float pos2, float pos3,
+                                              float value0, float value1, float value2, float value3,
+                                              float pos)
+{
+    float interval = pos2 - pos1;
+    if (interval <= 0.0f) return value1;
+
+    float secant = (value2 - value1) / interval;
+
+    float slope1 = (pos0 < pos1) ? computeSlope((value1 - value0) / (pos1 - pos0), secant) : secant;
+    float slope2 = (pos3 > pos2) ? computeSlope(secant, (value3 - value2) / (pos3 - pos2)) : secant;
+    limitSlopes(secant, &slope1, &slope2);
+
+    return interpolate(pos1, pos2, value1, value2, slope1, slope2, pos);
+}
+
+inline float MonotoneCubicSpline::interpolate(float pos1, float pos2,
+                                              float value1, float value2,
+                                              float slope1, float slope2,
+                                              float pos)
+{
+    float interval = pos2 - pos1;
+    if (interval <= 0.0f) return value1;
+
+    float t = (pos - pos1) / interval;
+    t = (t < 0.0f) ? 0.0f : ((t > 1.0f) ? 1.0f : t);
+
+    float t2 = t * t;
+    float t3 = t2 * t;
+
+    float h00 = 2.0f * t3 - 3.0f * t2 + 1.0f;
+    float h10 = t3 - 2.0f * t2 + t;
+    float h01 = -2.0f * t3 + 3.0f * t2;
+    float h11 = t3 - t2;
+
+    return h00 * value1 + h10 * interval * slope1 + h01 * value2 + h11 * interval * slope2;
+}
+
+inline float MonotoneCubicSpline::computeSlope(float lowerSecant, float upperSecant)
+{
+    // A local extremum has a zero slope.
+    if (lowerSecant * upperSecant <= 0.0f) return 0.0f;
+
+    return (lowerSecant + upperSecant) / 2.0f;
+}
+
+inline void MonotoneCubicSpline::limitSlopes(float secant, float* slope1, float* slope2)
+{
+    if (secant == 0.0f) {
+        *slope1 = 0.0f;
+        *slope2 = 0.0f;
+        return;
+    }
+
+    float alpha = *slope1 / secant;
+    float beta  = *slope2 / secant;
+
+    // Slopes in the opposite direction of the secant are not monotone.
+    if (alpha < 0.0f) {
+        *slope1 = 0.0f;
+        alpha = 0.0f;
+    }
+
+    if (beta < 0.0f) {
+        *slope2 = 0.0f;
+        beta = 0.0f;
+    }
+
+    float radius2 = alpha * alpha + beta * beta;
+    if (radius2 > 9.0f) {
+        float tau = 3.0f / std::sqrt(radius2);
+        *slope1 = tau * alpha * secant;
+        *slope2 = tau * beta * secant;
+    }
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_MONOTONE_CUBIC_SPLINE_H
@@ -0,0 +1,197 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+/*!
+ * \file    Simd.h
+ * \brief   The Simd.h header file includes the functions of single-precision values in SIMD lanes.
+ *
+ * Lanes are 8 values with AVX2, 4 values with SSE2, and a single value otherwise.
+ * Each lane processes one of the independent queries of a batch.
+ *
+ * The instructions are selected with LIBBSDF_USE_AVX2 and LIBBSDF_USE_SSE2 in Config.h, so the library and
+ * applications have the same lanes. The compiler must enable the selected instructions.
+ */
+
+#ifndef LIBBSDF_SIMD_H
+#define LIBBSDF_SIMD_H
+
+#include <libbsdf/Common/Config.h>
+
+#if defined(LIBBSDF_USE_AVX2)
+#if !defined(__AVX2__)
+#error "libbsdf is configured with AVX2. Enable AVX2 instructions with -mavx2 or /arch:AVX2."
+#endif
+#include <immintrin.h>
+#elif defined(LIBBSDF_USE_SSE2)
+#if !(defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#error "libbsdf is configured with SSE2. Enable SSE2 instructions with -msse2 or /arch:SSE2."
+#endif
+#include <emmintrin.h>
+#else
+#include <cmath>
+#endif
+
+namespace lb {
+
+#if defined(LIBBSDF_USE_AVX2)
+typedef __m256 FloatLanes;
+const int SIMD_WIDTH = 8;
+#elif defined(LIBBSDF_USE_SSE2)
+typedef __m128 FloatLanes;
+const int SIMD_WIDTH = 4;
+#else
+typedef float FloatLanes;
+const int SIMD_WIDTH = 1;
+#endif
+
+/*! \brief Loads SIMD_WIDTH values. */
+FloatLanes loadLanes(const float* values);
+
+/*! \brief Stores lanes to SIMD_WIDTH values. */
+void storeLanes(float* values, FloatLanes lanes);
+
+/*! \brief Sets a value to all lanes. */
+FloatLanes setLanes(float value);
+
+FloatLanes addLanes(FloatLanes lhs, FloatLanes rhs);
+FloatLanes subLanes(FloatLanes lhs, FloatLanes rhs);
+FloatLanes mulLanes(FloatLanes lhs, FloatLanes rhs);
+FloatLanes divLanes(FloatLanes lhs, FloatLanes rhs);
+FloatLanes minLanes(FloatLanes lhs, FloatLanes rhs);
+FloatLanes maxLanes(FloatLanes lhs, FloatLanes rhs);
+
+FloatLanes sqrtLanes(FloatLanes lanes);
+FloatLanes absLanes(FloatLanes lanes);
+
+/*! \brief Rounds lanes to the nearest integers. Values must be less than 2^31 in magnitude. */
+FloatLanes roundLanes(FloatLanes lanes);
+
+/*! \brief Compares lanes and returns a mask that is only used by selectLanes(). */
+FloatLanes lessLanes(FloatLanes lhs, FloatLanes rhs);
+
+/*! \brief Selects \a trueLanes where \a mask is set, otherwise \a falseLanes. */
+FloatLanes selectLanes(FloatLanes mask, FloatLanes trueLanes, FloatLanes falseLanes);
+
+/*! \brief Converts lanes to integers rounded toward zero and stores them to SIMD_WIDTH values. */
+void truncateLanes(FloatLanes lanes, int* values);
+
+/*! \brief Loads values at SIMD_WIDTH offsets from \a base. */
+FloatLanes gatherLanes(const float* base, const int* offsets);
+
+/*
+ * Implementation
+ */
+
+#if defined(LIBBSDF_USE_AVX2)
+
+inline FloatLanes loadLanes(const float* values) { return _mm256_loadu_ps(values); }
+inline void storeLanes(float* values, FloatLanes lanes) { _mm256_storeu_ps(values, lanes); }
+inline FloatLanes setLanes(float value) { return _mm256_set1_ps(value); }
+
+inline FloatLanes addLanes(FloatLanes lhs, FloatLanes rhs) { return _mm256_add_ps(lhs, rhs); }
+inline FloatLanes subLanes(FloatLanes lhs, FloatLanes rhs) { return _mm256_sub_ps(lhs, rhs); }
+inline FloatLanes mulLanes(FloatLanes lhs, FloatLanes rhs) { return _mm256_mul_ps(lhs, rhs); }
+inline FloatLanes divLanes(FloatLanes lhs, FloatLanes rhs) { return _mm256_div_ps(lhs, rhs); }
+inline FloatLanes minLanes(FloatLanes lhs, FloatLanes rhs) { return _mm256_min_ps(lhs, rhs); }
+inline FloatLanes maxLanes(FloatLanes lhs, FloatLanes rhs) { return _mm256_max_ps(lhs, rhs); }
+
+inline FloatLanes sqrtLanes(FloatLanes lanes) { return _mm256_sqrt_ps(lanes); }
+inline FloatLanes absLanes(FloatLanes lanes) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), lanes); }
+
+inline FloatLanes roundLanes(FloatLanes lanes)
+{
+    return _mm256_round_ps(lanes, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+inline FloatLanes lessLanes(FloatLanes lhs, FloatLanes rhs) { return _mm256_cmp_ps(lhs, rhs, _CMP_LT_OQ); }
+
+inline FloatLanes selectLanes(FloatLanes mask, FloatLanes trueLanes, FloatLanes falseLanes)
+{
+    return _mm256_blendv_ps(falseLanes, trueLanes, mask);
+}
+
+inline void truncateLanes(FloatLanes lanes, int* values)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(values), _mm256_cvttps_epi32(lanes));
+}
+
+inline FloatLanes gatherLanes(const float* base, const int* offsets)
+{
+    __m256i indices = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets));
+    return _mm256_i32gather_ps(base, indices, 4);
+}
+
+#elif defined(LIBBSDF_USE_SSE2)
+
+inline FloatLanes loadLanes(const float* values) { return _mm_loadu_ps(values); }
+inline void storeLanes(float* values, FloatLanes lanes) { _mm_storeu_ps(values, lanes); }
+inline FloatLanes setLanes(float value) { return _mm_set1_ps(value); }
+
+inline FloatLanes addLanes(FloatLanes lhs, FloatLanes rhs) { return _mm_add_ps(lhs, rhs); }
+inline FloatLanes subLanes(FloatLanes lhs, FloatLanes rhs) { return _mm_sub_ps(lhs, rhs); }
+inline FloatLanes mulLanes(FloatLanes lhs, FloatLanes rhs) { return _mm_mul_ps(lhs, rhs); }
+inline FloatLanes divLanes(FloatLanes lhs, FloatLanes rhs) { return _mm_div_ps(lhs, rhs); }
+inline FloatLanes minLanes(FloatLanes lhs, FloatLanes rhs) { return _mm_min_ps(lhs, rhs); }
+inline FloatLanes maxLanes(FloatLanes lhs, FloatLanes rhs) { return _mm_max_ps(lhs, rhs); }
+
+inline FloatLanes sqrtLanes(FloatLanes lanes) { return _mm_sqrt_ps(lanes); }
+inline FloatLanes absLanes(FloatLanes lanes) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), lanes); }
+
+// The default rounding mode of MXCSR rounds to the nearest integer.
+inline FloatLanes roundLanes(FloatLanes lanes) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(lanes)); }
+
+inline FloatLanes lessLanes(FloatLanes lhs, FloatLanes rhs) { return _mm_cmplt_ps(lhs, rhs); }
+
+inline FloatLanes selectLanes(FloatLanes mask, FloatLanes trueLanes, FloatLanes falseLanes)
+{
+    return _mm_or_ps(_mm_and_ps(mask, trueLanes), _mm_andnot_ps(mask, falseLanes));
+}
+
+inline void truncateLanes(FloatLanes lanes, int* values)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values), _mm_cvttps_epi32(lanes));
+}
+
+inline FloatLanes gatherLanes(const float* base, const int* offsets)
+{
+    return _mm_set_ps(base[offsets[3]], base[offsets[2]], base[offsets[1]], base[offsets[0]]);
+}
+
+#else
+
+inline FloatLanes loadLanes(const float* values) { return *values; }
+inline void storeLanes(float* values, FloatLanes lanes) { *values = lanes; }
+inline FloatLanes setLanes(float value) { return value; }
+
+inline FloatLanes addLanes(FloatLanes lhs, FloatLanes rhs) { return lhs + rhs; }
+inline FloatLanes subLanes(FloatLanes lhs, FloatLanes rhs) { return lhs - rhs; }
+inline FloatLanes mulLanes(FloatLanes lhs, FloatLanes rhs) { return lhs * rhs; }
+inline FloatLanes divLanes(FloatLanes lhs, FloatLanes rhs) { return lhs / rhs; }
+inline FloatLanes minLanes(FloatLanes lhs, FloatLanes rhs) { return (rhs < lhs) ? rhs : lhs; }
+inline FloatLanes maxLanes(FloatLanes lhs, FloatLanes rhs) { return (lhs < rhs) ? rhs : lhs; }
+
+inline FloatLanes sqrtLanes(FloatLanes lanes) { return std::sqrt(lanes); }
+inline FloatLanes absLanes(FloatLanes lanes) { return std::abs(lanes); }
+inline FloatLanes roundLanes(FloatLanes lanes) { return std::floor(lanes + 0.5f); }
+
+inline FloatLanes lessLanes(FloatLanes lhs, FloatLanes rhs) { return (lhs < rhs) ? 1.0f : 0.0f; }
+
+inline FloatLanes selectLanes(FloatLanes mask, FloatLanes trueLanes, FloatLanes falseLanes)
+{
+    return (mask != 0.0f) ? trueLanes : falseLanes;
+}
+
+inline void truncateLanes(FloatLanes lanes, int* values) { *values = static_cast<int>(lanes); }
+
+inline FloatLanes gatherLanes(const float* base, const int* offsets) { return base[*offsets]; }
+
+#endif
+
+} // namespace lb
+
+#endif // LIBBSDF_SIMD_H
@@ -0,0 +1,141 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+/*!
+ * \file    SimdMath.h
+ * \brief   The SimdMath.h header file includes the trigonometric functions of values in SIMD lanes.
+ *
+ * The functions are evaluated with polynomials and the maximum absolute errors are as follows.
+ *   - acosLanes(): 5e-7 radians in [-1, 1]
+ *   - atan2Lanes(): 5e-7 radians
+ *   - sinLanes() and cosLanes(): 1e-6 in [-100, 100]
+ *
+ * Errors include the rounding of single-precision arithmetic.
+ */
+
+#ifndef LIBBSDF_SIMD_MATH_H
+#define LIBBSDF_SIMD_MATH_H
+
+#include <libbsdf/Common/Global.h>
+#include <libbsdf/Common/Simd.h>
+
+namespace lb {
+
+/*! \brief Computes the arc cosine of lanes. Values are clamped to [-1, 1]. */
+FloatLanes acosLanes(FloatLanes lanes);
+
+/*! \brief Computes the arc tangent of \a y / \a x in [-PI, PI] using the signs of lanes. */
+FloatLanes atan2Lanes(FloatLanes y, FloatLanes x);
+
+/*! \brief Computes the sine of lanes. */
+FloatLanes sinLanes(FloatLanes lanes);
+
+/*! \brief Computes the cosine of lanes. */
+FloatLanes cosLanes(FloatLanes lanes);
+
+/*
+ * Implementation
+ */
+
+inline FloatLanes acosLanes(FloatLanes lanes)
+{
+    // See Abramowitz, M. and Stegun, I. A. 1964. Handbook of Mathematical Functions, 4.4.46.
+    FloatLanes x = minLanes(absLanes(lanes), setLanes(1.0f));
+
+    FloatLanes poly = setLanes(-0.0012624911f);
+    poly = addLanes(mulLanes(poly, x), setLanes( 0.0066700901f));
+    poly = addLanes(mulLanes(poly, x), setLanes(-0.0170881256f));
+    poly = addLanes(mulLanes(poly, x), setLanes( 0.0308918810f));
+    poly = addLanes(mulLanes(poly, x), setLanes(-0.0501743046f));
+    poly = addLanes(mulLanes(poly, x), setLanes( 0.0889789874f));
+    poly = addLanes(mulLanes(poly, x), setLanes(-0.2145988016f));
+    poly = addLanes(mulLanes(poly, x), setLanes( 1.5707963050f));
+
+    FloatLanes angle = mulLanes(sqrtLanes(subLanes(setLanes(1.0f), x)), poly);
+    return selectLanes(lessLanes(lanes, setLanes(0.0f)), subLanes(setLanes(PI_F), angle), angle);
+}
+
+inline FloatLanes atan2Lanes(FloatLanes y, FloatLanes x)
+{
+    FloatLanes absX = absLanes(x);
+    FloatLanes absY = absLanes(y);
+
+    // The ratio is reduced to [0, 1].
+    FloatLanes minXy = minLanes(absX, absY);
+    FloatLanes maxXy = maxLanes(absX, absY);
+    FloatLanes zeroMask = lessLanes(maxXy, setLanes(std::numeric_limits<float>::min()));
+    FloatLanes t = divLanes(minXy, selectLanes(zeroMask, setLanes(1.0f), maxXy));
+    FloatLanes t2 = mulLanes(t, t);
+
+    // See Abramowitz, M. and Stegun, I. A. 1964. Handbook of Mathematical Functions, 4.4.49.
+    FloatLanes poly = setLanes(0.0028662257f);
+    poly = addLanes(mulLanes(poly, t2), setLanes(-0.0161657367f));
+    poly = addLanes(mulLanes(poly, t2), setLanes( 0.0429096138f));
+    poly = addLanes(mulLanes(poly, t2), setLanes(-0.0752896400f));
+    poly = addLanes(mulLanes(poly, t2), setLanes( 0.1065626393f));
+    poly = addLanes(mulLanes(poly, t2), setLanes(-0.1420889944f));
+    poly = addLanes(mulLanes(poly, t2), setLanes( 0.1999355085f));
+    poly = addLanes(mulLanes(poly, t2), setLanes(-0.3333314528f));
+    poly = addLanes(mulLanes(poly, t2), setLanes( 1.0f));
+
+    FloatLanes angle = mulLanes(t, poly);
+    angle = selectLanes(lessLanes(absX, absY), subLanes(setLanes(PI_2_F), angle), angle);
+    angle = selectLanes(lessLanes(x, setLanes(0.0f)), subLanes(setLanes(PI_F), angle), angle);
+    return selectLanes(lessLanes(y, setLanes(0.0f)), subLanes(setLanes(0.0f), angle), angle);
+}
+
+inline FloatLanes sinLanes(FloatLanes lanes)
+{
+    // The angle is reduced to [-PI, PI] with 2 * PI split into two values.
+    FloatLanes k = roundLanes(mulLanes(lanes, setLanes(1.0f / (2.0f * PI_F))));
+    FloatLanes x = subLanes(lanes, mulLanes(k, setLanes(6.28125f)));
+    x = subLanes(x, mulLanes(k, setLanes(0.0019353071795864769f)));
+
+    // The angle is reflected to [-PI / 2, PI / 2].
+    FloatLanes halfPi = setLanes(PI_2_F);
+    FloatLanes negHalfPi = setLanes(-PI_2_F);
+    x = selectLanes(lessLanes(halfPi, x), subLanes(setLanes(PI_F), x), x);
+    x = selectLanes(lessLanes(x, negHalfPi), subLanes(setLanes(-PI_F), x), x);
+
+    FloatLanes x2 = mulLanes(x, x);
+    FloatLanes poly = setLanes(-1.0f / 39916800.0f);
+    poly = addLanes(mulLanes(poly, x2), setLanes( 1.0f / 362880.0f));
+    poly = addLanes(mulLanes(poly, x2), setLanes(-1.0f / 5040.0f));
+    poly = addLanes(mulLanes(poly, x2), setLanes( 1.0f / 120.0f));
+    poly = addLanes(mulLanes(poly, x2), setLanes(-1.0f / 6.0f));
+    poly = addLanes(mulLanes(poly, x2), setLanes( 1.0f));
+
+    return mulLanes(x, poly);
+}
+
+inline FloatLanes cosLanes(FloatLanes lanes)
+{
+    // The angle is reduced to [0, PI] since cosine is even.
+    FloatLanes k = roundLanes(mulLanes(lanes, setLanes(1.0f / (2.0f * PI_F))));
+    FloatLanes x = subLanes(lanes, mulLanes(k, setLanes(6.28125f)));
+    x = absLanes(subLanes(x, mulLanes(k, setLanes(0.0019353071795864769f))));
+
+    // The angle is reflected to [0, PI / 2] and the sign is flipped.
+    FloatLanes flipMask = lessLanes(setLanes(PI_2_F), x);
+    x = selectLanes(flipMask, subLanes(setLanes(PI_F), x), x);
+
+    FloatLanes x2 = mulLanes(x, x);
+    FloatLanes poly = setLanes(1.0f / 479001600.0f);
+    poly = addLanes(mulLanes(poly, x2), setLanes(-1.0f / 3628800.0f));
+    poly = addLanes(mulLanes(poly, x2), setLanes( 1.0f / 40320.0f));
+    poly = addLanes(mulLanes(poly, x2), setLanes(-1.0f / 720.0f));
+    poly = addLanes(mulLanes(poly, x2), setLanes( 1.0f / 24.0f));
+    poly = addLanes(mulLanes(poly, x2), setLanes(-1.0f / 2.0f));
+    poly = addLanes(mulLanes(poly, x2), setLanes( 1.0f));
+
+    return selectLanes(flipMask, subLanes(setLanes(0.0f), poly), poly);
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_SIMD_MATH_H
@@ -54,6 +54,40 @@ struct SpecularCoordinateSystem
                         float* inTheta,
                         float* specTheta, float* specPhi);
 
+    /*!
+     * Converts from four angles in SIMD lanes to incoming and outgoing directions.
+     * \a inDir and \a outDir are arrays of x, y, and z lanes.
+     */
+    static void toXyz(FloatLanes inTheta, FloatLanes inPhi,
+                      FloatLanes specTheta, FloatLanes specPhi,
+                      FloatLanes* inDir, FloatLanes* outDir);
+
+    /*!
+     * Converts from incoming and outgoing directions in SIMD lanes to four angles.
+     * \a inDir and \a outDir are arrays of x, y, and z lanes.
+     */
+    static void fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                        FloatLanes* inTheta, FloatLanes* inPhi,
+                        FloatLanes* specTheta, FloatLanes* specPhi);
+
+    /*!
+     * Converts from incoming and outgoing directions in SIMD lanes to three angles for isotropic data.
+     * \a inDir and \a outDir are arrays of x, y, and z lanes.
+     */
+    static void fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                        FloatLanes* inTheta,
+                        FloatLanes* specTheta, FloatLanes* specPhi);
+
+    /*!
+     * Converts an outgoing direction from a Cartesian coordinate system to a specular.
+     * Rotations are given by the cosines and sines of incoming polar and azimuthal angles,
+     * which can be reused for outgoing directions with a fixed incoming direction.
+     */
+    static void fromOutDirXyz(const Vec3& outDir,
+                              float cosInTheta, float sinInTheta,
+                              float cosInPhi, float sinInPhi,
+                              float* specTheta, float* specPhi);
+
     static const std::string ANGLE0_NAME; /*!< This attribute holds the name of inTheta. */
     static const std::string ANGLE1_NAME; /*!< This attribute holds the name of inPhi. */
     static const std::string ANGLE2_NAME; /*!< This attribute holds the name of specTheta. */
@@ -77,6 +111,15 @@ private:
     /*! Converts an outgoing direction from a Cartesian coordinate system to a specular. */
     static void fromOutDirXyz(const Vec3& outDir, float inTheta, float inPhi,
                               float* specTheta, float* specPhi);
+
+    /*!
+     * Converts an outgoing direction in SIMD lanes from a Cartesian coordinate system to a specular.
+     * Rotations are given by the cosines and sines of incoming polar and azimuthal angles.
+     */
+    static void fromOutDirXyz(const FloatLanes* outDir,
+                              FloatLanes cosInTheta, FloatLanes sinInTheta,
+                              FloatLanes cosInPhi, FloatLanes sinInPhi,
+                              FloatLanes* specTheta, FloatLanes* specPhi);
 };
 
 inline void SpecularCoordinateSystem::toXyz(float inTheta, float inPhi,
@@ -117,13 +160,94 @@ inline Vec3 SpecularCoordinateSystem::toOutDirXyz(float inTheta, float inPhi,
 inline void SpecularCoordinateSystem::fromOutDirXyz(const Vec3& outDir, float inTheta, float inPhi,
                                                     float* specTheta, float* specPhi)
 {
-    Vec2f rotPhVec = Eigen::Rotation2D<Vec2f::Scalar>(-inPhi) * Vec2f(outDir[0], outDir[1]);
-    Vec2f rotThVec = Eigen::Rotation2D<Vec2f::Scalar>(-inTheta) * Vec2f(rotPhVec[0], outDir[2]);
+    fromOutDirXyz(outDir,
+                  fastCos(inTheta), fastSin(inTheta),
+                  fastCos(inPhi), fastSin(inPhi),
+                  specTheta, specPhi);
+}
+
+inline void SpecularCoordinateSystem::fromOutDirXyz(const Vec3& outDir,
+                                                    float cosInTheta, float sinInTheta,
+                                                    float cosInPhi, float sinInPhi,
+                                                    float* specTheta, float* specPhi)
+{
+    // Rotations by -inPhi and -inTheta.
+    Vec2f rotPhVec(cosInPhi * outDir[0] + sinInPhi * outDir[1],
+                   cosInPhi * outDir[1] - sinInPhi * outDir[0]);
+    Vec2f rotThVec(cosInTheta * rotPhVec[0] + sinInTheta * outDir[2],
+                   cosInTheta * outDir[2] - sinInTheta * rotPhVec[0]);
     rotThVec[1] = clamp(rotThVec[1], -1.0f, 1.0f);
     Vec3 rotDir(rotThVec[0], rotPhVec[1], rotThVec[1]);
     SphericalCoordinateSystem::fromXyz(rotDir, specTheta, specPhi);
 }
 
+inline void SpecularCoordinateSystem::toXyz(FloatLanes inTheta, FloatLanes inPhi,
+                                            FloatLanes specTheta, FloatLanes specPhi,
+                                            FloatLanes* inDir, FloatLanes* outDir)
+{
+    FloatLanes cosInTheta = cosLanes(inTheta);
+    FloatLanes sinInTheta = sinLanes(inTheta);
+    FloatLanes cosInPhi = cosLanes(inPhi);
+    FloatLanes sinInPhi = sinLanes(inPhi);
+
+    inDir[0] = mulLanes(sinInTheta, cosInPhi);
+    inDir[1] = mulLanes(sinInTheta, sinInPhi);
+    inDir[2] = cosInTheta;
+
+    FloatLanes specDir[3];
+    SphericalCoordinateSystem::toXyz(specTheta, specPhi, specDir);
+
+    FloatLanes rotThX = subLanes(mulLanes(cosInTheta, specDir[0]), mulLanes(sinInTheta, specDir[2]));
+    FloatLanes rotThZ = addLanes(mulLanes(sinInTheta, specDir[0]), mulLanes(cosInTheta, specDir[2]));
+
+    outDir[0] = subLanes(mulLanes(cosInPhi, rotThX), mulLanes(sinInPhi, specDir[1]));
+    outDir[1] = addLanes(mulLanes(sinInPhi, rotThX), mulLanes(cosInPhi, specDir[1]));
+    outDir[2] = rotThZ;
+}
+
+inline void SpecularCoordinateSystem::fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                                              FloatLanes* inTheta, FloatLanes* inPhi,
+                                              FloatLanes* specTheta, FloatLanes* specPhi)
+{
+    SphericalCoordinateSystem::fromXyz(inDir, inTheta, inPhi);
+
+    // The cosines and sines of incoming angles are computed from the direction without trigonometry.
+    FloatLanes lengthXy = sqrtLanes(addLanes(mulLanes(inDir[0], inDir[0]), mulLanes(inDir[1], inDir[1])));
+    FloatLanes cosInTheta = inDir[2];
+    FloatLanes sinInTheta = lengthXy;
+
+    FloatLanes zeroMask = lessLanes(lengthXy, setLanes(std::numeric_limits<float>::min()));
+    FloatLanes invLengthXy = divLanes(setLanes(1.0f), selectLanes(zeroMask, setLanes(1.0f), lengthXy));
+    FloatLanes cosInPhi = selectLanes(zeroMask, setLanes(1.0f), mulLanes(inDir[0], invLengthXy));
+    FloatLanes sinInPhi = selectLanes(zeroMask, setLanes(0.0f), mulLanes(inDir[1], invLengthXy));
+
+    fromOutDirXyz(outDir, cosInTheta, sinInTheta, cosInPhi, sinInPhi, specTheta, specPhi);
+}
+
+inline void SpecularCoordinateSystem::fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                                              FloatLanes* inTheta,
+                                              FloatLanes* specTheta, FloatLanes* specPhi)
+{
+    FloatLanes inPhi;
+    fromXyz(inDir, outDir, inTheta, &inPhi, specTheta, specPhi);
+}
+
+inline void SpecularCoordinateSystem::fromOutDirXyz(const FloatLanes* outDir,
+                                                    FloatLanes cosInTheta, FloatLanes sinInTheta,
+                                                    FloatLanes cosInPhi, FloatLanes sinInPhi,
+                                                    FloatLanes* specTheta, FloatLanes* specPhi)
+{
+    FloatLanes rotPhX = addLanes(mulLanes(cosInPhi, outDir[0]), mulLanes(sinInPhi, outDir[1]));
+    FloatLanes rotPhY = subLanes(mulLanes(cosInPhi, outDir[1]), mulLanes(sinInPhi, outDir[0]));
+
+    FloatLanes rotDir[3];
+    rotDir[0] = addLanes(mulLanes(cosInTheta, rotPhX), mulLanes(sinInTheta, outDir[2]));
+    rotDir[1] = rotPhY;
+    rotDir[2] = subLanes(mulLanes(cosInTheta, outDir[2]), mulLanes(sinInTheta, rotPhX));
+
+    SphericalCoordinateSystem::fromXyz(rotDir, specTheta, specPhi);
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_SPECULAR_COORDINATE_SYSTEM_H
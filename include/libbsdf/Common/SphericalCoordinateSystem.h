@@ -9,7 +9,9 @@
 #ifndef LIBBSDF_SPHERICAL_COORDINATE_SYSTEM_H
 #define LIBBSDF_SPHERICAL_COORDINATE_SYSTEM_H
 
+#include <libbsdf/Common/FastMath.h>
 #include <libbsdf/Common/Global.h>
+#include <libbsdf/Common/SimdMath.h>
 #include <libbsdf/Common/Vector.h>
 
 namespace lb {
@@ -72,6 +74,36 @@ struct SphericalCoordinateSystem
 
     /*! Converts from a Cartesian coordinate system to a spherical. */
     static void fromXyz(const Vec3& dir, float* theta, float* phi);
+
+    /*!
+     * Converts from four angles in SIMD lanes to incoming and outgoing directions.
+     * \a inDir and \a outDir are arrays of x, y, and z lanes.
+     */
+    static void toXyz(FloatLanes inTheta, FloatLanes inPhi,
+                      FloatLanes outTheta, FloatLanes outPhi,
+                      FloatLanes* inDir, FloatLanes* outDir);
+
+    /*!
+     * Converts from incoming and outgoing directions in SIMD lanes to four angles.
+     * \a inDir and \a outDir are arrays of x, y, and z lanes.
+     */
+    static void fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                        FloatLanes* inTheta, FloatLanes* inPhi,
+                        FloatLanes* outTheta, FloatLanes* outPhi);
+
+    /*!
+     * Converts from incoming and outgoing directions in SIMD lanes to three angles for isotropic data.
+     * \a inDir and \a outDir are arrays of x, y, and z lanes.
+     */
+    static void fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                        FloatLanes* inTheta,
+                        FloatLanes* outTheta, FloatLanes* outPhi);
+
+    /*! Converts from a spherical coordinate system in SIMD lanes to a Cartesian. */
+    static void toXyz(FloatLanes theta, FloatLanes phi, FloatLanes* dir);
+
+    /*! Converts from a Cartesian coordinate system in SIMD lanes to a spherical. */
+    static void fromXyz(const FloatLanes* dir, FloatLanes* theta, FloatLanes* phi);
 };
 
 inline void SphericalCoordinateSystem::toXyz(float inTheta, float inPhi,
@@ -126,8 +158,8 @@ inline Vec3 SphericalCoordinateSystem::toXyz(float theta, float phi)
 
 inline void SphericalCoordinateSystem::fromXyz(const Vec3& dir, float* theta, float* phi)
 {
-    *theta = std::acos(dir[2]);
-    *phi = std::atan2(dir[1], dir[0]);
+    *theta = fastAcos(dir[2]);
+    *phi = fastAtan2(dir[1], dir[0]);
     if (*phi < 0.0f) {
         *phi += 2.0f * PI_F;
     }
@@ -136,6 +168,52 @@ inline void SphericalCoordinateSystem::fromXyz(const Vec3& dir, float* theta, fl
            !std::isinf(*theta) && !std::isinf(*phi));
 }
 
+inline void SphericalCoordinateSystem::toXyz(FloatLanes inTheta, FloatLanes inPhi,
+                                             FloatLanes outTheta, FloatLanes outPhi,
+                                             FloatLanes* inDir, FloatLanes* outDir)
+{
+    toXyz(inTheta, inPhi, inDir);
+    toXyz(outTheta, outPhi, outDir);
+}
+
+inline void SphericalCoordinateSystem::fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                                               FloatLanes* inTheta, FloatLanes* inPhi,
+                                               FloatLanes* outTheta, FloatLanes* outPhi)
+{
+    fromXyz(inDir, inTheta, inPhi);
+    fromXyz(outDir, outTheta, outPhi);
+}
+
+inline void SphericalCoordinateSystem::fromXyz(const FloatLanes* inDir, const FloatLanes* outDir,
+                                               FloatLanes* inTheta,
+                                               FloatLanes* outTheta, FloatLanes* outPhi)
+{
+    FloatLanes inPhi;
+    fromXyz(inDir, inTheta, &inPhi);
+    fromXyz(outDir, outTheta, outPhi);
+
+    FloatLanes phi = subLanes(*outPhi, inPhi);
+    *outPhi = selectLanes(lessLanes(phi, setLanes(0.0f)), addLanes(phi, setLanes(2.0f * PI_F)), phi);
+}
+
+inline void SphericalCoordinateSystem::toXyz(FloatLanes theta, FloatLanes phi, FloatLanes* dir)
+{
+    FloatLanes sinTheta = sinLanes(theta);
+    dir[0] = mulLanes(sinTheta, cosLanes(phi));
+    dir[1] = mulLanes(sinTheta, sinLanes(phi));
+    dir[2] = cosLanes(theta);
+}
+
+inline void SphericalCoordinateSystem::fromXyz(const FloatLanes* dir, FloatLanes* theta, FloatLanes* phi)
+{
+    // The polar angle is accurate around the pole unlike acos.
+    FloatLanes lengthXy = sqrtLanes(addLanes(mulLanes(dir[0], dir[0]), mulLanes(dir[1], dir[1])));
+    *theta = atan2Lanes(lengthXy, dir[2]);
+
+    FloatLanes angle = atan2Lanes(dir[1], dir[0]);
+    *phi = selectLanes(lessLanes(angle, setLanes(0.0f)), addLanes(angle, setLanes(2.0f * PI_F)), angle);
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_SPHERICAL_COORDINATE_SYSTEM_H
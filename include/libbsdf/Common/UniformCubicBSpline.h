@@ -0,0 +1,133 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_UNIFORM_CUBIC_B_SPLINE_H
+#define LIBBSDF_UNIFORM_CUBIC_B_SPLINE_H
+
+#include <cmath>
+
+namespace lb {
+
+/*!
+ * \class   UniformCubicBSpline
+ * \brief   The UniformCubicBSpline class provides the interpolation using uniform cubic B-spline.
+ *
+ * Values at knots are converted into control points by a recursive prefilter so that
+ * the spline passes through the values. The values are extended by mirroring at both ends,
+ * or periodically if the last value is the same point as the first value.
+ */
+class UniformCubicBSpline
+{
+public:
+    /*!
+     * Converts values at knots into control points in place.
+     * The value at index i is values[i * stride].
+     */
+    static void prefilter(float* values, int numValues, int stride, bool periodic);
+
+    /*! Gets the weights of four control points around the interval containing a parameter \a t in [0, 1]. */
+    static void getWeights(float t, float* weights);
+
+private:
+    /*! The pole of the prefilter. */
+    static double getPole();
+};
+
+/*
+ * Implementation
+ */
+
+inline void UniformCubicBSpline::prefilter(float* values, int numValues, int stride, bool periodic)
+{
+    if (numValues < 2) return;
+
+    const double z = getPole();
+    const double gain = (1.0 - z) * (1.0 - 1.0 / z);
+
+    // The last value is the same point as the first value.
+    const int numPeriodicValues = numValues - 1;
+
+    if (periodic && numPeriodicValues >= 2) {
+        const int n = numPeriodicValues;
+        const double zn = std::pow(z, n);
+
+        // Causal filter.
+        double sum = 0.0;
+        double zk = 1.0;
+        for (int k = 0; k < n; ++k, zk *= z) {
+            sum += zk * gain * values[((n - k) % n) * stride];
+        }
+
+        double prevValue = sum / (1.0 - zn);
+        values[0] = static_cast<float>(prevValue);
+        for (int i = 1; i < n; ++i) {
+            prevValue = gain * values[i * stride] + z * prevValue;
+            values[i * stride] = static_cast<float>(prevValue);
+        }
+
+        // Anti-causal filter.
+        sum = 0.0;
+        zk = 1.0;
+        for (int k = 0; k < n; ++k, zk *= z) {
+            sum += zk * values[((n - 1 + k) % n) * stride];
+        }
+
+        prevValue = -z / (1.0 - zn) * sum;
+        values[(n - 1) * stride] = static_cast<float>(prevValue);
+        for (int i = n - 2; i >= 0; --i) {
+            prevValue = z * (prevValue - values[i * stride]);
+            values[i * stride] = static_cast<float>(prevValue);
+        }
+
+        values[n * stride] = values[0];
+        return;
+    }
+
+    const int n = numValues;
+
+    // Causal filter with mirrored values.
+    double zk = z;
+    double z2k = std::pow(z, 2 * n - 3);
+    double sum = gain * (values[0] + std::pow(z, n - 1) * values[(n - 1) * stride]);
+    for (int k = 1; k < n - 1; ++k, zk *= z, z2k /= z) {
+        sum += (zk + z2k) * gain * values[k * stride];
+    }
+
+    double prevValue = sum / (1.0 - std::pow(z, 2 * n - 2));
+    values[0] = static_cast<float>(prevValue);
+    for (int i = 1; i < n; ++i) {
+        prevValue = gain * values[i * stride] + z * prevValue;
+        values[i * stride] = static_cast<float>(prevValue);
+    }
+
+    // Anti-causal filter with mirrored values.
+    prevValue = (z / (z * z - 1.0)) * (values[(n - 1) * stride] + z * values[(n - 2) * stride]);
+    values[(n - 1) * stride] = static_cast<float>(prevValue);
+    for (int i = n - 2; i >= 0; --i) {
+        prevValue = z * (prevValue - values[i * stride]);
+        values[i * stride] = static_cast<float>(prevValue);
+    }
+}
+
+inline void UniformCubicBSpline::getWeights(float t, float* weights)
+{
+    float t2 = t * t;
+    float t3 = t2 * t;
+    float s = 1.0f - t;
+
+    weights[0] = s * s * s / 6.0f;
+    weights[1] = (4.0f - 6.0f * t2 + 3.0f * t3) / 6.0f;
+    weights[2] = (1.0f + 3.0f * t + 3.0f * t2 - 3.0f * t3) / 6.0f;
+    weights[3] = t3 / 6.0f;
+}
+
+inline double UniformCubicBSpline::getPole() { return std::sqrt(3.0) - 2.0; }
+
+} // namespace lb
+
+#endif // LIBBSDF_UNIFORM_CUBIC_B_SPLINE_H
@@ -11,6 +11,8 @@
 
 #include <limits>
 
+#include <libbsdf/Common/FastMath.h>
+
 namespace lb {
 
 #if defined(__C99__) || (defined(__GNUC__) && __GNUC__ >= 3)
@@ -103,7 +105,7 @@ inline Vec3T Xorshift::randomOnHemisphere()
     float phi = Xorshift::random<float>() * 2.0f * PI_F;
     float coeff = std::sqrt(1.0f - z * z);
 
-    return Vec3T(coeff * std::cos(phi), coeff * std::sin(phi), z);
+    return Vec3T(coeff * fastCos(phi), coeff * fastSin(phi), z);
 }
 
 } // namespace lb
@@ -9,6 +9,8 @@
 #ifndef LIBBSDF_ASTM_READER_H
 #define LIBBSDF_ASTM_READER_H
 
+#include <memory>
+#include <set>
 #include <string>
 
 #include <libbsdf/Brdf/SphericalCoordinatesBrdf.h>
@@ -29,8 +31,23 @@ class AstmReader
 public:
     /*! Reads an ASTM file and creates the BRDF of a spherical coordinate system. */
     static SphericalCoordinatesBrdf* read(const std::string& fileName);
+
+    /*!
+     * Reads an ASTM file and creates the BRDF of a spherical coordinate system.
+     * The returned object is owned by std::unique_ptr.
+     */
+    static std::unique_ptr<SphericalCoordinatesBrdf> readUnique(const std::string& fileName);
+
+private:
+    /*! Returns true if outgoing azimuthal angles are on one side of the plane of incidence. */
+    static bool isOneSide(const std::set<float>& outPhiAngles);
 };
 
+inline std::unique_ptr<SphericalCoordinatesBrdf> AstmReader::readUnique(const std::string& fileName)
+{
+    return std::unique_ptr<SphericalCoordinatesBrdf>(read(fileName));
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_ASTM_READER_H
@@ -9,6 +9,7 @@
 #ifndef LIBBSDF_DDR_READER_H
 #define LIBBSDF_DDR_READER_H
 
+#include <memory>
 #include <string>
 
 #include <libbsdf/Brdf/SpecularCoordinatesBrdf.h>
@@ -28,8 +29,19 @@ class DdrReader
 public:
     /*! Reads a DDR or DDT file and creates the BRDF of a specular coordinate system. */
     static SpecularCoordinatesBrdf* read(const std::string& fileName);
+
+    /*!
+     * Reads a DDR or DDT file and creates the BRDF of a specular coordinate system.
+     * The returned object is owned by std::unique_ptr.
+     */
+    static std::unique_ptr<SpecularCoordinatesBrdf> readUnique(const std::string& fileName);
 };
 
+inline std::unique_ptr<SpecularCoordinatesBrdf> DdrReader::readUnique(const std::string& fileName)
+{
+    return std::unique_ptr<SpecularCoordinatesBrdf>(read(fileName));
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_DDR_READER_H
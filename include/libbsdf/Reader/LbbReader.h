@@ -0,0 +1,60 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_LBB_READER_H
+#define LIBBSDF_LBB_READER_H
+
+#include <memory>
+#include <string>
+
+#include <libbsdf/Brdf/Brdf.h>
+
+namespace lb {
+
+/*!
+ * \class LbbReader
+ * \brief The LbbReader class provides the reader of a libbsdf binary (LBB) file.
+ *
+ * The file is memory-mapped and the array of spectra of lb::SampleSet is backed by the mapped pages
+ * without copying. The pages are loaded on demand and shared between processes reading the same file.
+ * Pages are mapped copy-on-write, so modified spectra are not written back to the file.
+ *
+ * The format is described in LbbUtility.h.
+ */
+class LbbReader
+{
+public:
+    /*!
+     * Reads an LBB file and creates the BRDF of a spherical, specular, or half difference
+     * coordinate system.
+     */
+    static Brdf* read(const std::string& fileName);
+
+    /*!
+     * Reads an LBB file and creates the BRDF of a spherical, specular, or half difference
+     * coordinate system.
+     * The returned object is owned by std::unique_ptr.
+     */
+    static std::unique_ptr<Brdf> readUnique(const std::string& fileName);
+
+private:
+    /*!
+     * Maps a file into memory and assigns its size to \a fileSize.
+     * The file is unmapped when the returned pointer is released.
+     */
+    static std::shared_ptr<void> mapFile(const std::string& fileName, uint64_t* fileSize);
+};
+
+inline std::unique_ptr<Brdf> LbbReader::readUnique(const std::string& fileName)
+{
+    return std::unique_ptr<Brdf>(read(fileName));
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_LBB_READER_H
@@ -0,0 +1,88 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+/*!
+ * \file    LbbUtility.h
+ * \brief   Declarations of the libbsdf binary (LBB) format.
+ *
+ * An LBB file consists of a header, the arrays of angle0, angle1, angle2, angle3, and wavelengths
+ * in single precision, and the array of spectra. The array of spectra is stored in the memory layout,
+ * precision, and symmetry of lb::SampleSet and starts at an offset aligned to LBB_SPECTRA_ALIGNMENT bytes,
+ * so that it can be used directly from a memory-mapped file. Values are stored in native byte order.
+ */
+
+#ifndef LIBBSDF_LBB_UTILITY_H
+#define LIBBSDF_LBB_UTILITY_H
+
+#include <cstdint>
+
+#include <libbsdf/Common/Global.h>
+
+namespace lb {
+namespace lbb_utility {
+
+/*! The coordinate systems of BRDFs. */
+enum CoordinateSystemType {
+    UNKNOWN_COORDINATE_SYSTEM = 0,
+    SPHERICAL_COORDINATE_SYSTEM,
+    SPECULAR_COORDINATE_SYSTEM,
+    HALF_DIFFERENCE_COORDINATE_SYSTEM
+};
+
+/*! The signature at the beginning of an LBB file. */
+const char LBB_SIGNATURE[8] = { 'L', 'I', 'B', 'B', 'S', 'D', 'F', '\0' };
+
+const uint32_t LBB_VERSION = 1;                 /*!< The version of the format. */
+const uint32_t LBB_BYTE_ORDER_MARK = 0x01020304; /*!< The value used to detect the byte order. */
+const uint64_t LBB_SPECTRA_ALIGNMENT = 64;      /*!< The alignment of the array of spectra in bytes. */
+
+/*! The header of an LBB file. */
+struct LbbHeader
+{
+    char        signature[8];       /*!< LBB_SIGNATURE */
+    uint32_t    version;            /*!< LBB_VERSION */
+    uint32_t    byteOrderMark;      /*!< LBB_BYTE_ORDER_MARK */
+    uint32_t    coordinateSystem;   /*!< lb::lbb_utility::CoordinateSystemType */
+    uint32_t    colorModel;         /*!< lb::ColorModel */
+    uint32_t    spectrumLayout;     /*!< lb::SpectrumLayout */
+    uint32_t    spectrumPrecision;  /*!< lb::SpectrumPrecision */
+    int32_t     numAngles[4];       /*!< The numbers of angle0, angle1, angle2, and angle3. */
+    int32_t     numWavelengths;     /*!< The number of wavelengths. */
+    uint32_t    symmetry;           /*!< lb::SymmetryType */
+    uint64_t    spectraOffset;      /*!< The offset of the array of spectra from the beginning of the file. */
+    uint64_t    spectraSize;        /*!< The size of the array of spectra in bytes. */
+};
+
+/*! Gets the number of bytes of an element of spectra. */
+uint64_t getElementSize(SpectrumPrecision spectrumPrecision);
+
+/*! Gets the offset of the array of spectra following the header, angles, and wavelengths. */
+uint64_t getSpectraOffset(const LbbHeader& header);
+
+} // namespace lbb_utility
+
+inline uint64_t lbb_utility::getElementSize(SpectrumPrecision spectrumPrecision)
+{
+    return (spectrumPrecision == SINGLE_PRECISION) ? sizeof(float) : sizeof(uint16_t);
+}
+
+inline uint64_t lbb_utility::getSpectraOffset(const LbbHeader& header)
+{
+    uint64_t numElements = static_cast<uint64_t>(header.numAngles[0])
+                         + static_cast<uint64_t>(header.numAngles[1])
+                         + static_cast<uint64_t>(header.numAngles[2])
+                         + static_cast<uint64_t>(header.numAngles[3])
+                         + static_cast<uint64_t>(header.numWavelengths);
+    uint64_t offset = sizeof(LbbHeader) + sizeof(float) * numElements;
+
+    return (offset + LBB_SPECTRA_ALIGNMENT - 1) / LBB_SPECTRA_ALIGNMENT * LBB_SPECTRA_ALIGNMENT;
+}
+
+} // namespace lb
+
+#endif // LIBBSDF_LBB_UTILITY_H
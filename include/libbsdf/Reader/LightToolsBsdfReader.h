@@ -9,6 +9,7 @@
 #ifndef LIBBSDF_LIGHTTOOLS_BSDF_READER_H
 #define LIBBSDF_LIGHTTOOLS_BSDF_READER_H
 
+#include <memory>
 #include <string>
 
 #include <libbsdf/Brdf/SphericalCoordinatesBrdf.h>
@@ -30,6 +31,12 @@ public:
     /*! Reads a LightTools BSDF file and creates the two-sided material of a spherical coordinate system. */
     static TwoSidedMaterial* read(const std::string& fileName);
 
+    /*!
+     * Reads a LightTools BSDF file and creates the two-sided material of a spherical coordinate system.
+     * The returned object is owned by std::unique_ptr.
+     */
+    static std::unique_ptr<TwoSidedMaterial> readUnique(const std::string& fileName);
+
 private:
     enum SymmetryType {
         UNKNOWN_SYMMETRY = 0,
@@ -81,6 +88,11 @@ inline void LightToolsBsdfReader::ignoreCommentLines(std::istream& stream)
     reader_utility::ignoreCommentLines(stream, "#");
 }
 
+inline std::unique_ptr<TwoSidedMaterial> LightToolsBsdfReader::readUnique(const std::string& fileName)
+{
+    return std::unique_ptr<TwoSidedMaterial>(read(fileName));
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_LIGHTTOOLS_BSDF_READER_H
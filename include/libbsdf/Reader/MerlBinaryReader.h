@@ -9,6 +9,7 @@
 #ifndef LIBBSDF_MERL_BINARY_READER_H
 #define LIBBSDF_MERL_BINARY_READER_H
 
+#include <memory>
 #include <string>
 
 #include <libbsdf/Brdf/HalfDifferenceCoordinatesBrdf.h>
@@ -32,8 +33,19 @@ class MerlBinaryReader
 public:
     /*! Reads a MERL binary file and creates the BRDF of a half difference coordinate system. */
     static HalfDifferenceCoordinatesBrdf* read(const std::string& fileName);
+
+    /*!
+     * Reads a MERL binary file and creates the BRDF of a half difference coordinate system.
+     * The returned object is owned by std::unique_ptr.
+     */
+    static std::unique_ptr<HalfDifferenceCoordinatesBrdf> readUnique(const std::string& fileName);
 };
 
+inline std::unique_ptr<HalfDifferenceCoordinatesBrdf> MerlBinaryReader::readUnique(const std::string& fileName)
+{
+    return std::unique_ptr<HalfDifferenceCoordinatesBrdf>(read(fileName));
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_MERL_BINARY_READER_H
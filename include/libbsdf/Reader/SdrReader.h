@@ -9,6 +9,7 @@
 #ifndef LIBBSDF_SDR_READER_H
 #define LIBBSDF_SDR_READER_H
 
+#include <memory>
 #include <string>
 
 #include <libbsdf/Brdf/SampleSet2D.h>
@@ -28,8 +29,19 @@ class SdrReader
 public:
     /*! Reads a SDR or SDT file and creates sample points. */
     static SampleSet2D* read(const std::string& fileName);
+
+    /*!
+     * Reads a SDR or SDT file and creates sample points.
+     * The returned object is owned by std::unique_ptr.
+     */
+    static std::unique_ptr<SampleSet2D> readUnique(const std::string& fileName);
 };
 
+inline std::unique_ptr<SampleSet2D> SdrReader::readUnique(const std::string& fileName)
+{
+    return std::unique_ptr<SampleSet2D>(read(fileName));
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_SDR_READER_H
@@ -9,6 +9,7 @@
 #ifndef LIBBSDF_ZEMAX_BSDF_READER_H
 #define LIBBSDF_ZEMAX_BSDF_READER_H
 
+#include <memory>
 #include <string>
 
 #include <libbsdf/Brdf/SpecularCoordinatesBrdf.h>
@@ -34,6 +35,13 @@ public:
      */
     static SpecularCoordinatesBrdf* read(const std::string& fileName, DataType* dataType);
 
+    /*!
+     * Reads a Zemax BSDF file and creates the two-sided material of a spherical coordinate system.
+     * \a dataType returns lb::BRDF_DATA or lb::BTDF_DATA.
+     * The returned object is owned by std::unique_ptr.
+     */
+    static std::unique_ptr<SpecularCoordinatesBrdf> readUnique(const std::string& fileName, DataType* dataType);
+
 private:
     enum SymmetryType {
         UNKNOWN_SYMMETRY = 0,
@@ -51,6 +59,11 @@ inline void ZemaxBsdfReader::ignoreCommentLines(std::istream& stream)
     reader_utility::ignoreCommentLines(stream, "#");
 }
 
+inline std::unique_ptr<SpecularCoordinatesBrdf> ZemaxBsdfReader::readUnique(const std::string& fileName, DataType* dataType)
+{
+    return std::unique_ptr<SpecularCoordinatesBrdf>(read(fileName, dataType));
+}
+
 } // namespace lb
 
 #endif // LIBBSDF_ZEMAX_BSDF_READER_H
@@ -64,7 +64,6 @@ inline float CookTorrance::compute(const Vec3&  L,
                                    float        roughness,
                                    float        refractiveIndex)
 {
-    using std::acos;
     using std::exp;
     using std::min;
 
@@ -81,7 +80,7 @@ inline float CookTorrance::compute(const Vec3&  L,
     float sqTanHN = (1.0f - sqDotHN) / (sqRoughness * sqDotHN);
 
     float D = exp(-sqTanHN) / (4.0f * sqRoughness * sqDotHN * sqDotHN);
-    float F = fresnelReflection(acos(dotVH), refractiveIndex);
+    float F = fresnelReflection(fastAcos(dotVH), refractiveIndex);
     float G = min(dotHN * dotVN / dotVH,
                   dotHN * dotLN / dotVH);
     G = min(1.0f, 2.0f * G);
@@ -11,6 +11,8 @@
 
 #include <cmath>
 
+#include <libbsdf/Common/FastMath.h>
+
 namespace lb {
 
 /*! Fresnel reflection. */
@@ -25,8 +27,8 @@ float fresnelReflection(float inTheta, float n);
 
 inline float fresnelReflection(float inTheta, float n1, float n2)
 {
-    float cosi = std::cos(inTheta);
-    float sint = n1 / n2 * std::sin(inTheta);
+    float cosi = fastCos(inTheta);
+    float sint = n1 / n2 * fastSin(inTheta);
     float cost = std::sqrt(1.0f - sint * sint);
 
     float rs = (n1 * cosi - n2 * cost) / (n1 * cosi + n2 * cost);
@@ -33,12 +33,11 @@ bool setupBrdf(const T& reflectanceModel, Brdf* brdf, const Vec3& color = Vec3(1
         return false;
     }
 
-    for (int i0 = 0; i0 < ss->getNumAngles0(); ++i0) {
-    for (int i1 = 0; i1 < ss->getNumAngles1(); ++i1) {
-    for (int i2 = 0; i2 < ss->getNumAngles2(); ++i2) {
-    for (int i3 = 0; i3 < ss->getNumAngles3(); ++i3) {
-        Vec3 inDir, outDir;
-        brdf->getInOutDirection(i0, i1, i2, i3, &inDir, &outDir);
+    brdf->forEachInOutDirection([&](int i0, int i1, int i2, int i3,
+                                    const Vec3& inDirAtSample, const Vec3& outDirAtSample)
+    {
+        Vec3 inDir = inDirAtSample;
+        Vec3 outDir = outDirAtSample;
 
         const float minZ = 0.001f;
         inDir.z() = std::max(inDir.z(), minZ);
@@ -54,7 +53,7 @@ bool setupBrdf(const T& reflectanceModel, Brdf* brdf, const Vec3& color = Vec3(1
         const float maxBrdfVal = 10000.0f;
         sp = sp.cwiseMin(maxBrdfVal);
         ss->setSpectrum(i0, i1, i2, i3, sp);
-    }}}}
+    });
 
     return true;
 }
@@ -0,0 +1,40 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#ifndef LIBBSDF_LBB_WRITER_H
+#define LIBBSDF_LBB_WRITER_H
+
+#include <string>
+
+#include <libbsdf/Brdf/Brdf.h>
+
+namespace lb {
+
+/*!
+ * \class LbbWriter
+ * \brief The LbbWriter class provides the writer of a libbsdf binary (LBB) file.
+ *
+ * Spectra are written in the memory layout and precision of lb::SampleSet.
+ * The format is described in LbbUtility.h.
+ */
+class LbbWriter
+{
+public:
+    /*!
+     * Writes the BRDF of a spherical, specular, or half difference coordinate system
+     * in an LBB file.
+     */
+    static bool write(const std::string& fileName, const Brdf& brdf);
+
+    /*! Outputs binary data of an LBB file to a stream. */
+    static bool output(const Brdf& brdf, std::ostream& stream);
+};
+
+} // namespace lb
+
+#endif // LIBBSDF_LBB_WRITER_H
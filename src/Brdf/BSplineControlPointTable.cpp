@@ -0,0 +1,92 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Brdf/BSplineControlPointTable.h>
+
+#include <libbsdf/Common/UniformCubicBSpline.h>
+
+using namespace lb;
+
+BSplineControlPointTable::BSplineControlPointTable() : samples_(0),
+                                                       numAngles0_(0),
+                                                       numAngles1_(0),
+                                                       numAngles2_(0),
+                                                       numAngles3_(0),
+                                                       numWavelengths_(0) {}
+
+BSplineControlPointTable::BSplineControlPointTable(const SampleSet& samples) : samples_(0),
+                                                                               numAngles0_(0),
+                                                                               numAngles1_(0),
+                                                                               numAngles2_(0),
+                                                                               numAngles3_(0),
+                                                                               numWavelengths_(0)
+{
+    build(samples);
+}
+
+void BSplineControlPointTable::build(const SampleSet& samples)
+{
+    samples_ = &samples;
+
+    numAngles0_ = samples.getNumAngles0();
+    numAngles1_ = samples.getNumAngles1();
+    numAngles2_ = samples.getNumAngles2();
+    numAngles3_ = samples.getNumAngles3();
+    numWavelengths_ = samples.getNumWavelengths();
+
+    const int numAngles[4] = { numAngles0_, numAngles1_, numAngles2_, numAngles3_ };
+    const bool periodic[4] = { false, isFullCircle(samples.getAngles1()), false, isFullCircle(samples.getAngles3()) };
+    const int numSamples = numAngles0_ * numAngles1_ * numAngles2_ * numAngles3_;
+
+    controlPoints_.resize(numSamples * numWavelengths_);
+
+    #pragma omp parallel for
+    for (int i3 = 0; i3 < numAngles3_; ++i3) {
+        Spectrum sp;
+        for (int i2 = 0; i2 < numAngles2_; ++i2) {
+        for (int i1 = 0; i1 < numAngles1_; ++i1) {
+        for (int i0 = 0; i0 < numAngles0_; ++i0) {
+            samples.getSpectrum(samples.getIndex(i0, i1, i2, i3), &sp);
+
+            int index = i0 + numAngles0_ * (i1 + numAngles1_ * (i2 + numAngles2_ * i3));
+            controlPoints_.segment(index * numWavelengths_, numWavelengths_) = sp;
+        }}}
+    }
+
+    // Prefilter along each axis. A line of an axis starts at an index below the axis.
+    int stride = 1;
+    for (int axis = 0; axis < 4; ++axis) {
+        const int numLines = numSamples / numAngles[axis];
+
+        #pragma omp parallel for
+        for (int line = 0; line < numLines; ++line) {
+            int innerIndex = line % stride;
+            int outerIndex = line / stride;
+            int firstIndex = innerIndex + stride * numAngles[axis] * outerIndex;
+
+            float* values = &controlPoints_[firstIndex * numWavelengths_];
+            for (int i = 0; i < numWavelengths_; ++i) {
+                UniformCubicBSpline::prefilter(values + i, numAngles[axis], stride * numWavelengths_,
+                                               periodic[axis]);
+            }
+        }
+
+        stride *= numAngles[axis];
+    }
+}
+
+void BSplineControlPointTable::clear()
+{
+    samples_ = 0;
+    numAngles0_ = 0;
+    numAngles1_ = 0;
+    numAngles2_ = 0;
+    numAngles3_ = 0;
+    numWavelengths_ = 0;
+    controlPoints_.resize(0);
+}
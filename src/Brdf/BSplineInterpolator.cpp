@@ -0,0 +1,119 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Brdf/BSplineInterpolator.h>
+
+#include <algorithm>
+
+#include <libbsdf/Common/UniformCubicBSpline.h>
+#include <libbsdf/Common/Utility.h>
+
+using namespace lb;
+
+void BSplineInterpolator::interpolate(const BSplineControlPointTable&    table,
+                                      float                              angle0,
+                                      float                              angle1,
+                                      float                              angle2,
+                                      float                              angle3,
+                                      int                                wavelengthIndex,
+                                      int                                numWavelengths,
+                                      float*                             values)
+{
+    const SampleSet& samples = *table.getSampleSet();
+
+    int indices0[4], indices1[4], indices2[4], indices3[4];
+    float weights0[4], weights1[4], weights2[4], weights3[4];
+
+    int numPoints0 = findControlPoints(samples.getAngles0(), samples.getAngleLookupTable0(),
+                                       samples.isEqualIntervalAngles0(), false,
+                                       angle0, indices0, weights0);
+    int numPoints1 = findControlPoints(samples.getAngles1(), samples.getAngleLookupTable1(),
+                                       samples.isEqualIntervalAngles1(), isFullCircle(samples.getAngles1()),
+                                       angle1, indices1, weights1);
+    int numPoints2 = findControlPoints(samples.getAngles2(), samples.getAngleLookupTable2(),
+                                       samples.isEqualIntervalAngles2(), false,
+                                       angle2, indices2, weights2);
+    int numPoints3 = findControlPoints(samples.getAngles3(), samples.getAngleLookupTable3(),
+                                       samples.isEqualIntervalAngles3(), isFullCircle(samples.getAngles3()),
+                                       angle3, indices3, weights3);
+
+    const int numAngles0 = samples.getNumAngles0();
+    const int numAngles1 = samples.getNumAngles1();
+    const int numAngles2 = samples.getNumAngles2();
+
+    for (int i = 0; i < numWavelengths; ++i) {
+        values[i] = 0.0f;
+    }
+
+    for (int i3 = 0; i3 < numPoints3; ++i3) {
+    for (int i2 = 0; i2 < numPoints2; ++i2) {
+        float weight23 = weights3[i3] * weights2[i2];
+        int index23 = numAngles1 * (indices2[i2] + numAngles2 * indices3[i3]);
+
+        for (int i1 = 0; i1 < numPoints1; ++i1) {
+            float weight123 = weight23 * weights1[i1];
+            int index123 = numAngles0 * (indices1[i1] + index23);
+
+            for (int i0 = 0; i0 < numPoints0; ++i0) {
+                float weight = weight123 * weights0[i0];
+                const float* points = table.getControlPoints(indices0[i0] + index123) + wavelengthIndex;
+                for (int i = 0; i < numWavelengths; ++i) {
+                    values[i] += weight * points[i];
+                }
+            }
+        }
+    }}
+}
+
+int BSplineInterpolator::findControlPoints(const Arrayf&            angles,
+                                           const AngleLookupTable&  lookupTable,
+                                           bool                     equalIntervalAngles,
+                                           bool                     periodic,
+                                           float                    angle,
+                                           int*                     indices,
+                                           float*                   weights)
+{
+    if (angles.size() == 1) {
+        indices[0] = 0;
+        weights[0] = 1.0f;
+        return 1;
+    }
+
+    int backIndex = static_cast<int>(angles.size() - 1);
+
+    int lowerIndex;
+    if (equalIntervalAngles) {
+        lowerIndex = static_cast<int>(backIndex * angle / (angles[backIndex]));
+        lowerIndex = clamp(lowerIndex, 0, backIndex - 1);
+    }
+    else {
+        lowerIndex = clamp(lookupTable.findLowerBound(angles, angle), 1, backIndex) - 1;
+    }
+
+    float interval = std::max(angles[lowerIndex + 1] - angles[lowerIndex], EPSILON_F);
+    float t = clamp((angle - angles[lowerIndex]) / interval, 0.0f, 1.0f);
+    UniformCubicBSpline::getWeights(t, weights);
+
+    // Control points are extended in the same way as the prefilter.
+    for (int i = 0; i < 4; ++i) {
+        int index = lowerIndex - 1 + i;
+        if (periodic) {
+            index = (index + backIndex) % backIndex;
+        }
+        else if (index < 0) {
+            index = -index;
+        }
+        else if (index > backIndex) {
+            index = 2 * backIndex - index;
+        }
+
+        indices[i] = index;
+    }
+
+    return 4;
+}
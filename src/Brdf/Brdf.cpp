@@ -8,6 +8,9 @@
 
 #include <libbsdf/Brdf/Brdf.h>
 
+#include <algorithm>
+#include <utility>
+
 using namespace lb;
 
 Brdf::~Brdf() { delete samples_; }
@@ -28,3 +31,68 @@ Brdf::Brdf(int          numAngles0,
 Brdf::Brdf() : samples_(0) {}
 
 Brdf::Brdf(const Brdf& brdf) : samples_(new SampleSet(*brdf.getSampleSet())) {}
+
+Brdf::Brdf(Brdf&& brdf) : samples_(brdf.samples_)
+{
+    brdf.samples_ = 0;
+}
+
+Brdf& Brdf::operator=(Brdf&& brdf)
+{
+    std::swap(samples_, brdf.samples_);
+    return *this;
+}
+
+void Brdf::getSpectrum(const Vec3& inDir, const Vec3& outDir, float* spectrum) const
+{
+    Spectrum sp = getSpectrum(inDir, outDir);
+    std::copy(sp.data(), sp.data() + sp.size(), spectrum);
+}
+
+void Brdf::getSpectrum(const Vec3&      inDir,
+                       const Vec3&      outDir,
+                       LookupContext*   /*context*/,
+                       float*           spectrum) const
+{
+    getSpectrum(inDir, outDir, spectrum);
+}
+
+void Brdf::getSpectrumStochastic(const Vec3&    inDir,
+                                 const Vec3&    outDir,
+                                 float          /*randomNumber*/,
+                                 float*         spectrum) const
+{
+    getSpectrum(inDir, outDir, spectrum);
+}
+
+void Brdf::getSpectra(const Vec3*   inDirs,
+                      const Vec3*   outDirs,
+                      int           numQueries,
+                      float*        spectra) const
+{
+    const int numWavelengths = samples_->getNumWavelengths();
+    for (int i = 0; i < numQueries; ++i) {
+        getSpectrum(inDirs[i], outDirs[i], spectra + i * numWavelengths);
+    }
+}
+
+void Brdf::getValues(const Vec3*    inDirs,
+                     const Vec3*    outDirs,
+                     int            numQueries,
+                     int            wavelengthIndex,
+                     float*         values) const
+{
+    for (int i = 0; i < numQueries; ++i) {
+        values[i] = getValue(inDirs[i], outDirs[i], wavelengthIndex);
+    }
+}
+
+std::unique_ptr<DirectionTable> Brdf::createDirectionTable() const
+{
+    return std::unique_ptr<DirectionTable>(new DirectionTable(*this));
+}
+
+std::unique_ptr<BrdfSlice> Brdf::bindIncoming(const Vec3& inDir) const
+{
+    return std::unique_ptr<BrdfSlice>(new BrdfSlice(*this, inDir));
+}
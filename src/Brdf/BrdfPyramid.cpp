@@ -0,0 +1,229 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Brdf/BrdfPyramid.h>
+
+#include <algorithm>
+
+#include <libbsdf/Common/Utility.h>
+
+using namespace lb;
+
+BrdfPyramid::BrdfPyramid(const Brdf& brdf, int maxNumLevels)
+{
+    levels_.push_back(std::unique_ptr<Brdf>(brdf.clone()));
+
+    while (getNumLevels() < maxNumLevels) {
+        const SampleSet* ss = levels_.back()->getSampleSet();
+        if (ss->getNumAngles0() <= 2 &&
+            ss->getNumAngles1() <= 2 &&
+            ss->getNumAngles2() <= 2 &&
+            ss->getNumAngles3() <= 2) {
+            break;
+        }
+
+        levels_.push_back(std::unique_ptr<Brdf>(downsample(*levels_.back())));
+    }
+}
+
+BrdfPyramid::~BrdfPyramid() {}
+
+Spectrum BrdfPyramid::getSpectrum(const Vec3& inDir, const Vec3& outDir, float level) const
+{
+    Spectrum sp(levels_.front()->getSampleSet()->getNumWavelengths());
+    getSpectrum(inDir, outDir, level, sp.data());
+    return sp;
+}
+
+void BrdfPyramid::getSpectrum(const Vec3&   inDir,
+                              const Vec3&   outDir,
+                              float         level,
+                              float*        spectrum) const
+{
+    int lastLevel = getNumLevels() - 1;
+    level = clamp(level, 0.0f, static_cast<float>(lastLevel));
+
+    int lowerLevel = std::min(static_cast<int>(level), lastLevel);
+    float weight = level - lowerLevel;
+
+    levels_.at(lowerLevel)->getSpectrum(inDir, outDir, spectrum);
+    if (weight == 0.0f || lowerLevel == lastLevel) return;
+
+    int numWavelengths = levels_.front()->getSampleSet()->getNumWavelengths();
+
+    // Memory is allocated only for spectra with many wavelengths.
+    float stackSp[MAX_NUM_STACK_WAVELENGTHS];
+    std::vector<float> heapSp;
+    float* upperSp = stackSp;
+    if (numWavelengths > MAX_NUM_STACK_WAVELENGTHS) {
+        heapSp.resize(numWavelengths);
+        upperSp = heapSp.data();
+    }
+
+    levels_.at(lowerLevel + 1)->getSpectrum(inDir, outDir, upperSp);
+    for (int i = 0; i < numWavelengths; ++i) {
+        spectrum[i] = lerp(spectrum[i], upperSp[i], weight);
+    }
+}
+
+Brdf* BrdfPyramid::downsample(const Brdf& brdf)
+{
+    const SampleSet* ss = brdf.getSampleSet();
+
+    Arrayf coarseAngles0, coarseAngles1, coarseAngles2, coarseAngles3;
+    std::vector<Taps> taps0, taps1, taps2, taps3;
+    computeTaps(ss->getAngles0(), false,                         &coarseAngles0, &taps0);
+    computeTaps(ss->getAngles1(), isFullCircle(ss->getAngles1()), &coarseAngles1, &taps1);
+    computeTaps(ss->getAngles2(), false,                         &coarseAngles2, &taps2);
+    computeTaps(ss->getAngles3(), isFullCircle(ss->getAngles3()), &coarseAngles3, &taps3);
+
+    SampleSet coarseSs(static_cast<int>(coarseAngles0.size()),
+                       static_cast<int>(coarseAngles1.size()),
+                       static_cast<int>(coarseAngles2.size()),
+                       static_cast<int>(coarseAngles3.size()),
+                       ss->getColorModel(),
+                       ss->getNumWavelengths());
+    coarseSs.getWavelengths() = ss->getWavelengths();
+    coarseSs.setAngles0(coarseAngles0);
+    coarseSs.setAngles1(coarseAngles1);
+    coarseSs.setAngles2(coarseAngles2);
+    coarseSs.setAngles3(coarseAngles3);
+    coarseSs.updateAngleAttributes();
+
+    #pragma omp parallel for
+    for (int i3 = 0; i3 < coarseSs.getNumAngles3(); ++i3) {
+        Spectrum sp, sumSp;
+        for (int i2 = 0; i2 < coarseSs.getNumAngles2(); ++i2) {
+        for (int i1 = 0; i1 < coarseSs.getNumAngles1(); ++i1) {
+        for (int i0 = 0; i0 < coarseSs.getNumAngles0(); ++i0) {
+            sumSp.setZero(ss->getNumWavelengths());
+
+            for (Taps::const_iterator t3 = taps3[i3].begin(); t3 != taps3[i3].end(); ++t3) {
+            for (Taps::const_iterator t2 = taps2[i2].begin(); t2 != taps2[i2].end(); ++t2) {
+            for (Taps::const_iterator t1 = taps1[i1].begin(); t1 != taps1[i1].end(); ++t1) {
+            for (Taps::const_iterator t0 = taps0[i0].begin(); t0 != taps0[i0].end(); ++t0) {
+                ss->getSpectrum(ss->getIndex(t0->first, t1->first, t2->first, t3->first), &sp);
+                sumSp += (t0->second * t1->second * t2->second * t3->second) * sp;
+            }}}}
+
+            coarseSs.setSpectrum(i0, i1, i2, i3, sumSp);
+        }}}
+    }
+
+    Brdf* coarseBrdf = brdf.clone();
+    SampleSet* coarseBrdfSs = coarseBrdf->getSampleSet();
+    *coarseBrdfSs = std::move(coarseSs);
+
+    // Spectra are stored without symmetry if coarse angles are not symmetric.
+    if (ss->getSymmetry() != NO_SYMMETRY) {
+        coarseBrdfSs->setSymmetry(ss->getSymmetry());
+    }
+
+    return coarseBrdf;
+}
+
+float BrdfPyramid::getExtendedAngle(const Arrayf& angles, bool periodic, int index)
+{
+    int lastIndex = static_cast<int>(angles.size()) - 1;
+
+    if (!periodic) {
+        return angles[clamp(index, 0, lastIndex)];
+    }
+
+    // The last angle is the same direction as the first angle.
+    int wrappedIndex = (index % lastIndex + lastIndex) % lastIndex;
+    int numCycles = (index - wrappedIndex) / lastIndex;
+    return angles[wrappedIndex] + numCycles * (angles[lastIndex] - angles[0]);
+}
+
+void BrdfPyramid::computeTaps(const Arrayf&         angles,
+                              bool                  periodic,
+                              Arrayf*               coarseAngles,
+                              std::vector<Taps>*    taps)
+{
+    int numAngles = static_cast<int>(angles.size());
+
+    if (numAngles <= 2) {
+        *coarseAngles = angles;
+        taps->assign(numAngles, Taps(1));
+        for (int i = 0; i < numAngles; ++i) {
+            (*taps)[i][0] = std::make_pair(i, 1.0f);
+        }
+        return;
+    }
+
+    // Every second angle is kept from both ends toward the middle, so mirrored pairs of angles are kept.
+    std::vector<int> fineIndices;
+    for (int i = 0; i <= (numAngles - 1) / 2; i += 2) {
+        fineIndices.push_back(i);
+    }
+
+    int numLowerIndices = static_cast<int>(fineIndices.size());
+    for (int i = numLowerIndices - 1; i >= 0; --i) {
+        int mirroredIndex = numAngles - 1 - fineIndices[i];
+        if (mirroredIndex != fineIndices.back()) {
+            fineIndices.push_back(mirroredIndex);
+        }
+    }
+
+    int numCoarseAngles = static_cast<int>(fineIndices.size());
+    int period = numAngles - 1;
+
+    coarseAngles->resize(numCoarseAngles);
+    taps->assign(numCoarseAngles, Taps());
+
+    for (int i = 0; i < numCoarseAngles; ++i) {
+        int index = fineIndices[i];
+
+        int lowerIndex, upperIndex;
+        if (i > 0)              lowerIndex = fineIndices[i - 1];
+        else if (periodic)      lowerIndex = fineIndices[numCoarseAngles - 2] - period;
+        else                    lowerIndex = index;
+
+        if (i < numCoarseAngles - 1)    upperIndex = fineIndices[i + 1];
+        else if (periodic)              upperIndex = fineIndices[1] + period;
+        else                            upperIndex = index;
+
+        float angle = angles[index];
+        float lowerAngle = getExtendedAngle(angles, periodic, lowerIndex);
+        float upperAngle = getExtendedAngle(angles, periodic, upperIndex);
+
+        (*coarseAngles)[i] = angle;
+
+        Taps& coarseTaps = (*taps)[i];
+        float sumWeights = 0.0f;
+        for (int j = std::min(lowerIndex + 1, index); j <= std::max(upperIndex - 1, index); ++j) {
+            float fineAngle = getExtendedAngle(angles, periodic, j);
+
+            float tent;
+            if (j < index)      tent = 1.0f - (angle - fineAngle) / (angle - lowerAngle);
+            else if (j > index) tent = 1.0f - (fineAngle - angle) / (upperAngle - angle);
+            else                tent = 1.0f;
+
+            // The width of a fine sample point is used as the weight of quadrature.
+            float width = (getExtendedAngle(angles, periodic, j + 1) -
+                           getExtendedAngle(angles, periodic, j - 1)) / 2.0f;
+
+            float weight = tent * width;
+            if (weight <= 0.0f) continue;
+
+            int fineIndex = periodic ? (j % period + period) % period : j;
+            coarseTaps.push_back(std::make_pair(fineIndex, weight));
+            sumWeights += weight;
+        }
+
+        if (sumWeights > 0.0f) {
+            for (Taps::iterator it = coarseTaps.begin(); it != coarseTaps.end(); ++it) {
+                it->second /= sumWeights;
+            }
+        }
+        else {
+            coarseTaps.assign(1, std::make_pair(index, 1.0f));
+        }
+    }
+}
@@ -0,0 +1,42 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Brdf/BrdfSlice.h>
+
+#include <libbsdf/Brdf/Brdf.h>
+
+using namespace lb;
+
+BrdfSlice::BrdfSlice(const Brdf& brdf, const Vec3& inDir) : brdf_(brdf),
+                                                            inDir_(inDir) {}
+
+BrdfSlice::~BrdfSlice() {}
+
+Spectrum BrdfSlice::getSpectrum(const Vec3& outDir) const
+{
+    Spectrum sp(brdf_.getSampleSet()->getNumWavelengths());
+    getSpectrum(outDir, sp.data());
+    return sp;
+}
+
+void BrdfSlice::getSpectrum(const Vec3& outDir, float* spectrum) const
+{
+    brdf_.getSpectrum(inDir_, outDir, spectrum);
+}
+
+void BrdfSlice::getSpectrum(const Vec3&     outDir,
+                            LookupContext*  context,
+                            float*          spectrum) const
+{
+    brdf_.getSpectrum(inDir_, outDir, context, spectrum);
+}
+
+float BrdfSlice::getValue(const Vec3& outDir, int wavelengthIndex) const
+{
+    return brdf_.getValue(inDir_, outDir, wavelengthIndex);
+}
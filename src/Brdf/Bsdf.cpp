@@ -8,6 +8,8 @@
 
 #include <libbsdf/Brdf/Bsdf.h>
 
+#include <utility>
+
 using namespace lb;
 
 Bsdf::Bsdf(Brdf* brdf,
@@ -15,6 +17,21 @@ Bsdf::Bsdf(Brdf* brdf,
            : brdf_(brdf),
              btdf_(btdf) {}
 
+Bsdf::Bsdf(Bsdf&& bsdf)
+           : brdf_(bsdf.brdf_),
+             btdf_(bsdf.btdf_)
+{
+    bsdf.brdf_ = 0;
+    bsdf.btdf_ = 0;
+}
+
+Bsdf& Bsdf::operator=(Bsdf&& bsdf)
+{
+    std::swap(brdf_, bsdf.brdf_);
+    std::swap(btdf_, bsdf.btdf_);
+    return *this;
+}
+
 Bsdf::~Bsdf()
 {
     delete brdf_;
@@ -8,11 +8,49 @@
 
 #include <libbsdf/Brdf/Btdf.h>
 
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
 using namespace lb;
 
 Btdf::Btdf(Brdf* brdf) : brdf_(brdf) {}
 
+Btdf::Btdf(Btdf&& btdf) : brdf_(btdf.brdf_)
+{
+    btdf.brdf_ = 0;
+}
+
+Btdf& Btdf::operator=(Btdf&& btdf)
+{
+    std::swap(brdf_, btdf.brdf_);
+    return *this;
+}
+
 Btdf::~Btdf()
 {
     delete brdf_;
 }
+
+void Btdf::getSpectra(const Vec3*   inDirs,
+                      const Vec3*   outDirs,
+                      int           numQueries,
+                      float*        spectra) const
+{
+    const int blockSize = 256;
+    const int numWavelengths = brdf_->getSampleSet()->getNumWavelengths();
+
+    Vec3 blockInDirs[blockSize];
+    Vec3 blockOutDirs[blockSize];
+    for (int i = 0; i < numQueries; i += blockSize) {
+        int numBlockQueries = std::min(numQueries - i, blockSize);
+        for (int j = 0; j < numBlockQueries; ++j) {
+            const Vec3& inDir = inDirs[i + j];
+            const Vec3& outDir = outDirs[i + j];
+            blockInDirs[j] = Vec3(inDir[0], inDir[1], std::abs(inDir[2]));
+            blockOutDirs[j] = Vec3(outDir[0], outDir[1], std::abs(outDir[2]));
+        }
+
+        brdf_->getSpectra(blockInDirs, blockOutDirs, numBlockQueries, spectra + i * numWavelengths);
+    }
+}
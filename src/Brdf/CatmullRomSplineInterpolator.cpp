@@ -36,19 +36,19 @@ void CatmullRomSplineInterpolator::getSpectrum(const SampleSet& samples,
     float pos2Angle0, pos2Angle1, pos2Angle2, pos2Angle3;
     float pos3Angle0, pos3Angle1, pos3Angle2, pos3Angle3;
 
-    findBounds(angles0, angle0, samples.isEqualIntervalAngles0(), false,
+    findBounds(angles0, samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), false,
                &pos0Idx0, &pos1Idx0, &pos2Idx0, &pos3Idx0,
                &pos0Angle0, &pos1Angle0, &pos2Angle0, &pos3Angle0);
 
-    findBounds(angles1, angle1, samples.isEqualIntervalAngles1(), true,
+    findBounds(angles1, samples.getAngleLookupTable1(), angle1, samples.isEqualIntervalAngles1(), true,
                &pos0Idx1, &pos1Idx1, &pos2Idx1, &pos3Idx1,
                &pos0Angle1, &pos1Angle1, &pos2Angle1, &pos3Angle1);
 
-    findBounds(angles2, angle2, samples.isEqualIntervalAngles2(), false,
+    findBounds(angles2, samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), false,
                &pos0Idx2, &pos1Idx2, &pos2Idx2, &pos3Idx2,
                &pos0Angle2, &pos1Angle2, &pos2Angle2, &pos3Angle2);
 
-    findBounds(angles3, angle3, samples.isEqualIntervalAngles3(), true,
+    findBounds(angles3, samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), true,
                &pos0Idx3, &pos1Idx3, &pos2Idx3, &pos3Idx3,
                &pos0Angle3, &pos1Angle3, &pos2Angle3, &pos3Angle3);
 
@@ -195,15 +195,15 @@ void CatmullRomSplineInterpolator::getSpectrum(const SampleSet& samples,
     float pos2Angle0, pos2Angle2, pos2Angle3;
     float pos3Angle0, pos3Angle2, pos3Angle3;
 
-    findBounds(angles0, angle0, samples.isEqualIntervalAngles0(), false,
+    findBounds(angles0, samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), false,
                &pos0Idx0, &pos1Idx0, &pos2Idx0, &pos3Idx0,
                &pos0Angle0, &pos1Angle0, &pos2Angle0, &pos3Angle0);
 
-    findBounds(angles2, angle2, samples.isEqualIntervalAngles2(), false,
+    findBounds(angles2, samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), false,
                &pos0Idx2, &pos1Idx2, &pos2Idx2, &pos3Idx2,
                &pos0Angle2, &pos1Angle2, &pos2Angle2, &pos3Angle2);
 
-    findBounds(angles3, angle3, samples.isEqualIntervalAngles3(), true,
+    findBounds(angles3, samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), true,
                &pos0Idx3, &pos1Idx3, &pos2Idx3, &pos3Idx3,
                &pos0Angle3, &pos1Angle3, &pos2Angle3, &pos3Angle3);
 
@@ -240,6 +240,87 @@ void CatmullRomSplineInterpolator::getSpectrum(const SampleSet& samples,
     assert(spectrum->allFinite());
 }
 
+void CatmullRomSplineInterpolator::getSpectrum(const CatmullRomSplineTable& table,
+                                               float                        angle0,
+                                               float                        angle1,
+                                               float                        angle2,
+                                               float                        angle3,
+                                               Spectrum*                    spectrum)
+{
+    const SampleSet& samples = *table.getSampleSet();
+
+    int posIndices0[4], posIndices1[4], posIndices2[4], posIndices3[4];
+    float posAngles0[4], posAngles1[4], posAngles2[4], posAngles3[4];
+
+    findBounds(samples.getAngles0(), samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), false,
+               &posIndices0[0], &posIndices0[1], &posIndices0[2], &posIndices0[3],
+               &posAngles0[0], &posAngles0[1], &posAngles0[2], &posAngles0[3]);
+
+    findBounds(samples.getAngles1(), samples.getAngleLookupTable1(), angle1, samples.isEqualIntervalAngles1(), true,
+               &posIndices1[0], &posIndices1[1], &posIndices1[2], &posIndices1[3],
+               &posAngles1[0], &posAngles1[1], &posAngles1[2], &posAngles1[3]);
+
+    findBounds(samples.getAngles2(), samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), false,
+               &posIndices2[0], &posIndices2[1], &posIndices2[2], &posIndices2[3],
+               &posAngles2[0], &posAngles2[1], &posAngles2[2], &posAngles2[3]);
+
+    findBounds(samples.getAngles3(), samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), true,
+               &posIndices3[0], &posIndices3[1], &posIndices3[2], &posIndices3[3],
+               &posAngles3[0], &posAngles3[1], &posAngles3[2], &posAngles3[3]);
+
+    Spectrum sps0[4];
+    for (int i = 0; i < 4; ++i) {
+        Spectrum sps1[4];
+        for (int j = 0; j < 4; ++j) {
+            sps1[j] = interpolate2D(table, posIndices0[i], posIndices1[j], posIndices2, posAngles2,
+                                    posIndices3[1], angle2, angle3);
+        }
+
+        catmullRomSpline(posAngles1[0], posAngles1[1], posAngles1[2], posAngles1[3],
+                         sps1[0], sps1[1], sps1[2], sps1[3], angle1, &sps0[i]);
+    }
+
+    catmullRomSpline(posAngles0[0], posAngles0[1], posAngles0[2], posAngles0[3],
+                     sps0[0], sps0[1], sps0[2], sps0[3], angle0, spectrum);
+
+    assert(spectrum->allFinite());
+}
+
+void CatmullRomSplineInterpolator::getSpectrum(const CatmullRomSplineTable& table,
+                                               float                        angle0,
+                                               float                        angle2,
+                                               float                        angle3,
+                                               Spectrum*                    spectrum)
+{
+    const SampleSet& samples = *table.getSampleSet();
+
+    int posIndices0[4], posIndices2[4], posIndices3[4];
+    float posAngles0[4], posAngles2[4], posAngles3[4];
+
+    findBounds(samples.getAngles0(), samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), false,
+               &posIndices0[0], &posIndices0[1], &posIndices0[2], &posIndices0[3],
+               &posAngles0[0], &posAngles0[1], &posAngles0[2], &posAngles0[3]);
+
+    findBounds(samples.getAngles2(), samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), false,
+               &posIndices2[0], &posIndices2[1], &posIndices2[2], &posIndices2[3],
+               &posAngles2[0], &posAngles2[1], &posAngles2[2], &posAngles2[3]);
+
+    findBounds(samples.getAngles3(), samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), true,
+               &posIndices3[0], &posIndices3[1], &posIndices3[2], &posIndices3[3],
+               &posAngles3[0], &posAngles3[1], &posAngles3[2], &posAngles3[3]);
+
+    Spectrum sps0[4];
+    for (int i = 0; i < 4; ++i) {
+        sps0[i] = interpolate2D(table, posIndices0[i], 0, posIndices2, posAngles2,
+                                posIndices3[1], angle2, angle3);
+    }
+
+    catmullRomSpline(posAngles0[0], posAngles0[1], posAngles0[2], posAngles0[3],
+                     sps0[0], sps0[1], sps0[2], sps0[3], angle0, spectrum);
+
+    assert(spectrum->allFinite());
+}
+
 float CatmullRomSplineInterpolator::getValue(const SampleSet&   samples,
                                              float              angle0,
                                              float              angle1,
@@ -262,19 +343,19 @@ float CatmullRomSplineInterpolator::getValue(const SampleSet&   samples,
     float pos2Angle0, pos2Angle1, pos2Angle2, pos2Angle3;
     float pos3Angle0, pos3Angle1, pos3Angle2, pos3Angle3;
 
-    findBounds(angles0, angle0, samples.isEqualIntervalAngles0(), false,
+    findBounds(angles0, samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), false,
                &pos0Idx0, &pos1Idx0, &pos2Idx0, &pos3Idx0,
                &pos0Angle0, &pos1Angle0, &pos2Angle0, &pos3Angle0);
 
-    findBounds(angles1, angle1, samples.isEqualIntervalAngles1(), true,
+    findBounds(angles1, samples.getAngleLookupTable1(), angle1, samples.isEqualIntervalAngles1(), true,
                &pos0Idx1, &pos1Idx1, &pos2Idx1, &pos3Idx1,
                &pos0Angle1, &pos1Angle1, &pos2Angle1, &pos3Angle1);
 
-    findBounds(angles2, angle2, samples.isEqualIntervalAngles2(), false,
+    findBounds(angles2, samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), false,
                &pos0Idx2, &pos1Idx2, &pos2Idx2, &pos3Idx2,
                &pos0Angle2, &pos1Angle2, &pos2Angle2, &pos3Angle2);
 
-    findBounds(angles3, angle3, samples.isEqualIntervalAngles3(), true,
+    findBounds(angles3, samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), true,
                &pos0Idx3, &pos1Idx3, &pos2Idx3, &pos3Idx3,
                &pos0Angle3, &pos1Angle3, &pos2Angle3, &pos3Angle3);
 
@@ -421,15 +502,15 @@ float CatmullRomSplineInterpolator::getValue(const SampleSet&   samples,
     float pos2Angle0, pos2Angle2, pos2Angle3;
     float pos3Angle0, pos3Angle2, pos3Angle3;
 
-    findBounds(angles0, angle0, samples.isEqualIntervalAngles0(), false,
+    findBounds(angles0, samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), false,
                &pos0Idx0, &pos1Idx0, &pos2Idx0, &pos3Idx0,
                &pos0Angle0, &pos1Angle0, &pos2Angle0, &pos3Angle0);
 
-    findBounds(angles2, angle2, samples.isEqualIntervalAngles2(), false,
+    findBounds(angles2, samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), false,
                &pos0Idx2, &pos1Idx2, &pos2Idx2, &pos3Idx2,
                &pos0Angle2, &pos1Angle2, &pos2Angle2, &pos3Angle2);
 
-    findBounds(angles3, angle3, samples.isEqualIntervalAngles3(), true,
+    findBounds(angles3, samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), true,
                &pos0Idx3, &pos1Idx3, &pos2Idx3, &pos3Idx3,
                &pos0Angle3, &pos1Angle3, &pos2Angle3, &pos3Angle3);
 
@@ -485,11 +566,11 @@ void CatmullRomSplineInterpolator::getSpectrum(const SampleSet2D&   ss2,
     float pos2Angle0, pos2Angle1;
     float pos3Angle0, pos3Angle1;
 
-    findBounds(thetaArray, theta, ss2.isEqualIntervalTheta(), false,
+    findBounds(thetaArray, ss2.getThetaLookupTable(), theta, ss2.isEqualIntervalTheta(), false,
                &pos0Idx0, &pos1Idx0, &pos2Idx0, &pos3Idx0,
                &pos0Angle0, &pos1Angle0, &pos2Angle0, &pos3Angle0);
 
-    findBounds(phiArray, phi, ss2.isEqualIntervalPhi(), true,
+    findBounds(phiArray, ss2.getPhiLookupTable(), phi, ss2.isEqualIntervalPhi(), true,
                &pos0Idx1, &pos1Idx1, &pos2Idx1, &pos3Idx1,
                &pos0Angle1, &pos1Angle1, &pos2Angle1, &pos3Angle1);
 
@@ -540,7 +621,7 @@ void CatmullRomSplineInterpolator::getSpectrum(const SampleSet2D&   ss2,
     float pos2Angle0;
     float pos3Angle0;
 
-    findBounds(thetaArray, theta, ss2.isEqualIntervalTheta(), false,
+    findBounds(thetaArray, ss2.getThetaLookupTable(), theta, ss2.isEqualIntervalTheta(), false,
                &pos0Idx0, &pos1Idx0, &pos2Idx0, &pos3Idx0,
                &pos0Angle0, &pos1Angle0, &pos2Angle0, &pos3Angle0);
 
@@ -554,21 +635,21 @@ void CatmullRomSplineInterpolator::getSpectrum(const SampleSet2D&   ss2,
     assert(spectrum->allFinite());
 }
 
-void CatmullRomSplineInterpolator::findBounds(const Arrayf& positions,
-                                              float         posAngle,
-                                              bool          equalIntervalPositions,
-                                              bool          repeatBounds,
-                                              int*          pos0Index,
-                                              int*          pos1Index,
-                                              int*          pos2Index,
-                                              int*          pos3Index,
-                                              float*        pos0Angle,
-                                              float*        pos1Angle,
-                                              float*        pos2Angle,
-                                              float*        pos3Angle)
+void CatmullRomSplineInterpolator::findBounds(const Arrayf&           positions,
+                                              const AngleLookupTable& lookupTable,
+                                              float                   posAngle,
+                                              bool                    equalIntervalPositions,
+                                              bool                    repeatBounds,
+                                              int*                    pos0Index,
+                                              int*                    pos1Index,
+                                              int*                    pos2Index,
+                                              int*                    pos3Index,
+                                              float*                  pos0Angle,
+                                              float*                  pos1Angle,
+                                              float*                  pos2Angle,
+                                              float*                  pos3Angle)
 {
     using std::min;
-    using std::max;
 
     if (positions.size() == 1) {
         *pos0Index = 0;
@@ -592,40 +673,65 @@ void CatmullRomSplineInterpolator::findBounds(const Arrayf& positions,
     }
     else {
         // Find lower and upper indices.
-        const float* anglePtr = std::lower_bound(&positions[0], &positions[0] + positions.size(), posAngle);
-        *pos2Index = clamp(static_cast<int>(anglePtr - &positions[0]), 1, backIndex);
+        *pos2Index = clamp(lookupTable.findLowerBound(positions, posAngle), 1, backIndex);
         *pos1Index = *pos2Index - 1;
     }
 
     *pos1Angle = positions[*pos1Index];
     *pos2Angle = positions[*pos2Index];
 
+    findOuterBounds(positions, repeatBounds, *pos1Index, *pos2Index,
+                    pos0Index, pos3Index, pos0Angle, pos3Angle);
+}
+
+void CatmullRomSplineInterpolator::findOuterBounds(const Arrayf&    positions,
+                                                   bool             repeatBounds,
+                                                   int              pos1Index,
+                                                   int              pos2Index,
+                                                   int*             pos0Index,
+                                                   int*             pos3Index,
+                                                   float*           pos0Angle,
+                                                   float*           pos3Angle)
+{
+    using std::min;
+    using std::max;
+
+    int backIndex = static_cast<int>(positions.size() - 1);
+    if (backIndex == 0) {
+        *pos0Index = 0;
+        *pos3Index = 0;
+        *pos0Angle = positions[0];
+        *pos3Angle = positions[0];
+
+        return;
+    }
+
     if (repeatBounds) {
-        if (*pos1Index == 0) {
+        if (pos1Index == 0) {
             *pos0Index = backIndex - 1;
             *pos0Angle = positions[*pos0Index] - positions[backIndex];
         }
         else {
-            *pos0Index = *pos1Index - 1;
+            *pos0Index = pos1Index - 1;
             *pos0Angle = positions[*pos0Index];
         }
 
-        if (*pos2Index == backIndex) {
+        if (pos2Index == backIndex) {
             *pos3Index = 1;
             *pos3Angle = positions[*pos3Index] + positions[backIndex];
         }
         else {
-            *pos3Index = *pos2Index + 1;
+            *pos3Index = pos2Index + 1;
             *pos3Angle = positions[*pos3Index];
         }
     }
     else {
-        *pos0Index = max(*pos1Index - 1, 0);
-        *pos3Index = min(*pos2Index + 1, backIndex);
+        *pos0Index = max(pos1Index - 1, 0);
+        *pos3Index = min(pos2Index + 1, backIndex);
 
         *pos0Angle = positions[*pos0Index];
         *pos3Angle = positions[*pos3Index];
-    }   
+    }
 }
 
 Spectrum CatmullRomSplineInterpolator::interpolate2D(const SampleSet&   samples,
@@ -650,25 +756,28 @@ Spectrum CatmullRomSplineInterpolator::interpolate2D(const SampleSet&   samples,
                                                      float              angle2,
                                                      float              angle3)
 {
-    const Spectrum& sp00 = samples.getSpectrum(index0, index1, pos0Index2, pos0Index3);
-    const Spectrum& sp01 = samples.getSpectrum(index0, index1, pos0Index2, pos1Index3);
-    const Spectrum& sp02 = samples.getSpectrum(index0, index1, pos0Index2, pos2Index3);
-    const Spectrum& sp03 = samples.getSpectrum(index0, index1, pos0Index2, pos3Index3);
-
-    const Spectrum& sp10 = samples.getSpectrum(index0, index1, pos1Index2, pos0Index3);
-    const Spectrum& sp11 = samples.getSpectrum(index0, index1, pos1Index2, pos1Index3);
-    const Spectrum& sp12 = samples.getSpectrum(index0, index1, pos1Index2, pos2Index3);
-    const Spectrum& sp13 = samples.getSpectrum(index0, index1, pos1Index2, pos3Index3);
-
-    const Spectrum& sp20 = samples.getSpectrum(index0, index1, pos2Index2, pos0Index3);
-    const Spectrum& sp21 = samples.getSpectrum(index0, index1, pos2Index2, pos1Index3);
-    const Spectrum& sp22 = samples.getSpectrum(index0, index1, pos2Index2, pos2Index3);
-    const Spectrum& sp23 = samples.getSpectrum(index0, index1, pos2Index2, pos3Index3);
-
-    const Spectrum& sp30 = samples.getSpectrum(index0, index1, pos3Index2, pos0Index3);
-    const Spectrum& sp31 = samples.getSpectrum(index0, index1, pos3Index2, pos1Index3);
-    const Spectrum& sp32 = samples.getSpectrum(index0, index1, pos3Index2, pos2Index3);
-    const Spectrum& sp33 = samples.getSpectrum(index0, index1, pos3Index2, pos3Index3);
+    Spectrum sp00, sp01, sp02, sp03, sp10, sp11, sp12, sp13,
+             sp20, sp21, sp22, sp23, sp30, sp31, sp32, sp33;
+
+    samples.getSpectrum(samples.getIndex(index0, index1, pos0Index2, pos0Index3), &sp00);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos0Index2, pos1Index3), &sp01);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos0Index2, pos2Index3), &sp02);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos0Index2, pos3Index3), &sp03);
+
+    samples.getSpectrum(samples.getIndex(index0, index1, pos1Index2, pos0Index3), &sp10);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos1Index2, pos1Index3), &sp11);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos1Index2, pos2Index3), &sp12);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos1Index2, pos3Index3), &sp13);
+
+    samples.getSpectrum(samples.getIndex(index0, index1, pos2Index2, pos0Index3), &sp20);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos2Index2, pos1Index3), &sp21);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos2Index2, pos2Index3), &sp22);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos2Index2, pos3Index3), &sp23);
+
+    samples.getSpectrum(samples.getIndex(index0, index1, pos3Index2, pos0Index3), &sp30);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos3Index2, pos1Index3), &sp31);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos3Index2, pos2Index3), &sp32);
+    samples.getSpectrum(samples.getIndex(index0, index1, pos3Index2, pos3Index3), &sp33);
 
     Spectrum sp0, sp1, sp2, sp3;
     catmullRomSpline(pos0Angle3, pos1Angle3, pos2Angle3, pos3Angle3, sp00, sp01, sp02, sp03, angle3, &sp0);
@@ -681,6 +790,32 @@ Spectrum CatmullRomSplineInterpolator::interpolate2D(const SampleSet&   samples,
     return sp;
 }
 
+Spectrum CatmullRomSplineInterpolator::interpolate2D(const CatmullRomSplineTable&   table,
+                                                     int                            index0,
+                                                     int                            index1,
+                                                     const int*                     posIndices2,
+                                                     const float*                   posAngles2,
+                                                     int                            index3,
+                                                     float                          angle2,
+                                                     float                          angle3)
+{
+    const int numWavelengths = table.getSampleSet()->getNumWavelengths();
+
+    // Splines along angle3 are evaluated with baked coefficients.
+    Spectrum sps[4];
+    for (int i = 0; i < 4; ++i) {
+        sps[i].resize(numWavelengths);
+        for (int j = 0; j < numWavelengths; ++j) {
+            sps[i][j] = table.interpolate(index0, index1, posIndices2[i], index3, j, angle3);
+        }
+    }
+
+    Spectrum sp;
+    catmullRomSpline(posAngles2[0], posAngles2[1], posAngles2[2], posAngles2[3],
+                     sps[0], sps[1], sps[2], sps[3], angle2, &sp);
+    return sp;
+}
+
 float CatmullRomSplineInterpolator::interpolate2D(const SampleSet&  samples,
                                                   int               index0,
                                                   int               index1,
@@ -704,25 +839,25 @@ float CatmullRomSplineInterpolator::interpolate2D(const SampleSet&  samples,
                                                   float             angle3,
                                                   int               wavelengthIndex)
 {
-    float v00 = samples.getSpectrum(index0, index1, pos0Index2, pos0Index3)[wavelengthIndex];
-    float v01 = samples.getSpectrum(index0, index1, pos0Index2, pos1Index3)[wavelengthIndex];
-    float v02 = samples.getSpectrum(index0, index1, pos0Index2, pos2Index3)[wavelengthIndex];
-    float v03 = samples.getSpectrum(index0, index1, pos0Index2, pos3Index3)[wavelengthIndex];
-
-    float v10 = samples.getSpectrum(index0, index1, pos1Index2, pos0Index3)[wavelengthIndex];
-    float v11 = samples.getSpectrum(index0, index1, pos1Index2, pos1Index3)[wavelengthIndex];
-    float v12 = samples.getSpectrum(index0, index1, pos1Index2, pos2Index3)[wavelengthIndex];
-    float v13 = samples.getSpectrum(index0, index1, pos1Index2, pos3Index3)[wavelengthIndex];
-
-    float v20 = samples.getSpectrum(index0, index1, pos2Index2, pos0Index3)[wavelengthIndex];
-    float v21 = samples.getSpectrum(index0, index1, pos2Index2, pos1Index3)[wavelengthIndex];
-    float v22 = samples.getSpectrum(index0, index1, pos2Index2, pos2Index3)[wavelengthIndex];
-    float v23 = samples.getSpectrum(index0, index1, pos2Index2, pos3Index3)[wavelengthIndex];
-
-    float v30 = samples.getSpectrum(index0, index1, pos3Index2, pos0Index3)[wavelengthIndex];
-    float v31 = samples.getSpectrum(index0, index1, pos3Index2, pos1Index3)[wavelengthIndex];
-    float v32 = samples.getSpectrum(index0, index1, pos3Index2, pos2Index3)[wavelengthIndex];
-    float v33 = samples.getSpectrum(index0, index1, pos3Index2, pos3Index3)[wavelengthIndex];
+    float v00 = samples.getValue(samples.getIndex(index0, index1, pos0Index2, pos0Index3), wavelengthIndex);
+    float v01 = samples.getValue(samples.getIndex(index0, index1, pos0Index2, pos1Index3), wavelengthIndex);
+    float v02 = samples.getValue(samples.getIndex(index0, index1, pos0Index2, pos2Index3), wavelengthIndex);
+    float v03 = samples.getValue(samples.getIndex(index0, index1, pos0Index2, pos3Index3), wavelengthIndex);
+
+    float v10 = samples.getValue(samples.getIndex(index0, index1, pos1Index2, pos0Index3), wavelengthIndex);
+    float v11 = samples.getValue(samples.getIndex(index0, index1, pos1Index2, pos1Index3), wavelengthIndex);
+    float v12 = samples.getValue(samples.getIndex(index0, index1, pos1Index2, pos2Index3), wavelengthIndex);
+    float v13 = samples.getValue(samples.getIndex(index0, index1, pos1Index2, pos3Index3), wavelengthIndex);
+
+    float v20 = samples.getValue(samples.getIndex(index0, index1, pos2Index2, pos0Index3), wavelengthIndex);
+    float v21 = samples.getValue(samples.getIndex(index0, index1, pos2Index2, pos1Index3), wavelengthIndex);
+    float v22 = samples.getValue(samples.getIndex(index0, index1, pos2Index2, pos2Index3), wavelengthIndex);
+    float v23 = samples.getValue(samples.getIndex(index0, index1, pos2Index2, pos3Index3), wavelengthIndex);
+
+    float v30 = samples.getValue(samples.getIndex(index0, index1, pos3Index2, pos0Index3), wavelengthIndex);
+    float v31 = samples.getValue(samples.getIndex(index0, index1, pos3Index2, pos1Index3), wavelengthIndex);
+    float v32 = samples.getValue(samples.getIndex(index0, index1, pos3Index2, pos2Index3), wavelengthIndex);
+    float v33 = samples.getValue(samples.getIndex(index0, index1, pos3Index2, pos3Index3), wavelengthIndex);
 
     float v0 = catmullRomSpline(pos0Angle3, pos1Angle3, pos2Angle3, pos3Angle3, v00, v01, v02, v03, angle3);
     float v1 = catmullRomSpline(pos0Angle3, pos1Angle3, pos2Angle3, pos3Angle3, v10, v11, v12, v13, angle3);
@@ -0,0 +1,99 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Brdf/CatmullRomSplineTable.h>
+
+#include <libbsdf/Brdf/CatmullRomSplineInterpolator.h>
+
+using namespace lb;
+
+CatmullRomSplineTable::CatmullRomSplineTable() : samples_(0),
+                                                 numAngles0_(0),
+                                                 numAngles1_(0),
+                                                 numAngles2_(0),
+                                                 numAngles3_(0),
+                                                 numWavelengths_(0),
+                                                 numCells3_(0) {}
+
+CatmullRomSplineTable::CatmullRomSplineTable(const SampleSet& samples) : samples_(0),
+                                                                         numAngles0_(0),
+                                                                         numAngles1_(0),
+                                                                         numAngles2_(0),
+                                                                         numAngles3_(0),
+                                                                         numWavelengths_(0),
+                                                                         numCells3_(0)
+{
+    build(samples);
+}
+
+void CatmullRomSplineTable::build(const SampleSet& samples)
+{
+    samples_ = &samples;
+
+    numAngles0_ = samples.getNumAngles0();
+    numAngles1_ = samples.getNumAngles1();
+    numAngles2_ = samples.getNumAngles2();
+    numAngles3_ = samples.getNumAngles3();
+    numWavelengths_ = samples.getNumWavelengths();
+
+    const Arrayf& angles3 = samples.getAngles3();
+
+    numCells3_ = (numAngles3_ > 1) ? numAngles3_ - 1 : 1;
+    tangents_.resize(static_cast<Arrayf::Index>(numAngles0_) * numAngles1_ * numAngles2_ *
+                     numCells3_ * numWavelengths_ * 4);
+
+    #pragma omp parallel for
+    for (int cell = 0; cell < numCells3_; ++cell) {
+        int pos1Index = cell;
+        int pos2Index = (numAngles3_ > 1) ? cell + 1 : cell;
+
+        int pos0Index, pos3Index;
+        float pos0Angle, pos3Angle;
+        CatmullRomSplineInterpolator::findOuterBounds(angles3, true, pos1Index, pos2Index,
+                                                      &pos0Index, &pos3Index, &pos0Angle, &pos3Angle);
+
+        float pos1Angle = angles3[pos1Index];
+        float pos2Angle = angles3[pos2Index];
+
+        Spectrum sp0, sp1, sp2, sp3;
+        Vec2 tan1, tan2;
+
+        for (int i0 = 0; i0 < samples.getNumAngles0(); ++i0) {
+        for (int i1 = 0; i1 < samples.getNumAngles1(); ++i1) {
+        for (int i2 = 0; i2 < samples.getNumAngles2(); ++i2) {
+            samples.getSpectrum(samples.getIndex(i0, i1, i2, pos0Index), &sp0);
+            samples.getSpectrum(samples.getIndex(i0, i1, i2, pos1Index), &sp1);
+            samples.getSpectrum(samples.getIndex(i0, i1, i2, pos2Index), &sp2);
+            samples.getSpectrum(samples.getIndex(i0, i1, i2, pos3Index), &sp3);
+
+            float* t = &tangents_[getOffset(i0, i1, i2, cell)];
+            for (int i = 0; i < numWavelengths_; ++i, t += 4) {
+                CentripetalCatmullRomSpline::computeTangents(Vec2(pos0Angle, sp0[i]),
+                                                             Vec2(pos1Angle, sp1[i]),
+                                                             Vec2(pos2Angle, sp2[i]),
+                                                             Vec2(pos3Angle, sp3[i]),
+                                                             &tan1, &tan2);
+
+                t[0] = static_cast<float>(tan1[0]); t[1] = static_cast<float>(tan1[1]);
+                t[2] = static_cast<float>(tan2[0]); t[3] = static_cast<float>(tan2[1]);
+            }
+        }}}
+    }
+}
+
+void CatmullRomSplineTable::clear()
+{
+    samples_ = 0;
+    numAngles0_ = 0;
+    numAngles1_ = 0;
+    numAngles2_ = 0;
+    numAngles3_ = 0;
+    numWavelengths_ = 0;
+    numCells3_ = 0;
+    tangents_.resize(0);
+}
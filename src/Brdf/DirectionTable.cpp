@@ -0,0 +1,36 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Brdf/DirectionTable.h>
+
+#include <libbsdf/Brdf/Brdf.h>
+
+using namespace lb;
+
+DirectionTable::DirectionTable(const Brdf& brdf) : brdf_(brdf) {}
+
+DirectionTable::~DirectionTable() {}
+
+void DirectionTable::getInOutDirection(int index0, int index1, int index2, int index3,
+                                       Vec3* inDir, Vec3* outDir) const
+{
+    brdf_.getInOutDirection(index0, index1, index2, index3, inDir, outDir);
+}
+
+void DirectionTable::getInOutDirections(int index0, int index1,
+                                        Vec3* inDirs, Vec3* outDirs) const
+{
+    const SampleSet* ss = brdf_.getSampleSet();
+
+    const int numAngles3 = ss->getNumAngles3();
+    for (int i2 = 0; i2 < ss->getNumAngles2(); ++i2) {
+    for (int i3 = 0; i3 < numAngles3; ++i3) {
+        int index = i3 + numAngles3 * i2;
+        getInOutDirection(index0, index1, i2, i3, &inDirs[index], &outDirs[index]);
+    }}
+}
@@ -50,6 +50,15 @@ HalfDifferenceCoordinatesBrdf::HalfDifferenceCoordinatesBrdf(const Brdf&    brdf
 HalfDifferenceCoordinatesBrdf::HalfDifferenceCoordinatesBrdf(const HalfDifferenceCoordinatesBrdf& brdf)
                                                              : BaseBrdf(brdf) {}
 
+HalfDifferenceCoordinatesBrdf::HalfDifferenceCoordinatesBrdf(HalfDifferenceCoordinatesBrdf&& brdf)
+                                                             : BaseBrdf(std::move(brdf)) {}
+
+HalfDifferenceCoordinatesBrdf& HalfDifferenceCoordinatesBrdf::operator=(HalfDifferenceCoordinatesBrdf&& brdf)
+{
+    BaseBrdf::operator=(std::move(brdf));
+    return *this;
+}
+
 HalfDifferenceCoordinatesBrdf::~HalfDifferenceCoordinatesBrdf() {}
 
 HalfDifferenceCoordinatesBrdf* HalfDifferenceCoordinatesBrdf::clone() const
@@ -22,16 +22,23 @@ Integrator::Integrator(int numSampling, bool usePoissonDiskDistribution) : numSa
 
 Spectrum Integrator::computeReflectance(const Brdf& brdf, const Vec3& inDir)
 {
+    const int numWavelengths = brdf.getSampleSet()->getNumWavelengths();
+
     Arrayd sumSpectrum;
-    sumSpectrum.resize(brdf.getSampleSet()->getNumWavelengths());
+    sumSpectrum.resize(numWavelengths);
     sumSpectrum.setZero();
 
+    // The slice is shared by threads and each thread has a lookup context.
+    std::unique_ptr<BrdfSlice> slice = brdf.bindIncoming(inDir);
+
     Vec3 outDir;
     Spectrum sp;
-    #pragma omp parallel for private(outDir, sp)
+    LookupContext context;
+    #pragma omp parallel for private(outDir, sp, context)
     for (int i = 0; i < numSampling_; ++i) {
         outDir = outDirs_.col(i);
-        sp = brdf.getSpectrum(inDir, outDir);
+        sp.resize(numWavelengths);
+        slice->getSpectrum(outDir, &context, sp.data());
         sp *= outDir.z();
 
         #pragma omp critical
@@ -44,16 +51,23 @@ Spectrum Integrator::computeReflectance(const Brdf& brdf, const Vec3& inDir)
 
 Spectrum Integrator::computeReflectance(const Brdf& brdf, const Vec3& inDir, int numSampling)
 {
+    const int numWavelengths = brdf.getSampleSet()->getNumWavelengths();
+
     Arrayd sumSpectrum;
-    sumSpectrum.resize(brdf.getSampleSet()->getNumWavelengths());
+    sumSpectrum.resize(numWavelengths);
     sumSpectrum.setZero();
 
+    // The slice is shared by threads and each thread has a lookup context.
+    std::unique_ptr<BrdfSlice> slice = brdf.bindIncoming(inDir);
+
     Vec3 outDir;
     Spectrum sp;
-    #pragma omp parallel for private(outDir, sp)
+    LookupContext context;
+    #pragma omp parallel for private(outDir, sp, context)
     for (int i = 0; i < numSampling; ++i) {
         outDir = Xorshift::randomOnHemisphere<Vec3>();
-        sp = brdf.getSpectrum(inDir, outDir);
+        sp.resize(numWavelengths);
+        slice->getSpectrum(outDir, &context, sp.data());
         sp *= outDir.z();
 
         #pragma omp critical
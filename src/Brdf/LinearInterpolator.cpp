@@ -21,62 +21,61 @@ void LinearInterpolator::getSpectrum(const SampleSet&   samples,
                                      float              angle3,
                                      Spectrum*          spectrum)
 {
-    const Arrayf& angles0 = samples.getAngles0();
-    const Arrayf& angles1 = samples.getAngles1();
-    const Arrayf& angles2 = samples.getAngles2();
-    const Arrayf& angles3 = samples.getAngles3();
+    spectrum->resize(samples.getNumWavelengths());
+    getSpectrum(samples, angle0, angle1, angle2, angle3, spectrum->data());
 
-    int lIdx0, lIdx1, lIdx2, lIdx3; // index of the lower bound sample point
-    int uIdx0, uIdx1, uIdx2, uIdx3; // index of the upper bound sample point
-    Vec4 lowerAngles, upperAngles;
+    assert(spectrum->allFinite());
+}
+
+void LinearInterpolator::getSpectrum(const SampleSet&   samples,
+                                     float              angle0,
+                                     float              angle2,
+                                     float              angle3,
+                                     Spectrum*          spectrum)
+{
+    spectrum->resize(samples.getNumWavelengths());
+    getSpectrum(samples, angle0, angle2, angle3, spectrum->data());
 
-    findBounds(angles0, angle0, samples.isEqualIntervalAngles0(), &lIdx0, &uIdx0, &lowerAngles[0], &upperAngles[0]);
-    findBounds(angles1, angle1, samples.isEqualIntervalAngles1(), &lIdx1, &uIdx1, &lowerAngles[1], &upperAngles[1]);
-    findBounds(angles2, angle2, samples.isEqualIntervalAngles2(), &lIdx2, &uIdx2, &lowerAngles[2], &upperAngles[2]);
-    findBounds(angles3, angle3, samples.isEqualIntervalAngles3(), &lIdx3, &uIdx3, &lowerAngles[3], &upperAngles[3]);
+    assert(spectrum->allFinite());
+}
 
-    Vec4 angles(angle0, angle1, angle2, angle3);
-    Vec4 intervals = (upperAngles - lowerAngles).cwiseMax(EPSILON_F);
-    Vec4 weights = (angles - lowerAngles).cwiseQuotient(intervals);
-
-    const Spectrum& sp0000 = samples.getSpectrum(lIdx0, lIdx1, lIdx2, lIdx3);
-    const Spectrum& sp0001 = samples.getSpectrum(lIdx0, lIdx1, lIdx2, uIdx3);
-    const Spectrum& sp0010 = samples.getSpectrum(lIdx0, lIdx1, uIdx2, lIdx3);
-    const Spectrum& sp0011 = samples.getSpectrum(lIdx0, lIdx1, uIdx2, uIdx3);
-
-    const Spectrum& sp0100 = samples.getSpectrum(lIdx0, uIdx1, lIdx2, lIdx3);
-    const Spectrum& sp0101 = samples.getSpectrum(lIdx0, uIdx1, lIdx2, uIdx3);
-    const Spectrum& sp0110 = samples.getSpectrum(lIdx0, uIdx1, uIdx2, lIdx3);
-    const Spectrum& sp0111 = samples.getSpectrum(lIdx0, uIdx1, uIdx2, uIdx3);
-
-    const Spectrum& sp1000 = samples.getSpectrum(uIdx0, lIdx1, lIdx2, lIdx3);
-    const Spectrum& sp1001 = samples.getSpectrum(uIdx0, lIdx1, lIdx2, uIdx3);
-    const Spectrum& sp1010 = samples.getSpectrum(uIdx0, lIdx1, uIdx2, lIdx3);
-    const Spectrum& sp1011 = samples.getSpectrum(uIdx0, lIdx1, uIdx2, uIdx3);
-
-    const Spectrum& sp1100 = samples.getSpectrum(uIdx0, uIdx1, lIdx2, lIdx3);
-    const Spectrum& sp1101 = samples.getSpectrum(uIdx0, uIdx1, lIdx2, uIdx3);
-    const Spectrum& sp1110 = samples.getSpectrum(uIdx0, uIdx1, uIdx2, lIdx3);
-    const Spectrum& sp1111 = samples.getSpectrum(uIdx0, uIdx1, uIdx2, uIdx3);
-
-    Spectrum sp000 = lerp(sp0000, sp0001, weights[3]);
-    Spectrum sp001 = lerp(sp0010, sp0011, weights[3]);
-    Spectrum sp010 = lerp(sp0100, sp0101, weights[3]);
-    Spectrum sp011 = lerp(sp0110, sp0111, weights[3]);
-    Spectrum sp100 = lerp(sp1000, sp1001, weights[3]);
-    Spectrum sp101 = lerp(sp1010, sp1011, weights[3]);
-    Spectrum sp110 = lerp(sp1100, sp1101, weights[3]);
-    Spectrum sp111 = lerp(sp1110, sp1111, weights[3]);
-
-    Spectrum sp00 = lerp(sp000, sp001, weights[2]);
-    Spectrum sp01 = lerp(sp010, sp011, weights[2]);
-    Spectrum sp10 = lerp(sp100, sp101, weights[2]);
-    Spectrum sp11 = lerp(sp110, sp111, weights[2]);
-
-    Spectrum sp0 = lerp(sp00, sp01, weights[1]);
-    Spectrum sp1 = lerp(sp10, sp11, weights[1]);
-
-    *spectrum = lerp(sp0, sp1, weights[0]);
+void LinearInterpolator::getSpectrum(const SampleSet&   samples,
+                                     float              angle0,
+                                     float              angle1,
+                                     float              angle2,
+                                     float              angle3,
+                                     float*             spectrum)
+{
+    int indices[16];
+    float weights[16];
+    findSamples(samples, angle0, angle1, angle2, angle3, indices, weights);
+
+    sumSpectra(samples, indices, weights, 16, spectrum);
+}
+
+void LinearInterpolator::getSpectrum(const SampleSet&   samples,
+                                     float              angle0,
+                                     float              angle2,
+                                     float              angle3,
+                                     float*             spectrum)
+{
+    int indices[8];
+    float weights[8];
+    findSamples(samples, angle0, angle2, angle3, indices, weights);
+
+    sumSpectra(samples, indices, weights, 8, spectrum);
+}
+
+void LinearInterpolator::getSpectrum(const SampleSet&   samples,
+                                     float              angle0,
+                                     float              angle1,
+                                     float              angle2,
+                                     float              angle3,
+                                     LookupContext*     context,
+                                     Spectrum*          spectrum)
+{
+    spectrum->resize(samples.getNumWavelengths());
+    getSpectrum(samples, angle0, angle1, angle2, angle3, context, spectrum->data());
 
     assert(spectrum->allFinite());
 }
@@ -85,45 +84,84 @@ void LinearInterpolator::getSpectrum(const SampleSet&   samples,
                                      float              angle0,
                                      float              angle2,
                                      float              angle3,
+                                     LookupContext*     context,
                                      Spectrum*          spectrum)
 {
-    const Arrayf& angles0 = samples.getAngles0();
-    const Arrayf& angles2 = samples.getAngles2();
-    const Arrayf& angles3 = samples.getAngles3();
+    spectrum->resize(samples.getNumWavelengths());
+    getSpectrum(samples, angle0, angle2, angle3, context, spectrum->data());
 
-    int lIdx0, lIdx2, lIdx3; // index of the lower bound sample point
-    int uIdx0, uIdx2, uIdx3; // index of the upper bound sample point
-    Vec4 lowerAngles, upperAngles;
+    assert(spectrum->allFinite());
+}
 
-    findBounds(angles0, angle0, samples.isEqualIntervalAngles0(), &lIdx0, &uIdx0, &lowerAngles[0], &upperAngles[0]);
-    findBounds(angles2, angle2, samples.isEqualIntervalAngles2(), &lIdx2, &uIdx2, &lowerAngles[2], &upperAngles[2]);
-    findBounds(angles3, angle3, samples.isEqualIntervalAngles3(), &lIdx3, &uIdx3, &lowerAngles[3], &upperAngles[3]);
+void LinearInterpolator::getSpectrum(const SampleSet&   samples,
+                                     float              angle0,
+                                     float              angle1,
+                                     float              angle2,
+                                     float              angle3,
+                                     LookupContext*     context,
+                                     float*             spectrum)
+{
+    const bool cached = (context->samples_ == &samples && !context->isotropic_);
 
-    Vec4 angles(angle0, 0.0, angle2, angle3);
-    Vec4 intervals = (upperAngles - lowerAngles).cwiseMax(EPSILON_F);
-    Vec4 weights = (angles - lowerAngles).cwiseQuotient(intervals);
+    int* l = context->lowerIndices_;
+    int* u = context->upperIndices_;
+    float* la = context->lowerAngles_;
+    float* ua = context->upperAngles_;
 
-    const Spectrum& sp0000 = samples.getSpectrum(lIdx0, lIdx2, lIdx3);
-    const Spectrum& sp0001 = samples.getSpectrum(lIdx0, lIdx2, uIdx3);
-    const Spectrum& sp0010 = samples.getSpectrum(lIdx0, uIdx2, lIdx3);
-    const Spectrum& sp0011 = samples.getSpectrum(lIdx0, uIdx2, uIdx3);
+    bool moved = !cached;
+    moved |= findCachedBounds(samples.getAngles0(), samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), cached, &l[0], &u[0], &la[0], &ua[0]);
+    moved |= findCachedBounds(samples.getAngles1(), samples.getAngleLookupTable1(), angle1, samples.isEqualIntervalAngles1(), cached, &l[1], &u[1], &la[1], &ua[1]);
+    moved |= findCachedBounds(samples.getAngles2(), samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), cached, &l[2], &u[2], &la[2], &ua[2]);
+    moved |= findCachedBounds(samples.getAngles3(), samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), cached, &l[3], &u[3], &la[3], &ua[3]);
 
-    const Spectrum& sp1000 = samples.getSpectrum(uIdx0, lIdx2, lIdx3);
-    const Spectrum& sp1001 = samples.getSpectrum(uIdx0, lIdx2, uIdx3);
-    const Spectrum& sp1010 = samples.getSpectrum(uIdx0, uIdx2, lIdx3);
-    const Spectrum& sp1011 = samples.getSpectrum(uIdx0, uIdx2, uIdx3);
+    if (moved) {
+        findCornerIndices(samples, l, u, false, context->indices_);
+    }
 
-    Spectrum sp000 = lerp(sp0000, sp0001, weights[3]);
-    Spectrum sp001 = lerp(sp0010, sp0011, weights[3]);
-    Spectrum sp100 = lerp(sp1000, sp1001, weights[3]);
-    Spectrum sp101 = lerp(sp1010, sp1011, weights[3]);
+    context->samples_ = &samples;
+    context->isotropic_ = false;
 
-    Spectrum sp00 = lerp(sp000, sp001, weights[2]);
-    Spectrum sp10 = lerp(sp100, sp101, weights[2]);
+    float weights[16];
+    computeCornerWeights(Vec4(angle0, angle1, angle2, angle3), Vec4(la[0], la[1], la[2], la[3]), Vec4(ua[0], ua[1], ua[2], ua[3]),
+                         l, u, false, weights);
 
-    *spectrum = lerp(sp00, sp10, weights[0]);
+    sumSpectra(samples, context->indices_, weights, 16, spectrum);
+}
 
-    assert(spectrum->allFinite());
+void LinearInterpolator::getSpectrum(const SampleSet&   samples,
+                                     float              angle0,
+                                     float              angle2,
+                                     float              angle3,
+                                     LookupContext*     context,
+                                     float*             spectrum)
+{
+    const bool cached = (context->samples_ == &samples && context->isotropic_);
+
+    int* l = context->lowerIndices_;
+    int* u = context->upperIndices_;
+    float* la = context->lowerAngles_;
+    float* ua = context->upperAngles_;
+
+    bool moved = !cached;
+    moved |= findCachedBounds(samples.getAngles0(), samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), cached, &l[0], &u[0], &la[0], &ua[0]);
+    moved |= findCachedBounds(samples.getAngles2(), samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), cached, &l[2], &u[2], &la[2], &ua[2]);
+    moved |= findCachedBounds(samples.getAngles3(), samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), cached, &l[3], &u[3], &la[3], &ua[3]);
+
+    l[1] = u[1] = 0;
+    la[1] = ua[1] = 0.0f;
+
+    if (moved) {
+        findCornerIndices(samples, l, u, true, context->indices_);
+    }
+
+    context->samples_ = &samples;
+    context->isotropic_ = true;
+
+    float weights[8];
+    computeCornerWeights(Vec4(angle0, 0.0, angle2, angle3), Vec4(la[0], la[1], la[2], la[3]), Vec4(ua[0], ua[1], ua[2], ua[3]),
+                         l, u, true, weights);
+
+    sumSpectra(samples, context->indices_, weights, 8, spectrum);
 }
 
 float LinearInterpolator::getValue(const SampleSet& samples,
@@ -133,62 +171,11 @@ float LinearInterpolator::getValue(const SampleSet& samples,
                                    float            angle3,
                                    int              wavelengthIndex)
 {
-    const Arrayf& angles0 = samples.getAngles0();
-    const Arrayf& angles1 = samples.getAngles1();
-    const Arrayf& angles2 = samples.getAngles2();
-    const Arrayf& angles3 = samples.getAngles3();
-
-    int lIdx0, lIdx1, lIdx2, lIdx3; // index of the lower bound sample point
-    int uIdx0, uIdx1, uIdx2, uIdx3; // index of the upper bound sample point
-    Vec4 lowerAngles, upperAngles;
-
-    findBounds(angles0, angle0, samples.isEqualIntervalAngles0(), &lIdx0, &uIdx0, &lowerAngles[0], &upperAngles[0]);
-    findBounds(angles1, angle1, samples.isEqualIntervalAngles1(), &lIdx1, &uIdx1, &lowerAngles[1], &upperAngles[1]);
-    findBounds(angles2, angle2, samples.isEqualIntervalAngles2(), &lIdx2, &uIdx2, &lowerAngles[2], &upperAngles[2]);
-    findBounds(angles3, angle3, samples.isEqualIntervalAngles3(), &lIdx3, &uIdx3, &lowerAngles[3], &upperAngles[3]);
+    int indices[16];
+    float weights[16];
+    findSamples(samples, angle0, angle1, angle2, angle3, indices, weights);
 
-    Vec4 angles(angle0, angle1, angle2, angle3);
-    Vec4 intervals = (upperAngles - lowerAngles).cwiseMax(EPSILON_F);
-    Vec4 weights = (angles - lowerAngles).cwiseQuotient(intervals);
-
-    float val0000 = samples.getSpectrum(lIdx0, lIdx1, lIdx2, lIdx3)[wavelengthIndex];
-    float val0001 = samples.getSpectrum(lIdx0, lIdx1, lIdx2, uIdx3)[wavelengthIndex];
-    float val0010 = samples.getSpectrum(lIdx0, lIdx1, uIdx2, lIdx3)[wavelengthIndex];
-    float val0011 = samples.getSpectrum(lIdx0, lIdx1, uIdx2, uIdx3)[wavelengthIndex];
-
-    float val0100 = samples.getSpectrum(lIdx0, uIdx1, lIdx2, lIdx3)[wavelengthIndex];
-    float val0101 = samples.getSpectrum(lIdx0, uIdx1, lIdx2, uIdx3)[wavelengthIndex];
-    float val0110 = samples.getSpectrum(lIdx0, uIdx1, uIdx2, lIdx3)[wavelengthIndex];
-    float val0111 = samples.getSpectrum(lIdx0, uIdx1, uIdx2, uIdx3)[wavelengthIndex];
-
-    float val1000 = samples.getSpectrum(uIdx0, lIdx1, lIdx2, lIdx3)[wavelengthIndex];
-    float val1001 = samples.getSpectrum(uIdx0, lIdx1, lIdx2, uIdx3)[wavelengthIndex];
-    float val1010 = samples.getSpectrum(uIdx0, lIdx1, uIdx2, lIdx3)[wavelengthIndex];
-    float val1011 = samples.getSpectrum(uIdx0, lIdx1, uIdx2, uIdx3)[wavelengthIndex];
-
-    float val1100 = samples.getSpectrum(uIdx0, uIdx1, lIdx2, lIdx3)[wavelengthIndex];
-    float val1101 = samples.getSpectrum(uIdx0, uIdx1, lIdx2, uIdx3)[wavelengthIndex];
-    float val1110 = samples.getSpectrum(uIdx0, uIdx1, uIdx2, lIdx3)[wavelengthIndex];
-    float val1111 = samples.getSpectrum(uIdx0, uIdx1, uIdx2, uIdx3)[wavelengthIndex];
-
-    float val000 = lerp(val0000, val0001, weights[3]);
-    float val001 = lerp(val0010, val0011, weights[3]);
-    float val010 = lerp(val0100, val0101, weights[3]);
-    float val011 = lerp(val0110, val0111, weights[3]);
-    float val100 = lerp(val1000, val1001, weights[3]);
-    float val101 = lerp(val1010, val1011, weights[3]);
-    float val110 = lerp(val1100, val1101, weights[3]);
-    float val111 = lerp(val1110, val1111, weights[3]);
-
-    float val00 = lerp(val000, val001, weights[2]);
-    float val01 = lerp(val010, val011, weights[2]);
-    float val10 = lerp(val100, val101, weights[2]);
-    float val11 = lerp(val110, val111, weights[2]);
-
-    float val0 = lerp(val00, val01, weights[1]);
-    float val1 = lerp(val10, val11, weights[1]);
-
-    float val = lerp(val0, val1, weights[0]);
+    float val = sumValues(samples, indices, weights, 16, wavelengthIndex);
 
     assert(!std::isnan(val) && !std::isinf(val));
     return val;
@@ -200,41 +187,163 @@ float LinearInterpolator::getValue(const SampleSet& samples,
                                    float            angle3,
                                    int              wavelengthIndex)
 {
-    const Arrayf& angles0 = samples.getAngles0();
-    const Arrayf& angles2 = samples.getAngles2();
-    const Arrayf& angles3 = samples.getAngles3();
+    int indices[8];
+    float weights[8];
+    findSamples(samples, angle0, angle2, angle3, indices, weights);
 
-    int lIdx0, lIdx2, lIdx3; // index of the lower bound sample point
-    int uIdx0, uIdx2, uIdx3; // index of the upper bound sample point
-    Vec4 lowerAngles, upperAngles;
+    float val = sumValues(samples, indices, weights, 8, wavelengthIndex);
 
-    findBounds(angles0, angle0, samples.isEqualIntervalAngles0(), &lIdx0, &uIdx0, &lowerAngles[0], &upperAngles[0]);
-    findBounds(angles2, angle2, samples.isEqualIntervalAngles2(), &lIdx2, &uIdx2, &lowerAngles[2], &upperAngles[2]);
-    findBounds(angles3, angle3, samples.isEqualIntervalAngles3(), &lIdx3, &uIdx3, &lowerAngles[3], &upperAngles[3]);
+    assert(!std::isnan(val) && !std::isinf(val));
+    return val;
+}
 
-    Vec4 angles(angle0, 0.0, angle2, angle3);
-    Vec4 intervals = (upperAngles - lowerAngles).cwiseMax(EPSILON_F);
-    Vec4 weights = (angles - lowerAngles).cwiseQuotient(intervals);
+void LinearInterpolator::getSpectra(const SampleSet& samples,
+                                    int             numQueries,
+                                    const float*    angles0,
+                                    const float*    angles1,
+                                    const float*    angles2,
+                                    const float*    angles3,
+                                    float*          spectra)
+{
+    const int numWavelengths = samples.getNumWavelengths();
+
+    int i = 0;
+    for (; i + SIMD_WIDTH <= numQueries; i += SIMD_WIDTH) {
+        getLaneSpectra(samples,
+                       angles0 + i, angles1 + i, angles2 + i, angles3 + i,
+                       SIMD_WIDTH, spectra + i * numWavelengths);
+    }
+
+    if (i == numQueries) return;
+
+    // The remaining queries are padded with the last one.
+    float laneAngles[4][SIMD_WIDTH];
+    for (int j = 0; j < SIMD_WIDTH; ++j) {
+        int index = std::min(i + j, numQueries - 1);
+        laneAngles[0][j] = angles0[index];
+        laneAngles[1][j] = angles1[index];
+        laneAngles[2][j] = angles2[index];
+        laneAngles[3][j] = angles3[index];
+    }
+
+    getLaneSpectra(samples,
+                   laneAngles[0], laneAngles[1], laneAngles[2], laneAngles[3],
+                   numQueries - i, spectra + i * numWavelengths);
+}
+
+void LinearInterpolator::getSpectra(const SampleSet& samples,
+                                    int             numQueries,
+                                    const float*    angles0,
+                                    const float*    angles2,
+                                    const float*    angles3,
+                                    float*          spectra)
+{
+    assert(samples.getNumAngles1() == 1);
+
+    const int numWavelengths = samples.getNumWavelengths();
+
+    int i = 0;
+    for (; i + SIMD_WIDTH <= numQueries; i += SIMD_WIDTH) {
+        getLaneSpectra(samples,
+                       angles0 + i, 0, angles2 + i, angles3 + i,
+                       SIMD_WIDTH, spectra + i * numWavelengths);
+    }
+
+    if (i == numQueries) return;
+
+    // The remaining queries are padded with the last one.
+    float laneAngles[3][SIMD_WIDTH];
+    for (int j = 0; j < SIMD_WIDTH; ++j) {
+        int index = std::min(i + j, numQueries - 1);
+        laneAngles[0][j] = angles0[index];
+        laneAngles[1][j] = angles2[index];
+        laneAngles[2][j] = angles3[index];
+    }
+
+    getLaneSpectra(samples,
+                   laneAngles[0], 0, laneAngles[1], laneAngles[2],
+                   numQueries - i, spectra + i * numWavelengths);
+}
+
+void LinearInterpolator::findIncomingCell(const SampleSet&  samples,
+                                          float             angle0,
+                                          float             angle1,
+                                          IncomingCell*     cell)
+{
+    int l[2], u[2];
+    float la[2], ua[2];
+    findBounds(samples.getAngles0(), samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), &l[0], &u[0], &la[0], &ua[0]);
+    findBounds(samples.getAngles1(), samples.getAngleLookupTable1(), angle1, samples.isEqualIntervalAngles1(), &l[1], &u[1], &la[1], &ua[1]);
+
+    float upperWeight0 = computeUpperWeight(angle0, la[0], ua[0], l[0], u[0]);
+    float upperWeight1 = computeUpperWeight(angle1, la[1], ua[1], l[1], u[1]);
+    float lowerWeight0 = 1.0f - upperWeight0;
+    float lowerWeight1 = 1.0f - upperWeight1;
+
+    cell->isotropic_ = false;
+    cell->numCorners_ = 0;
+
+    // The bits of i select the upper bound of angle0 and angle1 in the same order as findCornerIndices().
+    for (int i = 0; i < 4; ++i) {
+        float weight = ((i & 2) ? upperWeight0 : lowerWeight0)
+                     * ((i & 1) ? upperWeight1 : lowerWeight1);
+        if (weight == 0.0f) continue;
+
+        int corner = cell->numCorners_++;
+        cell->indices0_[corner] = (i & 2) ? u[0] : l[0];
+        cell->indices1_[corner] = (i & 1) ? u[1] : l[1];
+        cell->weights_[corner] = weight;
+    }
+}
 
-    float val0000 = samples.getSpectrum(lIdx0, lIdx2, lIdx3)[wavelengthIndex];
-    float val0001 = samples.getSpectrum(lIdx0, lIdx2, uIdx3)[wavelengthIndex];
-    float val0010 = samples.getSpectrum(lIdx0, uIdx2, lIdx3)[wavelengthIndex];
-    float val0011 = samples.getSpectrum(lIdx0, uIdx2, uIdx3)[wavelengthIndex];
+void LinearInterpolator::findIncomingCell(const SampleSet&  samples,
+                                          float             angle0,
+                                          IncomingCell*     cell)
+{
+    int l, u;
+    float la, ua;
+    findBounds(samples.getAngles0(), samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), &l, &u, &la, &ua);
 
-    float val1000 = samples.getSpectrum(uIdx0, lIdx2, lIdx3)[wavelengthIndex];
-    float val1001 = samples.getSpectrum(uIdx0, lIdx2, uIdx3)[wavelengthIndex];
-    float val1010 = samples.getSpectrum(uIdx0, uIdx2, lIdx3)[wavelengthIndex];
-    float val1011 = samples.getSpectrum(uIdx0, uIdx2, uIdx3)[wavelengthIndex];
+    float upperWeight = computeUpperWeight(angle0, la, ua, l, u);
 
-    float val000 = lerp(val0000, val0001, weights[3]);
-    float val001 = lerp(val0010, val0011, weights[3]);
-    float val100 = lerp(val1000, val1001, weights[3]);
-    float val101 = lerp(val1010, val1011, weights[3]);
+    cell->isotropic_ = true;
+    cell->numCorners_ = 0;
 
-    float val00 = lerp(val000, val001, weights[2]);
-    float val10 = lerp(val100, val101, weights[2]);
+    for (int i = 0; i < 2; ++i) {
+        float weight = i ? upperWeight : 1.0f - upperWeight;
+        if (weight == 0.0f) continue;
 
-    float val = lerp(val00, val10, weights[0]);
+        int corner = cell->numCorners_++;
+        cell->indices0_[corner] = i ? u : l;
+        cell->indices1_[corner] = 0;
+        cell->weights_[corner] = weight;
+    }
+}
+
+void LinearInterpolator::getSpectrum(const SampleSet&       samples,
+                                     const IncomingCell&    cell,
+                                     float                  angle2,
+                                     float                  angle3,
+                                     float*                 spectrum)
+{
+    int indices[16];
+    float weights[16];
+    int numSamples = findSamples(samples, cell, angle2, angle3, indices, weights);
+
+    sumSpectra(samples, indices, weights, numSamples, spectrum);
+}
+
+float LinearInterpolator::getValue(const SampleSet&     samples,
+                                   const IncomingCell&  cell,
+                                   float                angle2,
+                                   float                angle3,
+                                   int                  wavelengthIndex)
+{
+    int indices[16];
+    float weights[16];
+    int numSamples = findSamples(samples, cell, angle2, angle3, indices, weights);
+
+    float val = sumValues(samples, indices, weights, numSamples, wavelengthIndex);
 
     assert(!std::isnan(val) && !std::isinf(val));
     return val;
@@ -253,8 +362,8 @@ void LinearInterpolator::getSpectrum(const SampleSet2D& ss2,
     float lowerAngle0, lowerAngle1;
     float upperAngle0, upperAngle1;
 
-    findBounds(thetaArray, theta, ss2.isEqualIntervalTheta(), &lIdx0, &uIdx0, &lowerAngle0, &upperAngle0);
-    findBounds(phiArray,   phi,   ss2.isEqualIntervalPhi(),   &lIdx1, &uIdx1, &lowerAngle1, &upperAngle1);
+    findBounds(thetaArray, ss2.getThetaLookupTable(), theta, ss2.isEqualIntervalTheta(), &lIdx0, &uIdx0, &lowerAngle0, &upperAngle0);
+    findBounds(phiArray,   ss2.getPhiLookupTable(),   phi,   ss2.isEqualIntervalPhi(),   &lIdx1, &uIdx1, &lowerAngle1, &upperAngle1);
 
     const Spectrum& sp00 = ss2.getSpectrum(lIdx0, lIdx1);
     const Spectrum& sp01 = ss2.getSpectrum(lIdx0, uIdx1);
@@ -267,10 +376,9 @@ void LinearInterpolator::getSpectrum(const SampleSet2D& ss2,
     float weight0 = (theta - lowerAngle0) / interval0;
     float weight1 = (phi   - lowerAngle1) / interval1;
 
-    Spectrum sp0 = lerp(sp00, sp01, weight1);
-    Spectrum sp1 = lerp(sp10, sp11, weight1);
-
-    *spectrum = lerp(sp0, sp1, weight0);
+    // The expression is evaluated into the spectrum without temporary spectra.
+    *spectrum = (sp00 + (sp01 - sp00) * weight1)
+              + ((sp10 + (sp11 - sp10) * weight1) - (sp00 + (sp01 - sp00) * weight1)) * weight0;
 
     assert(spectrum->allFinite());
 }
@@ -286,7 +394,7 @@ void LinearInterpolator::getSpectrum(const SampleSet2D& ss2,
     float lowerAngle0;
     float upperAngle0;
 
-    findBounds(thetaArray, theta, ss2.isEqualIntervalTheta(), &lIdx0, &uIdx0, &lowerAngle0, &upperAngle0);
+    findBounds(thetaArray, ss2.getThetaLookupTable(), theta, ss2.isEqualIntervalTheta(), &lIdx0, &uIdx0, &lowerAngle0, &upperAngle0);
 
     const Spectrum& sp0 = ss2.getSpectrum(lIdx0);
     const Spectrum& sp1 = ss2.getSpectrum(uIdx0);
@@ -294,18 +402,19 @@ void LinearInterpolator::getSpectrum(const SampleSet2D& ss2,
     float interval0 = std::max(upperAngle0 - lowerAngle0, EPSILON_F);
     float weight0 = (theta - lowerAngle0) / interval0;
 
-    *spectrum = lerp(sp0, sp1, weight0);
+    *spectrum = sp0 + (sp1 - sp0) * weight0;
 
     assert(spectrum->allFinite());
 }
 
-void LinearInterpolator::findBounds(const Arrayf&   angles,
-                                    float           angle,
-                                    bool            equalIntervalAngles,
-                                    int*            lowerIndex,
-                                    int*            upperIndex,
-                                    Vec4::Scalar*   lowerAngle,
-                                    Vec4::Scalar*   upperAngle)
+void LinearInterpolator::findBounds(const Arrayf&           angles,
+                                    const AngleLookupTable& lookupTable,
+                                    float                   angle,
+                                    bool                    equalIntervalAngles,
+                                    int*                    lowerIndex,
+                                    int*                    upperIndex,
+                                    Vec4::Scalar*           lowerAngle,
+                                    Vec4::Scalar*           upperAngle)
 {
     if (angles.size() == 1) {
         *lowerIndex = 0;
@@ -325,11 +434,503 @@ void LinearInterpolator::findBounds(const Arrayf&   angles,
     }
     else {
         // Find lower and upper indices.
-        const float* anglePtr = std::lower_bound(&angles[0], &angles[0] + angles.size(), angle);
-        *upperIndex = clamp(static_cast<int>(anglePtr - &angles[0]), 1, backIndex);
+        *upperIndex = clamp(lookupTable.findLowerBound(angles, angle), 1, backIndex);
         *lowerIndex = *upperIndex - 1;
     }
 
     *lowerAngle = angles[*lowerIndex];
     *upperAngle = angles[*upperIndex];
 }
+
+void LinearInterpolator::findSamples(const SampleSet&   samples,
+                                     float              angle0,
+                                     float              angle1,
+                                     float              angle2,
+                                     float              angle3,
+                                     int*               indices,
+                                     float*             weights)
+{
+    int lowerIndices[4], upperIndices[4];
+    Vec4 lowerAngles, upperAngles;
+
+    findBounds(samples.getAngles0(), samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), &lowerIndices[0], &upperIndices[0], &lowerAngles[0], &upperAngles[0]);
+    findBounds(samples.getAngles1(), samples.getAngleLookupTable1(), angle1, samples.isEqualIntervalAngles1(), &lowerIndices[1], &upperIndices[1], &lowerAngles[1], &upperAngles[1]);
+    findBounds(samples.getAngles2(), samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), &lowerIndices[2], &upperIndices[2], &lowerAngles[2], &upperAngles[2]);
+    findBounds(samples.getAngles3(), samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), &lowerIndices[3], &upperIndices[3], &lowerAngles[3], &upperAngles[3]);
+
+    findCornerIndices(samples, lowerIndices, upperIndices, false, indices);
+    computeCornerWeights(Vec4(angle0, angle1, angle2, angle3), lowerAngles, upperAngles,
+                         lowerIndices, upperIndices, false, weights);
+}
+
+void LinearInterpolator::findSamples(const SampleSet&   samples,
+                                     float              angle0,
+                                     float              angle2,
+                                     float              angle3,
+                                     int*               indices,
+                                     float*             weights)
+{
+    int lowerIndices[4], upperIndices[4];
+    Vec4 lowerAngles, upperAngles;
+
+    findBounds(samples.getAngles0(), samples.getAngleLookupTable0(), angle0, samples.isEqualIntervalAngles0(), &lowerIndices[0], &upperIndices[0], &lowerAngles[0], &upperAngles[0]);
+    findBounds(samples.getAngles2(), samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), &lowerIndices[2], &upperIndices[2], &lowerAngles[2], &upperAngles[2]);
+    findBounds(samples.getAngles3(), samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), &lowerIndices[3], &upperIndices[3], &lowerAngles[3], &upperAngles[3]);
+
+    lowerIndices[1] = upperIndices[1] = 0;
+    lowerAngles[1] = upperAngles[1] = 0.0f;
+
+    findCornerIndices(samples, lowerIndices, upperIndices, true, indices);
+    computeCornerWeights(Vec4(angle0, 0.0, angle2, angle3), lowerAngles, upperAngles,
+                         lowerIndices, upperIndices, true, weights);
+}
+
+void LinearInterpolator::findCornerIndices(const SampleSet& samples,
+                                           const int*       lowerIndices,
+                                           const int*       upperIndices,
+                                           bool             isotropic,
+                                           int*             indices)
+{
+    const int* l = lowerIndices;
+    const int* u = upperIndices;
+
+    if (isotropic) {
+        // The bits of i select the upper bound of angle0, angle2, and angle3 in that order.
+        for (int i = 0; i < 8; ++i) {
+            indices[i] = samples.getIndex((i & 4) ? u[0] : l[0],
+                                          (i & 2) ? u[2] : l[2],
+                                          (i & 1) ? u[3] : l[3]);
+        }
+    }
+    else {
+        // The bits of i select the upper bound of angle0, angle1, angle2, and angle3 in that order.
+        for (int i = 0; i < 16; ++i) {
+            indices[i] = samples.getIndex((i & 8) ? u[0] : l[0],
+                                          (i & 4) ? u[1] : l[1],
+                                          (i & 2) ? u[2] : l[2],
+                                          (i & 1) ? u[3] : l[3]);
+        }
+    }
+}
+
+void LinearInterpolator::computeCornerWeights(const Vec4&   angles,
+                                              const Vec4&   lowerAngles,
+                                              const Vec4&   upperAngles,
+                                              const int*    lowerIndices,
+                                              const int*    upperIndices,
+                                              bool          isotropic,
+                                              float*        weights)
+{
+    Vec4 intervals = (upperAngles - lowerAngles).cwiseMax(EPSILON_F);
+    Vec4 upperWeights = (angles - lowerAngles).cwiseQuotient(intervals);
+
+    // An axis with a single angle has no extent to interpolate.
+    for (int i = 0; i < 4; ++i) {
+        if (lowerIndices[i] == upperIndices[i]) upperWeights[i] = 0.0f;
+    }
+
+    Vec4 lowerWeights = Vec4::Ones() - upperWeights;
+
+    if (isotropic) {
+        for (int i = 0; i < 8; ++i) {
+            weights[i] = ((i & 4) ? upperWeights[0] : lowerWeights[0])
+                       * ((i & 2) ? upperWeights[2] : lowerWeights[2])
+                       * ((i & 1) ? upperWeights[3] : lowerWeights[3]);
+        }
+    }
+    else {
+        for (int i = 0; i < 16; ++i) {
+            weights[i] = ((i & 8) ? upperWeights[0] : lowerWeights[0])
+                       * ((i & 4) ? upperWeights[1] : lowerWeights[1])
+                       * ((i & 2) ? upperWeights[2] : lowerWeights[2])
+                       * ((i & 1) ? upperWeights[3] : lowerWeights[3]);
+        }
+    }
+}
+
+bool LinearInterpolator::findCachedBounds(const Arrayf&             angles,
+                                          const AngleLookupTable&   lookupTable,
+                                          float                     angle,
+                                          bool                      equalIntervalAngles,
+                                          bool                      cached,
+                                          int*                      lowerIndex,
+                                          int*                      upperIndex,
+                                          float*                    lowerAngle,
+                                          float*                    upperAngle)
+{
+    if (cached) {
+        const int backIndex = static_cast<int>(angles.size() - 1);
+
+        // The same cell. Angles out of range are extrapolated with the cell at the end.
+        if (*lowerIndex == *upperIndex ||
+            (*lowerAngle <= angle && angle <= *upperAngle) ||
+            (angle < *lowerAngle && *lowerIndex == 0) ||
+            (angle > *upperAngle && *upperIndex == backIndex)) {
+            return false;
+        }
+
+        // Adjacent cells
+        if (angle < *lowerAngle && angles[*lowerIndex - 1] <= angle) {
+            --*lowerIndex;
+            --*upperIndex;
+            *upperAngle = *lowerAngle;
+            *lowerAngle = angles[*lowerIndex];
+            return true;
+        }
+        else if (angle > *upperAngle && angle <= angles[*upperIndex + 1]) {
+            ++*lowerIndex;
+            ++*upperIndex;
+            *lowerAngle = *upperAngle;
+            *upperAngle = angles[*upperIndex];
+            return true;
+        }
+    }
+
+    findBounds(angles, lookupTable, angle, equalIntervalAngles, lowerIndex, upperIndex, lowerAngle, upperAngle);
+    return true;
+}
+
+int LinearInterpolator::findSamples(const SampleSet&    samples,
+                                    const IncomingCell& cell,
+                                    float               angle2,
+                                    float               angle3,
+                                    int*                indices,
+                                    float*              weights)
+{
+    int l[2], u[2];
+    float la[2], ua[2];
+    findBounds(samples.getAngles2(), samples.getAngleLookupTable2(), angle2, samples.isEqualIntervalAngles2(), &l[0], &u[0], &la[0], &ua[0]);
+    findBounds(samples.getAngles3(), samples.getAngleLookupTable3(), angle3, samples.isEqualIntervalAngles3(), &l[1], &u[1], &la[1], &ua[1]);
+
+    float upperWeight2 = computeUpperWeight(angle2, la[0], ua[0], l[0], u[0]);
+    float upperWeight3 = computeUpperWeight(angle3, la[1], ua[1], l[1], u[1]);
+    float lowerWeight2 = 1.0f - upperWeight2;
+    float lowerWeight3 = 1.0f - upperWeight3;
+
+    // Weights are multiplied in the same order as computeCornerWeights().
+    int numSamples = 0;
+    for (int i = 0; i < cell.numCorners_; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            int index2 = (j & 2) ? u[0] : l[0];
+            int index3 = (j & 1) ? u[1] : l[1];
+
+            indices[numSamples] = cell.isotropic_
+                                ? samples.getIndex(cell.indices0_[i], index2, index3)
+                                : samples.getIndex(cell.indices0_[i], cell.indices1_[i], index2, index3);
+            weights[numSamples] = cell.weights_[i]
+                                * ((j & 2) ? upperWeight2 : lowerWeight2)
+                                * ((j & 1) ? upperWeight3 : lowerWeight3);
+            ++numSamples;
+        }
+    }
+
+    return numSamples;
+}
+
+float LinearInterpolator::computeUpperWeight(float  angle,
+                                             float  lowerAngle,
+                                             float  upperAngle,
+                                             int    lowerIndex,
+                                             int    upperIndex)
+{
+    if (lowerIndex == upperIndex) return 0.0f;
+
+    float interval = std::max(upperAngle - lowerAngle, EPSILON_F);
+    return (angle - lowerAngle) / interval;
+}
+
+void LinearInterpolator::sumSpectra(const SampleSet&    samples,
+                                    const int*          indices,
+                                    const float*        weights,
+                                    int                 numSamples,
+                                    float*              spectrum)
+{
+    // Monochromatic and RGB data are summed with fixed-size arrays.
+    if (samples.getSpectrumPrecision() == HALF_PRECISION) {
+        switch (samples.getNumWavelengths()) {
+            case 1:
+                sumCompactSpectra<1, HALF_PRECISION>(samples, indices, weights, numSamples, spectrum);
+                break;
+            case 3:
+                sumCompactSpectra<3, HALF_PRECISION>(samples, indices, weights, numSamples, spectrum);
+                break;
+            default:
+                sumCompactSpectra<Eigen::Dynamic, HALF_PRECISION>(samples, indices, weights, numSamples, spectrum);
+                break;
+        }
+    }
+    else if (samples.getSpectrumPrecision() == BFLOAT16_PRECISION) {
+        switch (samples.getNumWavelengths()) {
+            case 1:
+                sumCompactSpectra<1, BFLOAT16_PRECISION>(samples, indices, weights, numSamples, spectrum);
+                break;
+            case 3:
+                sumCompactSpectra<3, BFLOAT16_PRECISION>(samples, indices, weights, numSamples, spectrum);
+                break;
+            default:
+                sumCompactSpectra<Eigen::Dynamic, BFLOAT16_PRECISION>(samples, indices, weights, numSamples, spectrum);
+                break;
+        }
+    }
+    else if (samples.getSpectrumLayout() == PLANAR_LAYOUT) {
+        switch (samples.getNumWavelengths()) {
+            case 1:
+                sumSpectra<1, Eigen::Dynamic>(samples, indices, weights, numSamples, spectrum);
+                break;
+            case 3:
+                sumSpectra<3, Eigen::Dynamic>(samples, indices, weights, numSamples, spectrum);
+                break;
+            default:
+                sumSpectra<Eigen::Dynamic, Eigen::Dynamic>(samples, indices, weights, numSamples, spectrum);
+                break;
+        }
+    }
+    else {
+        switch (samples.getNumWavelengths()) {
+            case 1:
+                sumSpectra<1, 1>(samples, indices, weights, numSamples, spectrum);
+                break;
+            case 3:
+                sumSpectra<3, 1>(samples, indices, weights, numSamples, spectrum);
+                break;
+            default:
+                sumSpectra<Eigen::Dynamic, 1>(samples, indices, weights, numSamples, spectrum);
+                break;
+        }
+    }
+}
+
+template <int NumWavelengths, int WavelengthStride>
+void LinearInterpolator::sumSpectra(const SampleSet&    samples,
+                                    const int*          indices,
+                                    const float*        weights,
+                                    int                 numSamples,
+                                    float*              spectrum)
+{
+    typedef Eigen::Array<Spectrum::Scalar, NumWavelengths, 1> SpectrumN;
+    typedef Eigen::InnerStride<WavelengthStride> StrideN;
+    typedef Eigen::Map<const SpectrumN, Eigen::Unaligned, StrideN> ConstSpectrumNMap;
+
+    const int numWavelengths = samples.getNumWavelengths();
+    const int sampleStride = samples.getSampleStride();
+    const StrideN wavelengthStride(samples.getWavelengthStride());
+    const float* spectra = samples.getSpectra().data();
+
+    Eigen::Map<SpectrumN> sp(spectrum, numWavelengths);
+    sp = weights[0] * ConstSpectrumNMap(spectra + indices[0] * sampleStride, numWavelengths, wavelengthStride);
+    for (int i = 1; i < numSamples; ++i) {
+        sp += weights[i] * ConstSpectrumNMap(spectra + indices[i] * sampleStride, numWavelengths, wavelengthStride);
+    }
+}
+
+template <int NumWavelengths, SpectrumPrecision Precision>
+void LinearInterpolator::sumCompactSpectra(const SampleSet& samples,
+                                           const int*       indices,
+                                           const float*     weights,
+                                           int              numSamples,
+                                           float*           spectrum)
+{
+    typedef Eigen::Array<Spectrum::Scalar, NumWavelengths, 1> SpectrumN;
+
+    const int numWavelengths = samples.getNumWavelengths();
+    const int sampleStride = samples.getSampleStride();
+    const int wavelengthStride = samples.getWavelengthStride();
+    const uint16_t* spectra = samples.getCompactSpectra();
+
+    Eigen::Map<SpectrumN> sp(spectrum, numWavelengths);
+    sp.setZero();
+    for (int i = 0; i < numSamples; ++i) {
+        const uint16_t* values = spectra + indices[i] * sampleStride;
+        for (int j = 0; j < numWavelengths; ++j) {
+            sp[j] += weights[i] * toFloat(values[j * wavelengthStride], Precision);
+        }
+    }
+}
+
+float LinearInterpolator::sumValues(const SampleSet&    samples,
+                                    const int*          indices,
+                                    const float*        weights,
+                                    int                 numSamples,
+                                    int                 wavelengthIndex)
+{
+    const int sampleStride = samples.getSampleStride();
+    const int offset = wavelengthIndex * samples.getWavelengthStride();
+
+    float val = 0.0f;
+    if (samples.getSpectrumPrecision() == SINGLE_PRECISION) {
+        const float* values = samples.getSpectra().data() + offset;
+        for (int i = 0; i < numSamples; ++i) {
+            val += weights[i] * values[indices[i] * sampleStride];
+        }
+    }
+    else {
+        const SpectrumPrecision precision = samples.getSpectrumPrecision();
+        const uint16_t* values = samples.getCompactSpectra() + offset;
+        for (int i = 0; i < numSamples; ++i) {
+            val += weights[i] * toFloat(values[indices[i] * sampleStride], precision);
+        }
+    }
+
+    return val;
+}
+
+void LinearInterpolator::getLaneSpectra(const SampleSet&    samples,
+                                        const float*        angles0,
+                                        const float*        angles1,
+                                        const float*        angles2,
+                                        const float*        angles3,
+                                        int                 numLanes,
+                                        float*              spectra)
+{
+    int lowerIndices[4][SIMD_WIDTH];
+    int upperIndices[4][SIMD_WIDTH];
+    float upperWeights[4][SIMD_WIDTH];
+
+    findLaneBounds(samples.getAngles0(), samples.getAngleLookupTable0(), samples.isEqualIntervalAngles0(), angles0,
+                   lowerIndices[0], upperIndices[0], upperWeights[0]);
+    findLaneBounds(samples.getAngles2(), samples.getAngleLookupTable2(), samples.isEqualIntervalAngles2(), angles2,
+                   lowerIndices[2], upperIndices[2], upperWeights[2]);
+    findLaneBounds(samples.getAngles3(), samples.getAngleLookupTable3(), samples.isEqualIntervalAngles3(), angles3,
+                   lowerIndices[3], upperIndices[3], upperWeights[3]);
+
+    if (angles1) {
+        findLaneBounds(samples.getAngles1(), samples.getAngleLookupTable1(), samples.isEqualIntervalAngles1(), angles1,
+                       lowerIndices[1], upperIndices[1], upperWeights[1]);
+    }
+    else {
+        std::fill(lowerIndices[1], lowerIndices[1] + SIMD_WIDTH, 0);
+        std::fill(upperIndices[1], upperIndices[1] + SIMD_WIDTH, 0);
+        std::fill(upperWeights[1], upperWeights[1] + SIMD_WIDTH, 0.0f);
+    }
+
+    // Offsets of sample points along each axis in the array of spectra.
+    const int sampleStride = samples.getSampleStride();
+    int lowerOffsets[4][SIMD_WIDTH];
+    int upperOffsets[4][SIMD_WIDTH];
+    for (int i = 0; i < SIMD_WIDTH; ++i) {
+        lowerOffsets[0][i] = samples.getIndex(lowerIndices[0][i], 0, 0, 0) * sampleStride;
+        lowerOffsets[1][i] = samples.getIndex(0, lowerIndices[1][i], 0, 0) * sampleStride;
+        lowerOffsets[2][i] = samples.getIndex(0, 0, lowerIndices[2][i], 0) * sampleStride;
+        lowerOffsets[3][i] = samples.getIndex(0, 0, 0, lowerIndices[3][i]) * sampleStride;
+        upperOffsets[0][i] = samples.getIndex(upperIndices[0][i], 0, 0, 0) * sampleStride;
+        upperOffsets[1][i] = samples.getIndex(0, upperIndices[1][i], 0, 0) * sampleStride;
+        upperOffsets[2][i] = samples.getIndex(0, 0, upperIndices[2][i], 0) * sampleStride;
+        upperOffsets[3][i] = samples.getIndex(0, 0, 0, upperIndices[3][i]) * sampleStride;
+    }
+
+    // An axis with a single angle has no upper bound to interpolate.
+    bool interpolated[4];
+    interpolated[0] = (samples.getNumAngles0() > 1);
+    interpolated[1] = (samples.getNumAngles1() > 1 && angles1);
+    interpolated[2] = (samples.getNumAngles2() > 1);
+    interpolated[3] = (samples.getNumAngles3() > 1);
+
+    FloatLanes upperWeightLanes[4];
+    FloatLanes lowerWeightLanes[4];
+    for (int i = 0; i < 4; ++i) {
+        upperWeightLanes[i] = loadLanes(upperWeights[i]);
+        lowerWeightLanes[i] = subLanes(setLanes(1.0f), upperWeightLanes[i]);
+    }
+
+    // The bits of i select the upper bound of angle0, angle1, angle2, and angle3 in that order.
+    FloatLanes cornerWeights[16];
+    int cornerOffsets[16][SIMD_WIDTH];
+    int numCorners = 0;
+    for (int i = 0; i < 16; ++i) {
+        bool upper[4] = { (i & 8) != 0, (i & 4) != 0, (i & 2) != 0, (i & 1) != 0 };
+
+        if ((upper[0] && !interpolated[0]) ||
+            (upper[1] && !interpolated[1]) ||
+            (upper[2] && !interpolated[2]) ||
+            (upper[3] && !interpolated[3])) {
+            continue;
+        }
+
+        FloatLanes weight = setLanes(1.0f);
+        std::fill(cornerOffsets[numCorners], cornerOffsets[numCorners] + SIMD_WIDTH, 0);
+        for (int j = 0; j < 4; ++j) {
+            const int* offsets = upper[j] ? upperOffsets[j] : lowerOffsets[j];
+            for (int k = 0; k < SIMD_WIDTH; ++k) {
+                cornerOffsets[numCorners][k] += offsets[k];
+            }
+
+            if (interpolated[j]) {
+                weight = mulLanes(weight, upper[j] ? upperWeightLanes[j] : lowerWeightLanes[j]);
+            }
+        }
+
+        cornerWeights[numCorners] = weight;
+        ++numCorners;
+    }
+
+    const int numWavelengths = samples.getNumWavelengths();
+    const int wavelengthStride = samples.getWavelengthStride();
+    const SpectrumPrecision precision = samples.getSpectrumPrecision();
+
+    float laneValues[SIMD_WIDTH];
+    for (int i = 0; i < numWavelengths; ++i) {
+        FloatLanes sum = setLanes(0.0f);
+        if (precision == SINGLE_PRECISION) {
+            const float* values = samples.getSpectra().data() + i * wavelengthStride;
+            for (int j = 0; j < numCorners; ++j) {
+                sum = addLanes(sum, mulLanes(cornerWeights[j], gatherLanes(values, cornerOffsets[j])));
+            }
+        }
+        else {
+            const uint16_t* values = samples.getCompactSpectra() + i * wavelengthStride;
+            for (int j = 0; j < numCorners; ++j) {
+                for (int k = 0; k < SIMD_WIDTH; ++k) {
+                    laneValues[k] = toFloat(values[cornerOffsets[j][k]], precision);
+                }
+                sum = addLanes(sum, mulLanes(cornerWeights[j], loadLanes(laneValues)));
+            }
+        }
+
+        storeLanes(laneValues, sum);
+        for (int j = 0; j < numLanes; ++j) {
+            spectra[j * numWavelengths + i] = laneValues[j];
+        }
+    }
+}
+
+void LinearInterpolator::findLaneBounds(const Arrayf&           angles,
+                                        const AngleLookupTable& lookupTable,
+                                        bool                    equalIntervalAngles,
+                                        const float*            laneAngles,
+                                        int*                    lowerIndices,
+                                        int*                    upperIndices,
+                                        float*                  upperWeights)
+{
+    if (angles.size() == 1) {
+        std::fill(lowerIndices, lowerIndices + SIMD_WIDTH, 0);
+        std::fill(upperIndices, upperIndices + SIMD_WIDTH, 0);
+        std::fill(upperWeights, upperWeights + SIMD_WIDTH, 0.0f);
+        return;
+    }
+
+    int backIndex = static_cast<int>(angles.size() - 1);
+    FloatLanes angleLanes = loadLanes(laneAngles);
+
+    if (equalIntervalAngles) {
+        // Calculate lower and upper indices.
+        FloatLanes indexLanes = divLanes(mulLanes(setLanes(static_cast<float>(backIndex)), angleLanes),
+                                         setLanes(angles[backIndex]));
+        truncateLanes(indexLanes, lowerIndices);
+        for (int i = 0; i < SIMD_WIDTH; ++i) {
+            lowerIndices[i] = std::min(lowerIndices[i], backIndex - 1);
+            upperIndices[i] = lowerIndices[i] + 1;
+        }
+    }
+    else {
+        // Find lower and upper indices.
+        for (int i = 0; i < SIMD_WIDTH; ++i) {
+            upperIndices[i] = clamp(lookupTable.findLowerBound(angles, laneAngles[i]), 1, backIndex);
+            lowerIndices[i] = upperIndices[i] - 1;
+        }
+    }
+
+    FloatLanes lowerAngles = gatherLanes(angles.data(), lowerIndices);
+    FloatLanes upperAngles = gatherLanes(angles.data(), upperIndices);
+    FloatLanes intervals = maxLanes(subLanes(upperAngles, lowerAngles), setLanes(EPSILON_F));
+    storeLanes(upperWeights, divLanes(subLanes(angleLanes, lowerAngles), intervals));
+}
@@ -8,6 +8,8 @@
 
 #include <libbsdf/Brdf/Material.h>
 
+#include <utility>
+
 using namespace lb;
 
 Material::Material(Bsdf*        bsdf,
@@ -21,6 +23,30 @@ Material::Material(Bsdf*        bsdf,
                      reflectionTis_(reflectionTis),
                      transmissionTis_(transmissionTis) {}
 
+Material::Material(Material&& material)
+                   : bsdf_(material.bsdf_),
+                     specularReflectances_(material.specularReflectances_),
+                     specularTransmittances_(material.specularTransmittances_),
+                     reflectionTis_(material.reflectionTis_),
+                     transmissionTis_(material.transmissionTis_)
+{
+    material.bsdf_ = 0;
+    material.specularReflectances_ = 0;
+    material.specularTransmittances_ = 0;
+    material.reflectionTis_ = 0;
+    material.transmissionTis_ = 0;
+}
+
+Material& Material::operator=(Material&& material)
+{
+    std::swap(bsdf_,                   material.bsdf_);
+    std::swap(specularReflectances_,   material.specularReflectances_);
+    std::swap(specularTransmittances_, material.specularTransmittances_);
+    std::swap(reflectionTis_,          material.reflectionTis_);
+    std::swap(transmissionTis_,        material.transmissionTis_);
+    return *this;
+}
+
 Material::~Material()
 {
     delete bsdf_;
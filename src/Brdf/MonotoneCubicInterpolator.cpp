@@ -0,0 +1,167 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Brdf/MonotoneCubicInterpolator.h>
+
+#include <algorithm>
+
+#include <libbsdf/Common/MonotoneCubicSpline.h>
+#include <libbsdf/Common/Utility.h>
+
+using namespace lb;
+
+void MonotoneCubicInterpolator::interpolate(const MonotoneCubicSlopeTable&    table,
+                                            float                             angle0,
+                                            float                             angle1,
+                                            float                             angle2,
+                                            float                             angle3,
+                                            int                               wavelengthIndex,
+                                            int                               numWavelengths,
+                                            float*                            values)
+{
+    const SampleSet& samples = *table.getSampleSet();
+
+    int indices0[4], indices1[4], indices2[4], indices3[4];
+    float angles0[4], angles1[4], angles2[4], angles3[4];
+
+    int numPoints0 = findSamplePoints(samples.getAngles0(), samples.getAngleLookupTable0(),
+                                      samples.isEqualIntervalAngles0(), false,
+                                      angle0, indices0, angles0);
+    int numPoints1 = findSamplePoints(samples.getAngles1(), samples.getAngleLookupTable1(),
+                                      samples.isEqualIntervalAngles1(), isFullCircle(samples.getAngles1()),
+                                      angle1, indices1, angles1);
+    int numPoints2 = findSamplePoints(samples.getAngles2(), samples.getAngleLookupTable2(),
+                                      samples.isEqualIntervalAngles2(), false,
+                                      angle2, indices2, angles2);
+    int numPoints3 = findSamplePoints(samples.getAngles3(), samples.getAngleLookupTable3(),
+                                      samples.isEqualIntervalAngles3(), isFullCircle(samples.getAngles3()),
+                                      angle3, indices3, angles3);
+
+    // Only the cell along angle3 is used since slopes along angle3 are precomputed.
+    int cellIndex3 = (numPoints3 == 1) ? 0 : 1;
+    int lowerIndex3 = indices3[cellIndex3];
+    int upperIndex3 = indices3[cellIndex3 + (numPoints3 == 1 ? 0 : 1)];
+    float lowerAngle3 = angles3[cellIndex3];
+    float upperAngle3 = angles3[cellIndex3 + (numPoints3 == 1 ? 0 : 1)];
+
+    const int numAngles0 = samples.getNumAngles0();
+    const int numAngles1 = samples.getNumAngles1();
+    const int numLines = numAngles0 * numAngles1 * samples.getNumAngles2();
+
+    // Sample points are ordered with angle0 varying fastest.
+    int lowerIndices[64], upperIndices[64];
+    const float* lowerSlopes[64];
+    const float* upperSlopes[64];
+    int numPoints = 0;
+    for (int i2 = 0; i2 < numPoints2; ++i2) {
+    for (int i1 = 0; i1 < numPoints1; ++i1) {
+    for (int i0 = 0; i0 < numPoints0; ++i0, ++numPoints) {
+        lowerIndices[numPoints] = samples.getIndex(indices0[i0], indices1[i1], indices2[i2], lowerIndex3);
+        upperIndices[numPoints] = samples.getIndex(indices0[i0], indices1[i1], indices2[i2], upperIndex3);
+
+        int lineIndex = indices0[i0] + numAngles0 * (indices1[i1] + numAngles1 * indices2[i2]);
+        lowerSlopes[numPoints] = table.getSlopes(lineIndex + numLines * lowerIndex3);
+        upperSlopes[numPoints] = table.getSlopes(lineIndex + numLines * upperIndex3);
+    }}}
+
+    float pointValues[64];
+    for (int i = 0; i < numWavelengths; ++i) {
+        int wlIndex = wavelengthIndex + i;
+
+        for (int j = 0; j < numPoints; ++j) {
+            pointValues[j] = MonotoneCubicSpline::interpolate(lowerAngle3, upperAngle3,
+                                                              samples.getValue(lowerIndices[j], wlIndex),
+                                                              samples.getValue(upperIndices[j], wlIndex),
+                                                              lowerSlopes[j][wlIndex],
+                                                              upperSlopes[j][wlIndex],
+                                                              angle3);
+        }
+
+        int numValues = numPoints;
+        numValues = reduce(pointValues, numValues, numPoints0, angles0, angle0);
+        numValues = reduce(pointValues, numValues, numPoints1, angles1, angle1);
+        numValues = reduce(pointValues, numValues, numPoints2, angles2, angle2);
+        assert(numValues == 1);
+
+        values[i] = pointValues[0];
+    }
+}
+
+int MonotoneCubicInterpolator::reduce(float*        values,
+                                      int           numValues,
+                                      int           numPoints,
+                                      const float*  sampleAngles,
+                                      float         angle)
+{
+    if (numPoints == 1) return numValues;
+
+    int numReducedValues = 0;
+    for (int i = 0; i < numValues; i += 4, ++numReducedValues) {
+        values[numReducedValues] = MonotoneCubicSpline::interpolate(sampleAngles[0], sampleAngles[1],
+                                                                    sampleAngles[2], sampleAngles[3],
+                                                                    values[i],     values[i + 1],
+                                                                    values[i + 2], values[i + 3],
+                                                                    angle);
+    }
+
+    return numReducedValues;
+}
+
+int MonotoneCubicInterpolator::findSamplePoints(const Arrayf&           angles,
+                                                const AngleLookupTable& lookupTable,
+                                                bool                    equalIntervalAngles,
+                                                bool                    periodic,
+                                                float                   angle,
+                                                int*                    indices,
+                                                float*                  sampleAngles)
+{
+    if (angles.size() == 1) {
+        indices[0] = 0;
+        sampleAngles[0] = angles[0];
+        return 1;
+    }
+
+    int backIndex = static_cast<int>(angles.size() - 1);
+
+    int lowerIndex;
+    if (equalIntervalAngles) {
+        lowerIndex = static_cast<int>(backIndex * angle / (angles[backIndex]));
+        lowerIndex = clamp(lowerIndex, 0, backIndex - 1);
+    }
+    else {
+        lowerIndex = clamp(lookupTable.findLowerBound(angles, angle), 1, backIndex) - 1;
+    }
+
+    int upperIndex = lowerIndex + 1;
+
+    indices[1] = lowerIndex;
+    indices[2] = upperIndex;
+
+    if (periodic && lowerIndex == 0) {
+        indices[0] = backIndex - 1;
+        sampleAngles[0] = angles[backIndex - 1] - angles[backIndex];
+    }
+    else {
+        indices[0] = std::max(lowerIndex - 1, 0);
+        sampleAngles[0] = angles[indices[0]];
+    }
+
+    if (periodic && upperIndex == backIndex) {
+        indices[3] = 1;
+        sampleAngles[3] = angles[1] + angles[backIndex];
+    }
+    else {
+        indices[3] = std::min(upperIndex + 1, backIndex);
+        sampleAngles[3] = angles[indices[3]];
+    }
+
+    sampleAngles[1] = angles[lowerIndex];
+    sampleAngles[2] = angles[upperIndex];
+
+    return 4;
+}
@@ -0,0 +1,79 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Brdf/MonotoneCubicSlopeTable.h>
+
+#include <libbsdf/Common/MonotoneCubicSpline.h>
+
+using namespace lb;
+
+MonotoneCubicSlopeTable::MonotoneCubicSlopeTable() : samples_(0),
+                                                     numAngles0_(0),
+                                                     numAngles1_(0),
+                                                     numAngles2_(0),
+                                                     numAngles3_(0),
+                                                     numWavelengths_(0) {}
+
+MonotoneCubicSlopeTable::MonotoneCubicSlopeTable(const SampleSet& samples) : samples_(0),
+                                                                             numAngles0_(0),
+                                                                             numAngles1_(0),
+                                                                             numAngles2_(0),
+                                                                             numAngles3_(0),
+                                                                             numWavelengths_(0)
+{
+    build(samples);
+}
+
+void MonotoneCubicSlopeTable::build(const SampleSet& samples)
+{
+    samples_ = &samples;
+
+    numAngles0_ = samples.getNumAngles0();
+    numAngles1_ = samples.getNumAngles1();
+    numAngles2_ = samples.getNumAngles2();
+    numAngles3_ = samples.getNumAngles3();
+    numWavelengths_ = samples.getNumWavelengths();
+
+    const Arrayf& angles3 = samples.getAngles3();
+    const bool periodic = isFullCircle(angles3);
+    const int numLines = numAngles0_ * numAngles1_ * numAngles2_;
+
+    slopes_.resize(numLines * numAngles3_ * numWavelengths_);
+
+    #pragma omp parallel for
+    for (int line = 0; line < numLines; ++line) {
+        int i0 = line % numAngles0_;
+        int i1 = (line / numAngles0_) % numAngles1_;
+        int i2 = line / (numAngles0_ * numAngles1_);
+
+        Arrayf values(numAngles3_), slopes(numAngles3_);
+        for (int i = 0; i < numWavelengths_; ++i) {
+            for (int i3 = 0; i3 < numAngles3_; ++i3) {
+                values[i3] = samples.getValue(samples.getIndex(i0, i1, i2, i3), i);
+            }
+
+            MonotoneCubicSpline::computeSlopes(angles3.data(), values.data(), numAngles3_, periodic,
+                                               slopes.data());
+
+            for (int i3 = 0; i3 < numAngles3_; ++i3) {
+                slopes_[(line + numLines * i3) * numWavelengths_ + i] = slopes[i3];
+            }
+        }
+    }
+}
+
+void MonotoneCubicSlopeTable::clear()
+{
+    samples_ = 0;
+    numAngles0_ = 0;
+    numAngles1_ = 0;
+    numAngles2_ = 0;
+    numAngles3_ = 0;
+    numWavelengths_ = 0;
+    slopes_.resize(0);
+}
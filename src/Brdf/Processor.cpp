@@ -9,6 +9,8 @@
 #include <libbsdf/Brdf/Processor.h>
 
 #include <iostream>
+#include <utility>
+#include <vector>
 
 #include <libbsdf/Brdf/Integrator.h>
 #include <libbsdf/Brdf/RandomSampleSet.h>
@@ -29,34 +31,47 @@ void lb::divideByCosineOutTheta(Brdf* brdf)
 {
     SampleSet* ss = brdf->getSampleSet();
 
+    const int numAngles3 = ss->getNumAngles3();
+    std::vector<Vec3, Eigen::aligned_allocator<Vec3> > inDirs(ss->getNumAngles2() * numAngles3);
+    std::vector<Vec3, Eigen::aligned_allocator<Vec3> > outDirs(ss->getNumAngles2() * numAngles3);
+
+    std::unique_ptr<DirectionTable> table = brdf->createDirectionTable();
+
     for (int i0 = 0; i0 < ss->getNumAngles0(); ++i0) {
     for (int i1 = 0; i1 < ss->getNumAngles1(); ++i1) {
-    for (int i2 = 0; i2 < ss->getNumAngles2(); ++i2) {
-    for (int i3 = 0; i3 < ss->getNumAngles3(); ++i3) {
-        Vec3 inDir, outDir;
-        brdf->getInOutDirection(i0, i1, i2, i3, &inDir, &outDir);
-        float cosOutTheta = outDir.dot(Vec3(0.0, 0.0, 1.0));
-
-        lb::Spectrum& sp = ss->getSpectrum(i0, i1, i2, i3);
-
-        // Copy the spectrum if the Z-component of the outgoing direction is zero or negative.
-        if (cosOutTheta <= 0.0f && i2 > 0) {
-            // Assume i2 is the index of the polar angle related to outgoing directions.
-            brdf->getInOutDirection(i0, i1, i2 - 1, i3, &inDir, &outDir);
-            sp = ss->getSpectrum(i0, i1, i2 - 1, i3);
-            cosOutTheta = outDir.dot(Vec3(0.0, 0.0, 1.0));
-        }
+        table->getInOutDirections(i0, i1, inDirs.data(), outDirs.data());
 
-        sp /= cosOutTheta;
-    }}}}
+        for (int i2 = 0; i2 < ss->getNumAngles2(); ++i2) {
+        for (int i3 = 0; i3 < ss->getNumStoredAngles3(); ++i3) {
+            const Vec3& outDir = outDirs[i3 + numAngles3 * i2];
+            float cosOutTheta = outDir.dot(Vec3(0.0, 0.0, 1.0));
+
+            SpectrumMap sp = ss->getSpectrum(i0, i1, i2, i3);
+
+            // Copy the spectrum if the Z-component of the outgoing direction is zero or negative.
+            if (cosOutTheta <= 0.0f && i2 > 0) {
+                // Assume i2 is the index of the polar angle related to outgoing directions.
+                const Vec3& prevOutDir = outDirs[i3 + numAngles3 * (i2 - 1)];
+                sp = ss->getSpectrum(i0, i1, i2 - 1, i3);
+                cosOutTheta = prevOutDir.dot(Vec3(0.0, 0.0, 1.0));
+            }
+
+            sp /= cosOutTheta;
+        }}
+    }}
 }
 
 SphericalCoordinatesBrdf* lb::fillSymmetricBrdf(SphericalCoordinatesBrdf* brdf)
+{
+    return fillSymmetricBrdf(*brdf).release();
+}
+
+std::unique_ptr<SphericalCoordinatesBrdf> lb::fillSymmetricBrdf(const SphericalCoordinatesBrdf& brdf)
 {
     RandomSampleSet<SphericalCoordinateSystem>::AngleList filledAngles;
 
-    for (int i = 0; i < brdf->getNumOutPhi(); ++i) {
-        float outPhi = brdf->getOutPhi(i);
+    for (int i = 0; i < brdf.getNumOutPhi(); ++i) {
+        float outPhi = brdf.getOutPhi(i);
         bool angleOmitted = (outPhi != 0.0f &&
                              !isEqual(outPhi, PI_F) &&
                              !isEqual(outPhi, 2.0f * PI_F));
@@ -65,30 +80,38 @@ SphericalCoordinatesBrdf* lb::fillSymmetricBrdf(SphericalCoordinatesBrdf* brdf)
         }
     }
 
-    const SampleSet* ss = brdf->getSampleSet();
+    const SampleSet* ss = brdf.getSampleSet();
 
-    SphericalCoordinatesBrdf* filledBrdf = new SphericalCoordinatesBrdf(brdf->getNumInTheta(),
-                                                                        brdf->getNumInPhi(),
-                                                                        brdf->getNumOutTheta(),
-                                                                        brdf->getNumOutPhi() + filledAngles.size(),
-                                                                        ss->getColorModel(),
-                                                                        ss->getNumWavelengths());
+    std::unique_ptr<SphericalCoordinatesBrdf> filledBrdf(
+        new SphericalCoordinatesBrdf(brdf.getNumInTheta(),
+                                     brdf.getNumInPhi(),
+                                     brdf.getNumOutTheta(),
+                                     brdf.getNumOutPhi() + filledAngles.size(),
+                                     ss->getColorModel(),
+                                     ss->getNumWavelengths()));
     SampleSet* filledSs = filledBrdf->getSampleSet();
 
     // Set angles.
     filledSs->getAngles0() = ss->getAngles0();
     filledSs->getAngles1() = ss->getAngles1();
     filledSs->getAngles2() = ss->getAngles2();
+
+    Arrayf outPhiAngles(filledBrdf->getNumOutPhi());
     for (int i = 0; i < filledBrdf->getNumOutPhi(); ++i) {
-        if (i < brdf->getNumOutPhi()) {
-            filledBrdf->setOutPhi(i, brdf->getOutPhi(i));
+        if (i < brdf.getNumOutPhi()) {
+            outPhiAngles[i] = brdf.getOutPhi(i);
         }
         else {
-            filledBrdf->setOutPhi(i, filledAngles.at(i - brdf->getNumOutPhi()));
+            outPhiAngles[i] = filledAngles.at(i - brdf.getNumOutPhi());
         }
     }
-    Arrayf& outPhiAngles = filledSs->getAngles3();
     std::sort(outPhiAngles.data(), outPhiAngles.data() + outPhiAngles.size());
+    filledBrdf->setOutPhiAngles(outPhiAngles);
+
+    // Spectra of filled angles are not stored.
+    if (ss->isOneSide()) {
+        filledSs->setSymmetry(PLANE_SYMMETRY, false);
+    }
 
     // Set wavelengths.
     for (int i = 0; i < filledSs->getNumWavelengths(); ++i) {
@@ -99,20 +122,20 @@ SphericalCoordinatesBrdf* lb::fillSymmetricBrdf(SphericalCoordinatesBrdf* brdf)
     for (int inThIndex  = 0; inThIndex  < filledBrdf->getNumInTheta();  ++inThIndex)  {
     for (int inPhIndex  = 0; inPhIndex  < filledBrdf->getNumInPhi();    ++inPhIndex)  {
     for (int outThIndex = 0; outThIndex < filledBrdf->getNumOutTheta(); ++outThIndex) {
-    for (int outPhIndex = 0; outPhIndex < filledBrdf->getNumOutPhi();   ++outPhIndex) {
+    for (int outPhIndex = 0; outPhIndex < filledSs->getNumStoredAngles3(); ++outPhIndex) {
         float outPhi = filledBrdf->getOutPhi(outPhIndex);
 
         // Find the corresponding index.
         int origIndex;
-        for (origIndex = 0; origIndex < brdf->getNumOutPhi(); ++origIndex) {
-            float origOutPhi = brdf->getOutPhi(origIndex);
+        for (origIndex = 0; origIndex < brdf.getNumOutPhi(); ++origIndex) {
+            float origOutPhi = brdf.getOutPhi(origIndex);
             bool outPhiEqual = (origOutPhi == outPhi ||
                                 isEqual(origOutPhi, SphericalCoordinateSystem::MAX_ANGLE3 - outPhi));
             if (outPhiEqual) break;
         }
 
-        Spectrum& sp = brdf->getSpectrum(inThIndex, inPhIndex, outThIndex, origIndex);
-        filledBrdf->setSpectrum(inThIndex, inPhIndex, outThIndex, outPhIndex, sp);
+        filledBrdf->getSpectrum(inThIndex, inPhIndex, outThIndex, outPhIndex)
+            = brdf.getSpectrum(inThIndex, inPhIndex, outThIndex, origIndex);
     }}}}
 
     return filledBrdf;
@@ -154,6 +177,12 @@ void lb::fillIncomingPolar0Data(Brdf* brdf)
 
 SphericalCoordinatesBrdf* lb::rotateOutPhi(const SphericalCoordinatesBrdf&  brdf,
                                            float                            rotationAngle)
+{
+    return rotateOutPhi(SphericalCoordinatesBrdf(brdf), rotationAngle).release();
+}
+
+std::unique_ptr<SphericalCoordinatesBrdf> lb::rotateOutPhi(SphericalCoordinatesBrdf&&  brdf,
+                                                           float                       rotationAngle)
 {
     assert(rotationAngle > -2.0f * PI_F && rotationAngle < 2.0f * PI_F);
 
@@ -161,22 +190,29 @@ SphericalCoordinatesBrdf* lb::rotateOutPhi(const SphericalCoordinatesBrdf&  brdf
         rotationAngle += 2.0f * PI_F;
     }
 
-    SphericalCoordinatesBrdf* rotatedBrdf = new SphericalCoordinatesBrdf(brdf);
+    // The original BRDF shares spectra with the rotated one until they are rotated.
+    const SphericalCoordinatesBrdf origBrdf(brdf);
+
+    std::unique_ptr<SphericalCoordinatesBrdf> rotatedBrdf(new SphericalCoordinatesBrdf(std::move(brdf)));
     SampleSet* ss = rotatedBrdf->getSampleSet();
 
+    // Rotated spectra are not symmetric.
+    ss->setSymmetry(NO_SYMMETRY);
+
     ss->updateAngleAttributes();
     if (!ss->isEqualIntervalAngles3()) {
+        Arrayf outPhiAngles(rotatedBrdf->getNumOutPhi());
         for (int i = 0; i < rotatedBrdf->getNumOutPhi(); ++i) {
             float outPhi = rotatedBrdf->getOutPhi(i) + rotationAngle;
             if (outPhi > 2.0f * PI_F) {
                 outPhi -= 2.0f * PI_F;
             }
 
-            rotatedBrdf->setOutPhi(i, outPhi);
+            outPhiAngles[i] = outPhi;
         }
 
-        Arrayf& outPhiAngles = ss->getAngles3();
         std::sort(outPhiAngles.data(), outPhiAngles.data() + outPhiAngles.size());
+        rotatedBrdf->setOutPhiAngles(outPhiAngles);
     }
 
     for (int inThIndex  = 0; inThIndex  < rotatedBrdf->getNumInTheta();  ++inThIndex)  {
@@ -192,7 +228,7 @@ SphericalCoordinatesBrdf* lb::rotateOutPhi(const SphericalCoordinatesBrdf&  brdf
             outPhi += 2.0f * PI_F;
         }
 
-        Spectrum sp = brdf.getSpectrum(inTheta, inPhi, outTheta, outPhi);
+        Spectrum sp = origBrdf.getSpectrum(inTheta, inPhi, outTheta, outPhi);
         rotatedBrdf->setSpectrum(inThIndex, inPhIndex, outThIndex, outPhIndex, sp);
     }}}}
 
@@ -225,8 +261,8 @@ void lb::fixEnergyConservation(SpecularCoordinatesBrdf* brdf)
         float maxReflectance = sp.maxCoeff();
         if (maxReflectance > 1.0f) {
             for (int i2 = 0; i2 < ss->getNumAngles2(); ++i2) {
-            for (int i3 = 0; i3 < ss->getNumAngles3(); ++i3) {
-                Spectrum& fixedSp = ss->getSpectrum(inThIndex, inPhIndex, i2, i3);
+            for (int i3 = 0; i3 < ss->getNumStoredAngles3(); ++i3) {
+                SpectrumMap fixedSp = ss->getSpectrum(inThIndex, inPhIndex, i2, i3);
                 const float coeff = 0.999546f; // Reflectance of Lambertian using lb::Integrator.
                 fixedSp /= maxReflectance / coeff;
             }}
@@ -244,8 +280,7 @@ void lb::copySpectraFromPhiOfZeroTo2PI(Brdf* brdf)
         for (int i0 = 0; i0 < ss->getNumAngles0(); ++i0) {
         for (int i2 = 0; i2 < ss->getNumAngles2(); ++i2) {
         for (int i3 = 0; i3 < ss->getNumAngles3(); ++i3) {
-            const Spectrum& sp = ss->getSpectrum(i0, 0, i2, i3);
-            ss->setSpectrum(i0, ss->getNumAngles1() - 1, i2, i3, sp);
+            ss->getSpectrum(i0, ss->getNumAngles1() - 1, i2, i3) = ss->getSpectrum(i0, 0, i2, i3);
         }}}
     }
 
@@ -255,8 +290,7 @@ void lb::copySpectraFromPhiOfZeroTo2PI(Brdf* brdf)
         for (int i0 = 0; i0 < ss->getNumAngles0(); ++i0) {
         for (int i1 = 0; i1 < ss->getNumAngles1(); ++i1) {
         for (int i2 = 0; i2 < ss->getNumAngles2(); ++i2) {
-            const Spectrum& sp = ss->getSpectrum(i0, i1, i2, 0);
-            ss->setSpectrum(i0, i1, i2, ss->getNumAngles3() - 1, sp);
+            ss->getSpectrum(i0, i1, i2, ss->getNumAngles3() - 1) = ss->getSpectrum(i0, i1, i2, 0);
         }}}
     }
 }
@@ -272,10 +306,9 @@ void lb::xyzToSrgb(SampleSet* samples)
     for (int i0 = 0; i0 < samples->getNumAngles0(); ++i0) {
     for (int i1 = 0; i1 < samples->getNumAngles1(); ++i1) {
     for (int i2 = 0; i2 < samples->getNumAngles2(); ++i2) {
-    for (int i3 = 0; i3 < samples->getNumAngles3(); ++i3) {
-        const Spectrum& xyz = samples->getSpectrum(i0, i1, i2, i3);
-        Spectrum rgb = xyzToSrgb(xyz);
-        samples->setSpectrum(i0, i1, i2, i3, rgb);
+    for (int i3 = 0; i3 < samples->getNumStoredAngles3(); ++i3) {
+        SpectrumMap sp = samples->getSpectrum(i0, i1, i2, i3);
+        sp = xyzToSrgb(sp.matrix()).array();
     }}}}
 
     samples->setColorModel(RGB_MODEL);
@@ -283,7 +316,7 @@ void lb::xyzToSrgb(SampleSet* samples)
 
 void lb::fillSpectra(SampleSet* samples, Spectrum::Scalar value)
 {
-    fillSpectra(samples->getSpectra(), value);
+    samples->getSpectra().fill(value);
 }
 
 void lb::fillSpectra(SpectrumList& spectra, Spectrum::Scalar value)
@@ -295,16 +328,11 @@ void lb::fillSpectra(SpectrumList& spectra, Spectrum::Scalar value)
 
 void lb::multiplySpectra(SampleSet* samples, Spectrum::Scalar value)
 {
-    lb::SpectrumList& spectra = samples->getSpectra();
-    for (auto it = spectra.begin(); it != spectra.end(); ++it) {
-        *it *= value;
-    }
+    samples->getSpectra() *= value;
 }
 
 void lb::fixNegativeSpectra(SampleSet* samples)
 {
-    lb::SpectrumList& spectra = samples->getSpectra();
-    for (auto it = spectra.begin(); it != spectra.end(); ++it) {
-        *it = it->cwiseMax(0.0f);
-    }
+    ArrayfMap spectra = samples->getSpectra();
+    spectra = spectra.cwiseMax(0.0f);
 }
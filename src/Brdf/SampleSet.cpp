@@ -9,20 +9,29 @@
 #include <libbsdf/Brdf/SampleSet.h>
 
 #include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <utility>
 
 #include <libbsdf/Common/Utility.h>
 #include <libbsdf/Common/SpectrumUtility.h>
 
 using namespace lb;
 
-SampleSet::SampleSet(int        numAngles0,
-                     int        numAngles1,
-                     int        numAngles2,
-                     int        numAngles3,
-                     ColorModel colorModel,
-                     int        numWavelengths)
-                     : equalIntervalAngles0_(false),
+SampleSet::SampleSet(int            numAngles0,
+                     int            numAngles1,
+                     int            numAngles2,
+                     int            numAngles3,
+                     ColorModel     colorModel,
+                     int            numWavelengths,
+                     SpectrumLayout spectrumLayout,
+                     bool           spectraAllocated)
+                     : spectra_(0),
+                       compactSpectra_(0),
+                       spectrumLayout_(spectrumLayout),
+                       spectrumPrecision_(SINGLE_PRECISION),
+                       symmetry_(NO_SYMMETRY),
+                       equalIntervalAngles0_(false),
                        equalIntervalAngles1_(false),
                        equalIntervalAngles2_(false),
                        equalIntervalAngles3_(false),
@@ -30,21 +39,138 @@ SampleSet::SampleSet(int        numAngles0,
 {
     assert(numAngles0 > 0 && numAngles1 > 0 && numAngles2 > 0 && numAngles3 > 0);
 
-    resizeAngles(numAngles0, numAngles1, numAngles2, numAngles3);
+    numAngles0_ = numAngles0;
+    numAngles1_ = numAngles1;
+    numAngles2_ = numAngles2;
+    numAngles3_ = numAngles3;
+    numStoredAngles3_ = numAngles3;
+
+    angles0_.resize(numAngles0);
+    angles1_.resize(numAngles1);
+    angles2_.resize(numAngles2);
+    angles3_.resize(numAngles3);
 
     colorModel_ = colorModel;
 
     if (colorModel == SPECTRAL_MODEL) {
-        resizeWavelengths(numWavelengths);
+        assert(numWavelengths > 0);
+        wavelengths_.resize(numWavelengths);
     }
     else if (colorModel == MONOCHROMATIC_MODEL) {
-        resizeWavelengths(1);
         wavelengths_ = Arrayf::Zero(1);
     }
     else {
-        resizeWavelengths(3);
         wavelengths_ = Arrayf::Zero(3);
     }
+
+    if (spectraAllocated) {
+        allocateSpectra();
+    }
+}
+
+SampleSet::SampleSet(const SampleSet& samples)
+                     : spectra_(samples.spectra_),
+                       compactSpectra_(samples.compactSpectra_),
+                       spectraStorage_(samples.spectraStorage_),
+                       spectrumLayout_(samples.spectrumLayout_),
+                       spectrumPrecision_(samples.spectrumPrecision_),
+                       symmetry_(samples.symmetry_),
+                       storedIndices3_(samples.storedIndices3_),
+                       numStoredAngles3_(samples.numStoredAngles3_),
+                       angles0_(samples.angles0_),
+                       angles1_(samples.angles1_),
+                       angles2_(samples.angles2_),
+                       angles3_(samples.angles3_),
+                       numAngles0_(samples.numAngles0_),
+                       numAngles1_(samples.numAngles1_),
+                       numAngles2_(samples.numAngles2_),
+                       numAngles3_(samples.numAngles3_),
+                       equalIntervalAngles0_(samples.equalIntervalAngles0_),
+                       equalIntervalAngles1_(samples.equalIntervalAngles1_),
+                       equalIntervalAngles2_(samples.equalIntervalAngles2_),
+                       equalIntervalAngles3_(samples.equalIntervalAngles3_),
+                       angleLookupTable0_(samples.angleLookupTable0_),
+                       angleLookupTable1_(samples.angleLookupTable1_),
+                       angleLookupTable2_(samples.angleLookupTable2_),
+                       angleLookupTable3_(samples.angleLookupTable3_),
+                       colorModel_(samples.colorModel_),
+                       wavelengths_(samples.wavelengths_),
+                       oneSide_(samples.oneSide_) {}
+
+SampleSet::SampleSet(SampleSet&& samples)
+                     : spectra_(samples.spectra_),
+                       compactSpectra_(samples.compactSpectra_),
+                       spectraStorage_(std::move(samples.spectraStorage_)),
+                       spectrumLayout_(samples.spectrumLayout_),
+                       spectrumPrecision_(samples.spectrumPrecision_),
+                       symmetry_(samples.symmetry_),
+                       storedIndices3_(std::move(samples.storedIndices3_)),
+                       numStoredAngles3_(samples.numStoredAngles3_),
+                       angles0_(std::move(samples.angles0_)),
+                       angles1_(std::move(samples.angles1_)),
+                       angles2_(std::move(samples.angles2_)),
+                       angles3_(std::move(samples.angles3_)),
+                       numAngles0_(samples.numAngles0_),
+                       numAngles1_(samples.numAngles1_),
+                       numAngles2_(samples.numAngles2_),
+                       numAngles3_(samples.numAngles3_),
+                       equalIntervalAngles0_(samples.equalIntervalAngles0_),
+                       equalIntervalAngles1_(samples.equalIntervalAngles1_),
+                       equalIntervalAngles2_(samples.equalIntervalAngles2_),
+                       equalIntervalAngles3_(samples.equalIntervalAngles3_),
+                       angleLookupTable0_(std::move(samples.angleLookupTable0_)),
+                       angleLookupTable1_(std::move(samples.angleLookupTable1_)),
+                       angleLookupTable2_(std::move(samples.angleLookupTable2_)),
+                       angleLookupTable3_(std::move(samples.angleLookupTable3_)),
+                       colorModel_(samples.colorModel_),
+                       wavelengths_(std::move(samples.wavelengths_)),
+                       oneSide_(samples.oneSide_)
+{
+    samples.spectra_ = 0;
+    samples.compactSpectra_ = 0;
+}
+
+SampleSet& SampleSet::operator=(SampleSet&& samples)
+{
+    if (this == &samples) return *this;
+
+    spectra_            = samples.spectra_;
+    compactSpectra_     = samples.compactSpectra_;
+    spectraStorage_     = std::move(samples.spectraStorage_);
+    spectrumLayout_     = samples.spectrumLayout_;
+    spectrumPrecision_  = samples.spectrumPrecision_;
+    symmetry_           = samples.symmetry_;
+    storedIndices3_     = std::move(samples.storedIndices3_);
+    numStoredAngles3_   = samples.numStoredAngles3_;
+
+    angles0_ = std::move(samples.angles0_);
+    angles1_ = std::move(samples.angles1_);
+    angles2_ = std::move(samples.angles2_);
+    angles3_ = std::move(samples.angles3_);
+
+    numAngles0_ = samples.numAngles0_;
+    numAngles1_ = samples.numAngles1_;
+    numAngles2_ = samples.numAngles2_;
+    numAngles3_ = samples.numAngles3_;
+
+    equalIntervalAngles0_ = samples.equalIntervalAngles0_;
+    equalIntervalAngles1_ = samples.equalIntervalAngles1_;
+    equalIntervalAngles2_ = samples.equalIntervalAngles2_;
+    equalIntervalAngles3_ = samples.equalIntervalAngles3_;
+
+    angleLookupTable0_ = std::move(samples.angleLookupTable0_);
+    angleLookupTable1_ = std::move(samples.angleLookupTable1_);
+    angleLookupTable2_ = std::move(samples.angleLookupTable2_);
+    angleLookupTable3_ = std::move(samples.angleLookupTable3_);
+
+    colorModel_     = samples.colorModel_;
+    wavelengths_    = std::move(samples.wavelengths_);
+    oneSide_        = samples.oneSide_;
+
+    samples.spectra_ = 0;
+    samples.compactSpectra_ = 0;
+
+    return *this;
 }
 
 bool SampleSet::validate() const
@@ -53,11 +179,12 @@ bool SampleSet::validate() const
 
     // Spectra
     bool spectraValid = true;
+    Spectrum sp;
     for (int i0 = 0; i0 < numAngles0_; ++i0) {
     for (int i1 = 0; i1 < numAngles1_; ++i1) {
     for (int i2 = 0; i2 < numAngles2_; ++i2) {
     for (int i3 = 0; i3 < numAngles3_; ++i3) {
-        const Spectrum& sp = getSpectrum(i0, i1, i2, i3);
+        getSpectrum(getIndex(i0, i1, i2, i3), &sp);
         
         if (!sp.allFinite()) {
             spectraValid = false;
@@ -132,6 +259,7 @@ bool SampleSet::validate() const
 void SampleSet::updateAngleAttributes()
 {
     updateEqualIntervalAngles();
+    updateAngleLookupTables();
     updateOneSide();
 }
 
@@ -147,28 +275,347 @@ void SampleSet::resizeAngles(int numAngles0,
     numAngles2_ = numAngles2;
     numAngles3_ = numAngles3;
 
-    int numSamples = numAngles0 * numAngles1 * numAngles2 * numAngles3;
-    spectra_.resize(numSamples);
+    symmetry_ = NO_SYMMETRY;
+    std::vector<int>().swap(storedIndices3_);
+    numStoredAngles3_ = numAngles3;
+
+    allocateSpectra();
 
     angles0_.resize(numAngles0);
     angles1_.resize(numAngles1);
     angles2_.resize(numAngles2);
     angles3_.resize(numAngles3);
+
+    angleLookupTable0_.clear();
+    angleLookupTable1_.clear();
+    angleLookupTable2_.clear();
+    angleLookupTable3_.clear();
 }
 
 void SampleSet::resizeWavelengths(int numWavelengths)
 {
     assert(numWavelengths > 0);
 
-    int numSamples = numAngles0_ * numAngles1_ * numAngles2_ * numAngles3_;
+    wavelengths_.resize(numWavelengths);
+
+    allocateSpectra();
+}
 
-    for (int i = 0; i < numSamples; ++i) {
-        Spectrum sp;
-        sp.resize(numWavelengths);
-        spectra_.at(i) = sp;
+void SampleSet::insertAngles(const Arrayf& insertedAngles0,
+                             const Arrayf& insertedAngles1,
+                             const Arrayf& insertedAngles2,
+                             const Arrayf& insertedAngles3)
+{
+    if (insertedAngles0.size() == 0 &&
+        insertedAngles1.size() == 0 &&
+        insertedAngles2.size() == 0 &&
+        insertedAngles3.size() == 0) {
+        return;
     }
 
-    wavelengths_.resize(numWavelengths);
+    if (symmetry_ != NO_SYMMETRY) {
+        setSymmetry(NO_SYMMETRY);
+    }
+
+    // The original sample set shares spectra until new spectra are allocated.
+    const SampleSet origSamples(*this);
+
+    std::vector<int> indices0, indices1, indices2, indices3;
+    mergeAngles(origSamples.angles0_, insertedAngles0, &angles0_, &indices0);
+    mergeAngles(origSamples.angles1_, insertedAngles1, &angles1_, &indices1);
+    mergeAngles(origSamples.angles2_, insertedAngles2, &angles2_, &indices2);
+    mergeAngles(origSamples.angles3_, insertedAngles3, &angles3_, &indices3);
+
+    numAngles0_ = angles0_.size();
+    numAngles1_ = angles1_.size();
+    numAngles2_ = angles2_.size();
+    numAngles3_ = angles3_.size();
+    numStoredAngles3_ = numAngles3_;
+
+    allocateSpectra();
+
+    Spectrum sp;
+    for (int i0 = 0; i0 < origSamples.numAngles0_; ++i0) {
+    for (int i1 = 0; i1 < origSamples.numAngles1_; ++i1) {
+    for (int i2 = 0; i2 < origSamples.numAngles2_; ++i2) {
+    for (int i3 = 0; i3 < origSamples.numAngles3_; ++i3) {
+        origSamples.getSpectrum(origSamples.getIndex(i0, i1, i2, i3), &sp);
+        getSpectrum(indices0[i0], indices1[i1], indices2[i2], indices3[i3]) = sp;
+    }}}}
+
+    updateAngleAttributes();
+}
+
+void SampleSet::setExternalSpectra(float*                          spectra,
+                                   SpectrumLayout                  spectrumLayout,
+                                   const std::shared_ptr<void>&    storage)
+{
+    assert(spectra);
+
+    spectra_ = spectra;
+    compactSpectra_ = 0;
+    spectraStorage_ = storage;
+    spectrumLayout_ = spectrumLayout;
+    spectrumPrecision_ = SINGLE_PRECISION;
+}
+
+void SampleSet::setExternalSpectra(const uint16_t*                 spectra,
+                                   SpectrumLayout                  spectrumLayout,
+                                   SpectrumPrecision               spectrumPrecision,
+                                   const std::shared_ptr<void>&    storage)
+{
+    assert(spectra);
+    assert(spectrumPrecision != SINGLE_PRECISION);
+
+    spectra_ = 0;
+    compactSpectra_ = spectra;
+    spectraStorage_ = storage;
+    spectrumLayout_ = spectrumLayout;
+    spectrumPrecision_ = spectrumPrecision;
+}
+
+void SampleSet::setSpectrumLayout(SpectrumLayout spectrumLayout)
+{
+    if (spectrumLayout == spectrumLayout_) return;
+
+    // Compact spectra are converted through single precision without loss.
+    SpectrumPrecision spectrumPrecision = spectrumPrecision_;
+    setSpectrumPrecision(SINGLE_PRECISION);
+
+    int numSamples = getNumSamples();
+    int numWavelengths = getNumWavelengths();
+
+    // Interleaved spectra are a column-major matrix of wavelengths by sample points,
+    // and planar spectra are its transpose.
+    typedef Eigen::Map<Eigen::MatrixXf> MatrixMap;
+    typedef Eigen::Map<const Eigen::MatrixXf> ConstMatrixMap;
+
+    std::shared_ptr<Arrayf> converted = std::make_shared<Arrayf>(numSamples * numWavelengths);
+    if (spectrumLayout == PLANAR_LAYOUT) {
+        MatrixMap(converted->data(), numSamples, numWavelengths)
+            = ConstMatrixMap(spectra_, numWavelengths, numSamples).transpose();
+    }
+    else {
+        MatrixMap(converted->data(), numWavelengths, numSamples)
+            = ConstMatrixMap(spectra_, numSamples, numWavelengths).transpose();
+    }
+
+    spectra_ = converted->data();
+    spectraStorage_ = converted;
+    spectrumLayout_ = spectrumLayout;
+
+    setSpectrumPrecision(spectrumPrecision);
+}
+
+void SampleSet::setSpectrumPrecision(SpectrumPrecision  spectrumPrecision,
+                                     float*             maxError,
+                                     float*             rmsError)
+{
+    if (maxError) *maxError = 0.0f;
+    if (rmsError) *rmsError = 0.0f;
+
+    if (spectrumPrecision == spectrumPrecision_) return;
+
+    int size = getNumSamples() * getNumWavelengths();
+
+    if (spectrumPrecision_ != SINGLE_PRECISION) {
+        std::shared_ptr<Arrayf> spectra = std::make_shared<Arrayf>(size);
+        for (int i = 0; i < size; ++i) {
+            (*spectra)[i] = toFloat(compactSpectra_[i], spectrumPrecision_);
+        }
+
+        spectra_ = spectra->data();
+        compactSpectra_ = 0;
+        spectraStorage_ = spectra;
+        spectrumPrecision_ = SINGLE_PRECISION;
+    }
+
+    if (spectrumPrecision == SINGLE_PRECISION) return;
+
+    double maxErr = 0.0;
+    double sumSqErr = 0.0;
+
+    std::shared_ptr<std::vector<uint16_t> > compactSpectra = std::make_shared<std::vector<uint16_t> >(size);
+    for (int i = 0; i < size; ++i) {
+        uint16_t value = fromFloat(spectra_[i], spectrumPrecision);
+        (*compactSpectra)[i] = value;
+
+        double err = std::abs(static_cast<double>(toFloat(value, spectrumPrecision)) - spectra_[i]);
+        maxErr = std::max(maxErr, err);
+        sumSqErr += err * err;
+    }
+
+    if (maxError) {
+        *maxError = static_cast<float>(maxErr);
+    }
+
+    if (rmsError && size > 0) {
+        *rmsError = static_cast<float>(std::sqrt(sumSqErr / size));
+    }
+
+    spectra_ = 0;
+    compactSpectra_ = compactSpectra->data();
+    spectraStorage_ = compactSpectra;
+    spectrumPrecision_ = spectrumPrecision;
+}
+
+bool SampleSet::setSymmetry(SymmetryType symmetry, bool convertSpectra)
+{
+    std::vector<int> storedIndices3;
+    int numStoredAngles3 = numAngles3_;
+
+    if (symmetry == PLANE_SYMMETRY &&
+        !computePlaneSymmetricIndices(&storedIndices3, &numStoredAngles3)) {
+        std::cerr << "[SampleSet::setSymmetry] Angle3 are not plane symmetric." << std::endl;
+        return false;
+    }
+
+    if (symmetry == symmetry_ && storedIndices3 == storedIndices3_) return true;
+
+    if (!convertSpectra) {
+        symmetry_ = symmetry;
+        storedIndices3_.swap(storedIndices3);
+        numStoredAngles3_ = numStoredAngles3;
+
+        if (spectra_ || compactSpectra_) {
+            allocateSpectra();
+        }
+        return true;
+    }
+
+    // Compact spectra are converted through single precision without loss.
+    SpectrumPrecision spectrumPrecision = spectrumPrecision_;
+    setSpectrumPrecision(SINGLE_PRECISION);
+
+    std::shared_ptr<void> origStorage = spectraStorage_;
+    const float* origSpectra = spectra_;
+    int origSampleStride = getSampleStride();
+    int origWavelengthStride = getWavelengthStride();
+    SymmetryType origSymmetry = symmetry_;
+    std::vector<int> origStoredIndices3;
+    origStoredIndices3.swap(storedIndices3_);
+
+    symmetry_ = symmetry;
+    storedIndices3_.swap(storedIndices3);
+    numStoredAngles3_ = numStoredAngles3;
+
+    allocateSpectra();
+
+    int sampleStride = getSampleStride();
+    int wavelengthStride = getWavelengthStride();
+    int numWavelengths = getNumWavelengths();
+
+    // Stored angles3 are the leading angles3, so their indices are not mapped in the new array.
+    for (int i0 = 0; i0 < numAngles0_; ++i0) {
+    for (int i1 = 0; i1 < numAngles1_; ++i1) {
+    for (int i2 = 0; i2 < numAngles2_; ++i2) {
+    for (int i3 = 0; i3 < numStoredAngles3_; ++i3) {
+        int origIndex3 = (origSymmetry == PLANE_SYMMETRY) ? origStoredIndices3[i3] : i3;
+
+        int baseIndex = i0 + numAngles0_ * i1 + numAngles0_ * numAngles1_ * i2;
+        int index = baseIndex + numAngles0_ * numAngles1_ * numAngles2_ * i3;
+        int origIndex = baseIndex + numAngles0_ * numAngles1_ * numAngles2_ * origIndex3;
+
+        for (int i = 0; i < numWavelengths; ++i) {
+            spectra_[index * sampleStride + i * wavelengthStride]
+                = origSpectra[origIndex * origSampleStride + i * origWavelengthStride];
+        }
+    }}}}
+
+    setSpectrumPrecision(spectrumPrecision);
+
+    return true;
+}
+
+bool SampleSet::computePlaneSymmetricIndices(std::vector<int>* storedIndices3, int* numStoredAngles3) const
+{
+    int numStored = 0;
+    while (numStored < numAngles3_ &&
+           (angles3_[numStored] < PI_F || isEqual(angles3_[numStored], PI_F))) {
+        ++numStored;
+    }
+
+    if (numStored == 0) return false;
+
+    storedIndices3->resize(numAngles3_);
+    for (int i = 0; i < numAngles3_; ++i) {
+        if (i < numStored) {
+            (*storedIndices3)[i] = i;
+            continue;
+        }
+
+        // Find the mirrored angle.
+        int mirroredIndex = -1;
+        for (int j = 0; j < numStored; ++j) {
+            if (isEqual(angles3_[i] + angles3_[j], 2.0f * PI_F)) {
+                mirroredIndex = j;
+                break;
+            }
+        }
+
+        if (mirroredIndex == -1) return false;
+
+        (*storedIndices3)[i] = mirroredIndex;
+    }
+
+    *numStoredAngles3 = numStored;
+
+    return true;
+}
+
+void SampleSet::allocateSpectra()
+{
+    std::shared_ptr<Arrayf> spectra = std::make_shared<Arrayf>(getNumSamples() * getNumWavelengths());
+
+    spectra_ = spectra->data();
+    compactSpectra_ = 0;
+    spectraStorage_ = spectra;
+    spectrumPrecision_ = SINGLE_PRECISION;
+}
+
+void SampleSet::detachSpectra()
+{
+    int size = getNumSamples() * getNumWavelengths();
+
+    if (spectrumPrecision_ == SINGLE_PRECISION) {
+        std::shared_ptr<Arrayf> spectra = std::make_shared<Arrayf>(ConstArrayfMap(spectra_, size));
+        spectra_ = spectra->data();
+        spectraStorage_ = spectra;
+    }
+    else {
+        std::shared_ptr<std::vector<uint16_t> > compactSpectra
+            = std::make_shared<std::vector<uint16_t> >(compactSpectra_, compactSpectra_ + size);
+        compactSpectra_ = compactSpectra->data();
+        spectraStorage_ = compactSpectra;
+    }
+}
+
+void SampleSet::mergeAngles(const Arrayf&     angles,
+                            const Arrayf&     insertedAngles,
+                            Arrayf*           mergedAngles,
+                            std::vector<int>* indices)
+{
+    Arrayf merged(angles.size() + insertedAngles.size());
+    indices->resize(angles.size());
+
+    int i = 0;
+    int insertedIndex = 0;
+    for (int mergedIndex = 0; mergedIndex < merged.size(); ++mergedIndex) {
+        bool inserted = (i == angles.size() ||
+                         (insertedIndex < insertedAngles.size() &&
+                          insertedAngles[insertedIndex] < angles[i]));
+        if (inserted) {
+            merged[mergedIndex] = insertedAngles[insertedIndex];
+            ++insertedIndex;
+        }
+        else {
+            merged[mergedIndex] = angles[i];
+            (*indices)[i] = mergedIndex;
+            ++i;
+        }
+    }
+
+    *mergedAngles = merged;
 }
 
 void SampleSet::updateEqualIntervalAngles()
@@ -177,11 +624,14 @@ void SampleSet::updateEqualIntervalAngles()
     equalIntervalAngles1_ = isEqualInterval(angles1_);
     equalIntervalAngles2_ = isEqualInterval(angles2_);
     equalIntervalAngles3_ = isEqualInterval(angles3_);
+}
 
-    std::cout << "[SampleSet::updateEqualIntervalAngles] Angle0: " << equalIntervalAngles0_ << std::endl;
-    std::cout << "[SampleSet::updateEqualIntervalAngles] Angle1: " << equalIntervalAngles1_ << std::endl;
-    std::cout << "[SampleSet::updateEqualIntervalAngles] Angle2: " << equalIntervalAngles2_ << std::endl;
-    std::cout << "[SampleSet::updateEqualIntervalAngles] Angle3: " << equalIntervalAngles3_ << std::endl;
+void SampleSet::updateAngleLookupTables()
+{
+    angleLookupTable0_.build(angles0_);
+    angleLookupTable1_.build(angles1_);
+    angleLookupTable2_.build(angles2_);
+    angleLookupTable3_.build(angles3_);
 }
 
 void SampleSet::updateOneSide()
@@ -202,6 +652,4 @@ void SampleSet::updateOneSide()
     }
 
     oneSide_ = (!contain_0_PI || !contain_PI_2PI);
-
-    std::cout << "[SampleSet::updateOneSide] " << oneSide_ << std::endl;
 }
@@ -11,6 +11,7 @@
 #include <libbsdf/Brdf/Sampler.h>
 
 #include <iostream>
+#include <utility>
 
 using namespace lb;
 
@@ -65,6 +66,62 @@ SampleSet2D::SampleSet2D(int        numTheta,
     }
 }
 
+SampleSet2D::SampleSet2D(const SampleSet2D& samples)
+                         : spectra_(samples.spectra_),
+                           thetaAngles_(samples.thetaAngles_),
+                           phiAngles_(samples.phiAngles_),
+                           numTheta_(samples.numTheta_),
+                           numPhi_(samples.numPhi_),
+                           equalIntervalTheta_(samples.equalIntervalTheta_),
+                           equalIntervalPhi_(samples.equalIntervalPhi_),
+                           thetaLookupTable_(samples.thetaLookupTable_),
+                           phiLookupTable_(samples.phiLookupTable_),
+                           colorModel_(samples.colorModel_),
+                           wavelengths_(samples.wavelengths_) {}
+
+SampleSet2D::SampleSet2D(SampleSet2D&& samples)
+                         : spectra_(std::move(samples.spectra_)),
+                           thetaAngles_(std::move(samples.thetaAngles_)),
+                           phiAngles_(std::move(samples.phiAngles_)),
+                           numTheta_(samples.numTheta_),
+                           numPhi_(samples.numPhi_),
+                           equalIntervalTheta_(samples.equalIntervalTheta_),
+                           equalIntervalPhi_(samples.equalIntervalPhi_),
+                           thetaLookupTable_(std::move(samples.thetaLookupTable_)),
+                           phiLookupTable_(std::move(samples.phiLookupTable_)),
+                           colorModel_(samples.colorModel_),
+                           wavelengths_(std::move(samples.wavelengths_)) {}
+
+SampleSet2D& SampleSet2D::operator=(const SampleSet2D& samples)
+{
+    SampleSet2D copiedSamples(samples);
+    *this = std::move(copiedSamples);
+    return *this;
+}
+
+SampleSet2D& SampleSet2D::operator=(SampleSet2D&& samples)
+{
+    if (this == &samples) return *this;
+
+    spectra_     = std::move(samples.spectra_);
+    thetaAngles_ = std::move(samples.thetaAngles_);
+    phiAngles_   = std::move(samples.phiAngles_);
+
+    numTheta_ = samples.numTheta_;
+    numPhi_   = samples.numPhi_;
+
+    equalIntervalTheta_ = samples.equalIntervalTheta_;
+    equalIntervalPhi_   = samples.equalIntervalPhi_;
+
+    thetaLookupTable_ = std::move(samples.thetaLookupTable_);
+    phiLookupTable_   = std::move(samples.phiLookupTable_);
+
+    colorModel_  = samples.colorModel_;
+    wavelengths_ = std::move(samples.wavelengths_);
+
+    return *this;
+}
+
 Spectrum SampleSet2D::getSpectrum(const Vec3& inDir) const
 {
     Spectrum sp;
@@ -77,8 +134,8 @@ void SampleSet2D::updateAngleAttributes()
     equalIntervalTheta_ = isEqualInterval(thetaAngles_);
     equalIntervalPhi_   = isEqualInterval(phiAngles_);
 
-    std::cout << "[SampleSet2D::updateAngleAttributes] Theta: " << equalIntervalTheta_ << std::endl;
-    std::cout << "[SampleSet2D::updateAngleAttributes] Phi: "   << equalIntervalPhi_   << std::endl;
+    thetaLookupTable_.build(thetaAngles_);
+    phiLookupTable_.build(phiAngles_);
 }
 
 void SampleSet2D::clampAngles()
@@ -24,6 +24,11 @@ bool Sampler::isIsotropic(const SampleSet2D& ss2)
     return ss2.isIsotropic();
 }
 
+int Sampler::getNumWavelengths(const SampleSet& samples)
+{
+    return samples.getNumWavelengths();
+}
+
 const SampleSet* Sampler::getSampleSet(const Brdf& brdf)
 {
     return brdf.getSampleSet();
@@ -8,6 +8,8 @@
 
 #include <libbsdf/Brdf/SpecularCoordinatesBrdf.h>
 
+#include <libbsdf/Brdf/CoordinatesBrdfSlice.h>
+
 using namespace lb;
 
 SpecularCoordinatesBrdf::SpecularCoordinatesBrdf(int        numInTheta,
@@ -50,9 +52,23 @@ SpecularCoordinatesBrdf::SpecularCoordinatesBrdf(const Brdf&    brdf,
 SpecularCoordinatesBrdf::SpecularCoordinatesBrdf(const SpecularCoordinatesBrdf& brdf)
                                                  : BaseBrdf(brdf) {}
 
+SpecularCoordinatesBrdf::SpecularCoordinatesBrdf(SpecularCoordinatesBrdf&& brdf)
+                                                 : BaseBrdf(std::move(brdf)) {}
+
+SpecularCoordinatesBrdf& SpecularCoordinatesBrdf::operator=(SpecularCoordinatesBrdf&& brdf)
+{
+    BaseBrdf::operator=(std::move(brdf));
+    return *this;
+}
+
 SpecularCoordinatesBrdf::~SpecularCoordinatesBrdf() {}
 
 SpecularCoordinatesBrdf* SpecularCoordinatesBrdf::clone() const
 {
     return new SpecularCoordinatesBrdf(*this);
 }
+
+std::unique_ptr<BrdfSlice> SpecularCoordinatesBrdf::bindIncoming(const Vec3& inDir) const
+{
+    return std::unique_ptr<BrdfSlice>(new CoordinatesBrdfSlice<CoordSys>(*this, inDir));
+}
@@ -8,6 +8,8 @@
 
 #include <libbsdf/Brdf/SphericalCoordinatesBrdf.h>
 
+#include <libbsdf/Brdf/CoordinatesBrdfSlice.h>
+
 using namespace lb;
 
 SphericalCoordinatesBrdf::SphericalCoordinatesBrdf(int          numInTheta,
@@ -50,9 +52,23 @@ SphericalCoordinatesBrdf::SphericalCoordinatesBrdf(const Brdf&  brdf,
 SphericalCoordinatesBrdf::SphericalCoordinatesBrdf(const SphericalCoordinatesBrdf& brdf)
                                                    : BaseBrdf(brdf) {}
 
+SphericalCoordinatesBrdf::SphericalCoordinatesBrdf(SphericalCoordinatesBrdf&& brdf)
+                                                   : BaseBrdf(std::move(brdf)) {}
+
+SphericalCoordinatesBrdf& SphericalCoordinatesBrdf::operator=(SphericalCoordinatesBrdf&& brdf)
+{
+    BaseBrdf::operator=(std::move(brdf));
+    return *this;
+}
+
 SphericalCoordinatesBrdf::~SphericalCoordinatesBrdf() {}
 
 SphericalCoordinatesBrdf* SphericalCoordinatesBrdf::clone() const
 {
     return new SphericalCoordinatesBrdf(*this);
 }
+
+std::unique_ptr<BrdfSlice> SphericalCoordinatesBrdf::bindIncoming(const Vec3& inDir) const
+{
+    return std::unique_ptr<BrdfSlice>(new CoordinatesBrdfSlice<CoordSys>(*this, inDir));
+}
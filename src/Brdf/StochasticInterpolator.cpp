@@ -0,0 +1,71 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Brdf/StochasticInterpolator.h>
+
+#include <algorithm>
+
+#include <libbsdf/Common/Utility.h>
+
+using namespace lb;
+
+int StochasticInterpolator::findSample(const SampleSet& samples,
+                                       float            angle0,
+                                       float            angle1,
+                                       float            angle2,
+                                       float            angle3,
+                                       float            randomNumber)
+{
+    // A random number is consumed by each axis as the product of weights is the probability.
+    int index0 = chooseIndex(samples.getAngles0(), samples.getAngleLookupTable0(),
+                             samples.isEqualIntervalAngles0(), angle0, &randomNumber);
+    int index1 = chooseIndex(samples.getAngles1(), samples.getAngleLookupTable1(),
+                             samples.isEqualIntervalAngles1(), angle1, &randomNumber);
+    int index2 = chooseIndex(samples.getAngles2(), samples.getAngleLookupTable2(),
+                             samples.isEqualIntervalAngles2(), angle2, &randomNumber);
+    int index3 = chooseIndex(samples.getAngles3(), samples.getAngleLookupTable3(),
+                             samples.isEqualIntervalAngles3(), angle3, &randomNumber);
+
+    return samples.getIndex(index0, index1, index2, index3);
+}
+
+int StochasticInterpolator::chooseIndex(const Arrayf&           angles,
+                                        const AngleLookupTable& lookupTable,
+                                        bool                    equalIntervalAngles,
+                                        float                   angle,
+                                        float*                  randomNumber)
+{
+    if (angles.size() == 1) return 0;
+
+    int backIndex = static_cast<int>(angles.size() - 1);
+
+    int lowerIndex;
+    if (equalIntervalAngles) {
+        lowerIndex = static_cast<int>(backIndex * angle / (angles[backIndex]));
+        lowerIndex = clamp(lowerIndex, 0, backIndex - 1);
+    }
+    else {
+        lowerIndex = clamp(lookupTable.findLowerBound(angles, angle), 1, backIndex) - 1;
+    }
+
+    float interval = std::max(angles[lowerIndex + 1] - angles[lowerIndex], EPSILON_F);
+    float upperWeight = clamp((angle - angles[lowerIndex]) / interval, 0.0f, 1.0f);
+    float lowerWeight = 1.0f - upperWeight;
+
+    if (*randomNumber < lowerWeight) {
+        *randomNumber /= lowerWeight;
+        return lowerIndex;
+    }
+    else if (upperWeight > 0.0f) {
+        *randomNumber = std::min((*randomNumber - lowerWeight) / upperWeight, 1.0f);
+        return lowerIndex + 1;
+    }
+    else {
+        return lowerIndex;
+    }
+}
@@ -8,6 +8,8 @@
 
 #include <libbsdf/Brdf/TwoSidedMaterial.h>
 
+#include <utility>
+
 using namespace lb;
 
 TwoSidedMaterial::TwoSidedMaterial(Material* frontMaterial,
@@ -15,6 +17,21 @@ TwoSidedMaterial::TwoSidedMaterial(Material* frontMaterial,
                                    : frontMaterial_(frontMaterial),
                                      backMaterial_(backMaterial) {}
 
+TwoSidedMaterial::TwoSidedMaterial(TwoSidedMaterial&& material)
+                                   : frontMaterial_(material.frontMaterial_),
+                                     backMaterial_(material.backMaterial_)
+{
+    material.frontMaterial_ = 0;
+    material.backMaterial_ = 0;
+}
+
+TwoSidedMaterial& TwoSidedMaterial::operator=(TwoSidedMaterial&& material)
+{
+    std::swap(frontMaterial_, material.frontMaterial_);
+    std::swap(backMaterial_,  material.backMaterial_);
+    return *this;
+}
+
 TwoSidedMaterial::~TwoSidedMaterial()
 {
     delete frontMaterial_;
@@ -0,0 +1,59 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Common/AngleLookupTable.h>
+
+#include <cmath>
+
+using namespace lb;
+
+AngleLookupTable::AngleLookupTable() : minAngle_(0.0f),
+                                       bucketScale_(0.0f) {}
+
+void AngleLookupTable::build(const Arrayf& angles)
+{
+    indices_.clear();
+
+    const int numAngles = static_cast<int>(angles.size());
+    if (numAngles < 2) return;
+
+    float range = angles[numAngles - 1] - angles[0];
+    if (!(range > 0.0f)) return;
+
+    // The smallest interval is used as the bucket width to scan at most one angle per bucket.
+    float minInterval = range;
+    for (int i = 1; i < numAngles; ++i) {
+        float interval = angles[i] - angles[i - 1];
+        if (interval > 0.0f) {
+            minInterval = std::min(minInterval, interval);
+        }
+    }
+
+    // The number of buckets is limited for finely sampled ranges.
+    const int maxNumBuckets = std::max(numAngles * 16, 1024);
+    float numBucketsF = std::ceil(range / minInterval);
+    int numBuckets = (numBucketsF < maxNumBuckets) ? std::max(static_cast<int>(numBucketsF), 1) : maxNumBuckets;
+
+    minAngle_ = angles[0];
+    bucketScale_ = numBuckets / range;
+
+    indices_.resize(numBuckets);
+    int index = 0;
+    for (int i = 0; i < numBuckets; ++i) {
+        float bucketAngle = minAngle_ + i / bucketScale_;
+        while (index < numAngles && angles[index] < bucketAngle) {
+            ++index;
+        }
+        indices_[i] = index;
+    }
+}
+
+void AngleLookupTable::clear()
+{
+    indices_.clear();
+}
@@ -8,13 +8,14 @@
 
 #include <libbsdf/Common/CentripetalCatmullRomSpline.h>
 
+#include <algorithm>
 #include <cassert>
 
 #include <libbsdf/Common/Utility.h>
 
 using namespace lb;
 
-CentripetalCatmullRomSpline::CentripetalCatmullRomSpline() {}
+CentripetalCatmullRomSpline::CentripetalCatmullRomSpline() : monotonicX_(false) {}
 
 CentripetalCatmullRomSpline::CentripetalCatmullRomSpline(const Vec2& pos0,
                                                          const Vec2& pos1,
@@ -29,14 +30,27 @@ void CentripetalCatmullRomSpline::initialize(const Vec2& pos0,
                                              const Vec2& pos2,
                                              const Vec2& pos3)
 {
-    using std::max;
-    using std::sqrt;
-
     pos0_ = pos0;
     pos1_ = pos1;
     pos2_ = pos2;
     pos3_ = pos3;
 
+    Vec2 tan1, tan2;
+    computeTangents(pos0, pos1, pos2, pos3, &tan1, &tan2);
+
+    computeCoefficients(pos1, pos2, tan1, tan2);
+}
+
+void CentripetalCatmullRomSpline::computeTangents(const Vec2& pos0,
+                                                  const Vec2& pos1,
+                                                  const Vec2& pos2,
+                                                  const Vec2& pos3,
+                                                  Vec2*       tan1,
+                                                  Vec2*       tan2)
+{
+    using std::max;
+    using std::sqrt;
+
     // Compute disntaces.
     Vec2::Scalar dist0 = (pos1 - pos0).norm();
     Vec2::Scalar dist1 = (pos2 - pos1).norm();
@@ -48,12 +62,10 @@ void CentripetalCatmullRomSpline::initialize(const Vec2& pos0,
     dist2 = max(sqrt(dist2), std::numeric_limits<Vec2::Scalar>::epsilon());
 
     // Compute tangents.
-    Vec2 tan1 = (pos1 - pos0) / dist0 - (pos2 - pos0) / (dist0 + dist1) + (pos2 - pos1) / dist1;
-    Vec2 tan2 = (pos2 - pos1) / dist1 - (pos3 - pos1) / (dist1 + dist2) + (pos3 - pos2) / dist2;
-    tan1 *= dist1;
-    tan2 *= dist1;
-
-    computeCoefficients(pos1, pos2, tan1, tan2);
+    *tan1 = (pos1 - pos0) / dist0 - (pos2 - pos0) / (dist0 + dist1) + (pos2 - pos1) / dist1;
+    *tan2 = (pos2 - pos1) / dist1 - (pos3 - pos1) / (dist1 + dist2) + (pos3 - pos2) / dist2;
+    *tan1 *= dist1;
+    *tan2 *= dist1;
 }
 
 Vec2::Scalar CentripetalCatmullRomSpline::interpolateY(const Vec2::Scalar& x)
@@ -61,6 +73,41 @@ Vec2::Scalar CentripetalCatmullRomSpline::interpolateY(const Vec2::Scalar& x)
     assert((x > pos1_.x() - EPSILON_F * 10.0f && x < pos2_.x() + EPSILON_F * 10.0f) ||
            (x < pos1_.x() + EPSILON_F * 10.0f && x > pos2_.x() - EPSILON_F * 10.0f));
 
+    // If the X-component is not monotonic, bisection is used to find the same one of the parameters.
+    Vec2::Scalar t = monotonicX_ ? solveX(x) : bisectX(x);
+    return evaluate(t).y();
+}
+
+Vec2::Scalar CentripetalCatmullRomSpline::interpolateYByBisection(const Vec2::Scalar& x)
+{
+    return evaluate(bisectX(x)).y();
+}
+
+bool CentripetalCatmullRomSpline::isMonotonicX() const
+{
+    // The derivative of the X-component is a quadratic polynomial.
+    Vec2::Scalar a = 3.0 * coeff3_.x();
+    Vec2::Scalar b = 2.0 * coeff2_.x();
+    Vec2::Scalar c = coeff1_.x();
+
+    Vec2::Scalar slope0 = c;
+    Vec2::Scalar slope1 = a + b + c;
+    if (slope0 * slope1 <= 0.0) return false;
+
+    // Check the extremum of the derivative in (0,1).
+    if (a != 0.0) {
+        Vec2::Scalar extremumT = -b / (2.0 * a);
+        if (extremumT > 0.0 && extremumT < 1.0) {
+            Vec2::Scalar extremumSlope = (a * extremumT + b) * extremumT + c;
+            if (slope0 * extremumSlope <= 0.0) return false;
+        }
+    }
+
+    return true;
+}
+
+Vec2::Scalar CentripetalCatmullRomSpline::bisectX(const Vec2::Scalar& x)
+{
     Vec2::Scalar t = 0.5;
     Vec2 currentPos = evaluate(t);
 
@@ -100,5 +147,161 @@ Vec2::Scalar CentripetalCatmullRomSpline::interpolateY(const Vec2::Scalar& x)
         }
     }
 
-    return currentPos.y();
+    return t;
+}
+
+Vec2::Scalar CentripetalCatmullRomSpline::solveX(const Vec2::Scalar& x) const
+{
+    const bool ascending = (pos1_.x() < pos2_.x());
+    const Vec2::Scalar width = pos2_.x() - pos1_.x();
+
+    // The X-component is nearly linear in t. Start from the linear estimate.
+    Vec2::Scalar t = (width != 0.0) ? clamp((x - pos1_.x()) / width, 0.0, 1.0) : 0.5;
+
+    Vec2::Scalar minT = 0.0;
+    Vec2::Scalar maxT = 1.0;
+
+    while (true) {
+        Vec2::Scalar posX = coeff0_.x() + (coeff1_.x() + (coeff2_.x() + coeff3_.x() * t) * t) * t;
+        if (isEqual(posX, x)) break;
+
+        if ((posX > x) == ascending) {
+            maxT = t;
+        }
+        else {
+            minT = t;
+        }
+
+        Vec2::Scalar slope = coeff1_.x() + (2.0 * coeff2_.x() + 3.0 * coeff3_.x() * t) * t;
+        Vec2::Scalar nextT = t - (posX - x) / slope;
+
+        // Fall back to bisection if the step leaves the bracket.
+        if (!(nextT > minT && nextT < maxT)) {
+            nextT = (minT + maxT) * 0.5;
+            if (nextT == minT || nextT == maxT) break;
+        }
+
+        if (nextT == t) break;
+        t = nextT;
+    }
+
+    return t;
+}
+
+void CentripetalCatmullRomSpline::interpolateMultipleY(const Vec2::Scalar&  pos0X,
+                                                       const Vec2::Scalar&  pos1X,
+                                                       const Vec2::Scalar&  pos2X,
+                                                       const Vec2::Scalar&  pos3X,
+                                                       const float*         pos0Ys,
+                                                       const float*         pos1Ys,
+                                                       const float*         pos2Ys,
+                                                       const float*         pos3Ys,
+                                                       int                  numSplines,
+                                                       const Vec2::Scalar&  x,
+                                                       float*               ys)
+{
+    typedef Eigen::Array4d Lanes;
+    typedef Eigen::Array<bool, 4, 1> LaneMask;
+    const int numLanes = static_cast<int>(Lanes::SizeAtCompileTime);
+
+    const Vec2::Scalar epsilon = std::numeric_limits<Vec2::Scalar>::epsilon();
+
+    const Vec2::Scalar dx0 = pos1X - pos0X;
+    const Vec2::Scalar dx1 = pos2X - pos1X;
+    const Vec2::Scalar dx2 = pos3X - pos2X;
+    const Vec2::Scalar dx02 = pos2X - pos0X;
+    const Vec2::Scalar dx13 = pos3X - pos1X;
+
+    const bool ascending = (pos1X < pos2X);
+
+    for (int begin = 0; begin < numSplines; begin += numLanes) {
+        // The lanes after the last spline repeat it.
+        Lanes y0, y1, y2, y3;
+        for (int i = 0; i < numLanes; ++i) {
+            int index = std::min(begin + i, numSplines - 1);
+            y0[i] = pos0Ys[index];
+            y1[i] = pos1Ys[index];
+            y2[i] = pos2Ys[index];
+            y3[i] = pos3Ys[index];
+        }
+
+        // Compute the distances and tangents of initialize() in lanes.
+        Lanes dy0 = y1 - y0;
+        Lanes dy1 = y2 - y1;
+        Lanes dy2 = y3 - y2;
+
+        Lanes dist0 = (dx0 * dx0 + dy0 * dy0).sqrt().sqrt().max(epsilon);
+        Lanes dist1 = (dx1 * dx1 + dy1 * dy1).sqrt().sqrt().max(epsilon);
+        Lanes dist2 = (dx2 * dx2 + dy2 * dy2).sqrt().sqrt().max(epsilon);
+
+        Lanes tan1X = (dx0 / dist0 - dx02 / (dist0 + dist1) + dx1 / dist1) * dist1;
+        Lanes tan1Y = (dy0 / dist0 - (y2 - y0) / (dist0 + dist1) + dy1 / dist1) * dist1;
+        Lanes tan2X = (dx1 / dist1 - dx13 / (dist1 + dist2) + dx2 / dist2) * dist1;
+        Lanes tan2Y = (dy1 / dist1 - (y3 - y1) / (dist1 + dist2) + dy2 / dist2) * dist1;
+
+        Lanes coeff1X = tan1X;
+        Lanes coeff2X = -3.0 * pos1X + 3.0 * pos2X - 2.0 * tan1X - tan2X;
+        Lanes coeff3X = 2.0 * pos1X - 2.0 * pos2X + tan1X + tan2X;
+
+        Lanes coeff0Y = y1;
+        Lanes coeff1Y = tan1Y;
+        Lanes coeff2Y = -3.0 * y1 + 3.0 * y2 - 2.0 * tan1Y - tan2Y;
+        Lanes coeff3Y = 2.0 * y1 - 2.0 * y2 + tan1Y + tan2Y;
+
+        // Check the monotonicity of the X-components as isMonotonicX().
+        Lanes a = 3.0 * coeff3X;
+        Lanes b = 2.0 * coeff2X;
+        Lanes slope0 = coeff1X;
+        Lanes slope1 = a + b + coeff1X;
+        Lanes extremumT = -b / (2.0 * a);
+        Lanes extremumSlope = (a * extremumT + b) * extremumT + coeff1X;
+        LaneMask monotonic = (slope0 * slope1 > 0.0) &&
+                             !((a != 0.0) && (extremumT > 0.0) && (extremumT < 1.0) && (slope0 * extremumSlope <= 0.0));
+
+        // Newton's method safeguarded by bisection as solveX(). Finished lanes are masked.
+        Lanes t = ((pos2X != pos1X) ? (x - pos1X) / (pos2X - pos1X) : 0.5) * Lanes::Ones();
+        t = t.max(0.0).min(1.0);
+        Lanes minT = Lanes::Zero();
+        Lanes maxT = Lanes::Ones();
+        LaneMask active = monotonic;
+
+        while (active.any()) {
+            Lanes posX = pos1X + (coeff1X + (coeff2X + coeff3X * t) * t) * t;
+            Lanes tolerance = epsilon * posX.abs().max(std::abs(x)).max(1.0) * 2.0;
+            active = active && ((posX - x).abs() > tolerance);
+
+            LaneMask upper = ascending ? LaneMask(posX > x) : LaneMask(posX < x);
+            maxT = (active && upper).select(t, maxT);
+            minT = (active && !upper).select(t, minT);
+
+            Lanes slope = coeff1X + (2.0 * coeff2X + 3.0 * coeff3X * t) * t;
+            Lanes nextT = t - (posX - x) / slope;
+
+            LaneMask outside = !((nextT > minT) && (nextT < maxT));
+            Lanes midT = (minT + maxT) * 0.5;
+            nextT = outside.select(midT, nextT);
+            active = active && !(outside && ((midT == minT) || (midT == maxT)));
+            active = active && (nextT != t);
+
+            t = active.select(nextT, t);
+        }
+
+        Lanes t2 = t * t;
+        Lanes t3 = t2 * t;
+        Lanes y = coeff0Y + coeff1Y * t + coeff2Y * t2 + coeff3Y * t3;
+
+        int end = std::min(begin + numLanes, numSplines);
+        for (int i = begin; i < end; ++i) {
+            if (monotonic[i - begin]) {
+                ys[i] = static_cast<float>(y[i - begin]);
+            }
+            else {
+                CentripetalCatmullRomSpline ccrs(Vec2(pos0X, pos0Ys[i]),
+                                                 Vec2(pos1X, pos1Ys[i]),
+                                                 Vec2(pos2X, pos2Ys[i]),
+                                                 Vec2(pos3X, pos3Ys[i]));
+                ys[i] = static_cast<float>(ccrs.interpolateY(x));
+            }
+        }
+    }
 }
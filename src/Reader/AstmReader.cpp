@@ -13,7 +13,6 @@
 #include <set>
 #include <sstream>
 
-#include <libbsdf/Brdf/Processor.h>
 #include <libbsdf/Brdf/RandomSampleSet.h>
 
 using namespace lb;
@@ -214,6 +213,37 @@ SphericalCoordinatesBrdf* AstmReader::read(const std::string& fileName)
     outPhiAngles.insert(0.0f);
     outPhiAngles.insert(SphericalCoordinateSystem::MAX_ANGLE3);
 
+    // Append omitted angles of one side of the plane of incidence
+    // instead of filling a copied BRDF after it is set up.
+    bool oneSide = isOneSide(outPhiAngles);
+    std::cout << "[AstmReader::read] One side of the plane of incidence: " << oneSide << std::endl;
+
+    if (oneSide) {
+        RandomSampleSet<SphericalCoordinateSystem>::SampleMap filledSamples;
+        for (auto it = samples.begin(); it != samples.end(); ++it) {
+            float outPhi = it->first.at(3);
+            if (outPhi <= PI_F || isEqual(outPhi, PI_F) || isEqual(outPhi, 2.0f * PI_F)) continue;
+
+            // Spectra at angles greater than PI are stored at symmetric angles.
+            RandomSampleSet<SphericalCoordinateSystem>::AngleList angles = it->first;
+            angles.at(3) = SphericalCoordinateSystem::MAX_ANGLE3 - outPhi;
+            filledSamples[angles] = it->second;
+        }
+        samples.insert(filledSamples.begin(), filledSamples.end());
+
+        std::vector<float> filledAngles;
+        for (auto it = outPhiAngles.begin(); it != outPhiAngles.end(); ++it) {
+            float outPhi = *it;
+            bool angleOmitted = (outPhi != 0.0f &&
+                                 !isEqual(outPhi, PI_F) &&
+                                 !isEqual(outPhi, 2.0f * PI_F));
+            if (angleOmitted) {
+                filledAngles.push_back(SphericalCoordinateSystem::MAX_ANGLE3 - outPhi);
+            }
+        }
+        outPhiAngles.insert(filledAngles.begin(), filledAngles.end());
+    }
+
     int numInTheta  = inThetaAngles.size();
     int numInPhi    = inPhiAngles.size();
     int numOutTheta = outThetaAngles.size();
@@ -234,19 +264,36 @@ SphericalCoordinatesBrdf* AstmReader::read(const std::string& fileName)
         ss->setWavelength(i, wavelengths.at(i));
     }
 
-    rss.setupBrdf(brdf);
-
-    std::cout << "[AstmReader::read] One side of the plane of incidence: " << ss->isOneSide() << std::endl;
-
-    if (ss->isOneSide()) {
-        SphericalCoordinatesBrdf* filledBrdf = fillSymmetricBrdf(brdf);
-        delete brdf;
-        brdf = filledBrdf;
+    // Spectra of appended angles are not stored.
+    if (oneSide && !ss->setSymmetry(PLANE_SYMMETRY, false)) {
+        std::cerr << "[AstmReader::read] Failed to set the plane symmetry." << std::endl;
     }
 
+    rss.setupBrdf(brdf);
+
     std::cout << "[AstmReader::read] The number of sample points: " << samples.size() << std::endl;
 
     brdf->clampAngles();
 
     return brdf;
 }
+
+bool AstmReader::isOneSide(const std::set<float>& outPhiAngles)
+{
+    bool contain_0_PI = false;
+    bool contain_PI_2PI = false;
+
+    for (auto it = outPhiAngles.begin(); it != outPhiAngles.end(); ++it) {
+        float angle = *it;
+
+        if (angle > 0.0f && angle < PI_F) {
+            contain_0_PI = true;
+        }
+
+        if (angle > PI_F && angle < 2.0f * PI_F) {
+            contain_PI_2PI = true;
+        }
+    }
+
+    return (!contain_0_PI || !contain_PI_2PI);
+}
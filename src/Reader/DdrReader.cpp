@@ -212,8 +212,9 @@ SpecularCoordinatesBrdf* DdrReader::read(const std::string& fileName)
     ss->getAngles1() = toRadians(ss->getAngles1());
     ss->getAngles2() = toRadians(ss->getAngles2());
 
+    Arrayf spPhiAngles(brdf->getNumSpecPhi());
     for (int i = 0; i < static_cast<int>(spPhiDegrees.size()); ++i) {
-        brdf->setSpecPhi(i, toRadian(spPhiDegrees.at(i)));
+        spPhiAngles[i] = toRadian(spPhiDegrees.at(i));
     }
 
     // Copy symmetrical angles.
@@ -222,7 +223,18 @@ SpecularCoordinatesBrdf* DdrReader::read(const std::string& fileName)
         for (int i = numSpecPhiDegrees, reverseIndex = numSpecPhiDegrees - 2;
              i < brdf->getNumSpecPhi();
              ++i, --reverseIndex) {
-            brdf->setSpecPhi(i, PI_F + (PI_F - brdf->getSpecPhi(reverseIndex)));
+            spPhiAngles[i] = PI_F + (PI_F - spPhiAngles[reverseIndex]);
+        }
+    }
+
+    brdf->setSpecPhiAngles(spPhiAngles);
+
+    if (symmetryType == ddr_sdr_utility::PLANE_SYMMETRICAL) {
+        // Spectra of symmetrical angles are not stored.
+        if (!ss->setSymmetry(PLANE_SYMMETRY, false)) {
+            std::cerr << "[DdrReader::read] Invalid symmetrical angles." << std::endl;
+            delete brdf;
+            return 0;
         }
     }
 
@@ -289,15 +301,9 @@ SpecularCoordinatesBrdf* DdrReader::read(const std::string& fileName)
                     brdfValue *= kbdfs.at(inThIndex);
                 }
 
-                Spectrum& sp = brdf->getSpectrum(inThIndex, inPhIndex, spThIndex, spPhIndex);
+                SpectrumMap sp = brdf->getSpectrum(inThIndex, inPhIndex, spThIndex, spPhIndex);
                 sp[wlIndex] = brdfValue;
 
-                if (symmetryType == ddr_sdr_utility::PLANE_SYMMETRICAL) {
-                    int symmetryIndex = (brdf->getNumSpecPhi() - 1) - spPhIndex;
-                    Spectrum& symmetrySp = brdf->getSpectrum(inThIndex, inPhIndex, spThIndex, symmetryIndex);
-                    symmetrySp[wlIndex] = brdfValue;
-                }
-
                 if (ifs.fail()) {
                     std::cerr << "[DdrReader::read] Invalid format: " << brdfValue << std::endl;
                     delete brdf;
@@ -0,0 +1,229 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Reader/LbbReader.h>
+
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <libbsdf/Brdf/HalfDifferenceCoordinatesBrdf.h>
+#include <libbsdf/Brdf/SpecularCoordinatesBrdf.h>
+#include <libbsdf/Brdf/SphericalCoordinatesBrdf.h>
+#include <libbsdf/Reader/LbbUtility.h>
+
+using namespace lb;
+using namespace lb::lbb_utility;
+
+Brdf* LbbReader::read(const std::string& fileName)
+{
+    uint64_t fileSize;
+    std::shared_ptr<void> mappedFile = mapFile(fileName, &fileSize);
+    if (!mappedFile) {
+        std::cerr << "[LbbReader::read] Could not open: " << fileName << std::endl;
+        return 0;
+    }
+
+    char* data = static_cast<char*>(mappedFile.get());
+
+    // Read a header.
+    if (fileSize < sizeof(LbbHeader)) {
+        std::cerr << "[LbbReader::read] Invalid format." << std::endl;
+        return 0;
+    }
+
+    LbbHeader header;
+    std::memcpy(&header, data, sizeof(header));
+
+    if (std::memcmp(header.signature, LBB_SIGNATURE, sizeof(header.signature)) != 0) {
+        std::cerr << "[LbbReader::read] Invalid format." << std::endl;
+        return 0;
+    }
+
+    if (header.byteOrderMark != LBB_BYTE_ORDER_MARK) {
+        std::cerr << "[LbbReader::read] Byte order does not match." << std::endl;
+        return 0;
+    }
+
+    if (header.version != LBB_VERSION) {
+        std::cerr << "[LbbReader::read] Unsupported version: " << header.version << std::endl;
+        return 0;
+    }
+
+    if (header.numAngles[0] <= 0 || header.numAngles[1] <= 0 ||
+        header.numAngles[2] <= 0 || header.numAngles[3] <= 0 ||
+        header.numWavelengths <= 0 ||
+        header.colorModel > SPECTRAL_MODEL ||
+        header.spectrumLayout > PLANAR_LAYOUT ||
+        header.spectrumPrecision > BFLOAT16_PRECISION ||
+        header.symmetry > PLANE_SYMMETRY) {
+        std::cerr << "[LbbReader::read] Invalid header." << std::endl;
+        return 0;
+    }
+
+    if (header.coordinateSystem != SPHERICAL_COORDINATE_SYSTEM &&
+        header.coordinateSystem != SPECULAR_COORDINATE_SYSTEM &&
+        header.coordinateSystem != HALF_DIFFERENCE_COORDINATE_SYSTEM) {
+        std::cerr
+            << "[LbbReader::read] Unsupported coordinate system: " << header.coordinateSystem
+            << std::endl;
+        return 0;
+    }
+
+    ColorModel colorModel = static_cast<ColorModel>(header.colorModel);
+    SpectrumLayout spectrumLayout = static_cast<SpectrumLayout>(header.spectrumLayout);
+    SpectrumPrecision spectrumPrecision = static_cast<SpectrumPrecision>(header.spectrumPrecision);
+
+    if ((colorModel == RGB_MODEL && header.numWavelengths != 3) ||
+        (colorModel == XYZ_MODEL && header.numWavelengths != 3) ||
+        (colorModel == MONOCHROMATIC_MODEL && header.numWavelengths != 1)) {
+        std::cerr << "[LbbReader::read] Invalid header." << std::endl;
+        return 0;
+    }
+
+    // The number of elements of spectra must be representable in int. Symmetry only reduces it.
+    const uint64_t maxNumElements = std::numeric_limits<int>::max();
+    uint64_t maxSpectraSize = 1;
+    int32_t sizes[] = { header.numAngles[0], header.numAngles[1], header.numAngles[2], header.numAngles[3],
+                        header.numWavelengths };
+    for (int i = 0; i < 5; ++i) {
+        maxSpectraSize *= static_cast<uint64_t>(sizes[i]);
+        if (maxSpectraSize > maxNumElements) {
+            std::cerr << "[LbbReader::read] Too many sample points." << std::endl;
+            return 0;
+        }
+    }
+    maxSpectraSize *= getElementSize(spectrumPrecision);
+
+    if (header.spectraOffset != getSpectraOffset(header) ||
+        header.spectraSize > maxSpectraSize ||
+        header.spectraOffset > fileSize ||
+        header.spectraSize > fileSize - header.spectraOffset) {
+        std::cerr << "[LbbReader::read] Invalid size of data." << std::endl;
+        return 0;
+    }
+
+    // The array of spectra is backed by the mapped file and is not allocated.
+    SampleSet samples(header.numAngles[0], header.numAngles[1], header.numAngles[2], header.numAngles[3],
+                      colorModel, header.numWavelengths, spectrumLayout, false);
+
+    // Read angles and wavelengths.
+    Arrayf* arrays[] = { &samples.getAngles0(), &samples.getAngles1(),
+                         &samples.getAngles2(), &samples.getAngles3(),
+                         &samples.getWavelengths() };
+    const char* pos = data + sizeof(LbbHeader);
+    for (int i = 0; i < 5; ++i) {
+        std::memcpy(arrays[i]->data(), pos, sizeof(float) * arrays[i]->size());
+        pos += sizeof(float) * arrays[i]->size();
+    }
+
+    samples.updateAngleAttributes();
+
+    if (!samples.setSymmetry(static_cast<SymmetryType>(header.symmetry), false)) {
+        std::cerr << "[LbbReader::read] Invalid symmetrical angles." << std::endl;
+        return 0;
+    }
+
+    uint64_t spectraSize = static_cast<uint64_t>(samples.getNumSamples())
+                         * samples.getNumWavelengths()
+                         * getElementSize(spectrumPrecision);
+    if (header.spectraSize != spectraSize) {
+        std::cerr << "[LbbReader::read] Invalid size of data." << std::endl;
+        return 0;
+    }
+
+    // Use the mapped array of spectra.
+    char* spectra = data + header.spectraOffset;
+    if (spectrumPrecision == SINGLE_PRECISION) {
+        samples.setExternalSpectra(reinterpret_cast<float*>(spectra), spectrumLayout, mappedFile);
+    }
+    else {
+        samples.setExternalSpectra(reinterpret_cast<const uint16_t*>(spectra),
+                                   spectrumLayout, spectrumPrecision, mappedFile);
+    }
+
+    // The BRDF is constructed with a single sample point and takes over the sample set.
+    Brdf* brdf;
+    switch (header.coordinateSystem) {
+        case SPHERICAL_COORDINATE_SYSTEM:
+            brdf = new SphericalCoordinatesBrdf(1, 1, 1, 1, colorModel, header.numWavelengths);
+            break;
+        case SPECULAR_COORDINATE_SYSTEM:
+            brdf = new SpecularCoordinatesBrdf(1, 1, 1, 1, colorModel, header.numWavelengths);
+            break;
+        case HALF_DIFFERENCE_COORDINATE_SYSTEM:
+            brdf = new HalfDifferenceCoordinatesBrdf(1, 1, 1, 1, colorModel, header.numWavelengths);
+            break;
+        default:
+            return 0;
+    }
+
+    *brdf->getSampleSet() = std::move(samples);
+
+    return brdf;
+}
+
+std::shared_ptr<void> LbbReader::mapFile(const std::string& fileName, uint64_t* fileSize)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE) return std::shared_ptr<void>();
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0) {
+        CloseHandle(file);
+        return std::shared_ptr<void>();
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, 0, PAGE_WRITECOPY, 0, 0, 0);
+    CloseHandle(file);
+    if (!mapping) return std::shared_ptr<void>();
+
+    void* address = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!address) return std::shared_ptr<void>();
+
+    *fileSize = static_cast<uint64_t>(size.QuadPart);
+
+    return std::shared_ptr<void>(address, [](void* p) { UnmapViewOfFile(p); });
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd == -1) return std::shared_ptr<void>();
+
+    struct stat st;
+    if (fstat(fd, &st) == -1 || st.st_size == 0) {
+        close(fd);
+        return std::shared_ptr<void>();
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+
+    // Private mappings share unmodified pages with other processes and copy pages on write.
+    void* address = mmap(0, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (address == MAP_FAILED) return std::shared_ptr<void>();
+
+    *fileSize = size;
+
+    return std::shared_ptr<void>(address, [size](void* p) { munmap(p, size); });
+#endif
+}
@@ -11,6 +11,7 @@
 #include <fstream>
 #include <iostream>
 #include <set>
+#include <utility>
 
 #include <libbsdf/Brdf/Processor.h>
 
@@ -329,7 +330,7 @@ SphericalCoordinatesBrdf* LightToolsBsdfReader::createBrdf(std::vector<DataBlock
         int index = 0;
         for (int outPhIndex = 0; outPhIndex < brdf->getNumOutPhi();   ++outPhIndex)          {
         for (int outThIndex = 0; outThIndex < brdf->getNumOutTheta(); ++outThIndex, ++index) {
-            Spectrum& sp = brdf->getSpectrum(inThIndex, 0, outThIndex, outPhIndex);
+            SpectrumMap sp = brdf->getSpectrum(inThIndex, 0, outThIndex, outPhIndex);
             sp[channelIndex] = data->samples[index];
         }}
 
@@ -337,9 +338,9 @@ SphericalCoordinatesBrdf* LightToolsBsdfReader::createBrdf(std::vector<DataBlock
     }
 
     // An incoming azimuthal angle of an isotropic LightTools BSDF is 90 degrees.
-    SphericalCoordinatesBrdf* rotatedBrdf = rotateOutPhi(*brdf, -PI_2_F);
+    std::unique_ptr<SphericalCoordinatesBrdf> rotatedBrdf = rotateOutPhi(std::move(*brdf), -PI_2_F);
     rotatedBrdf->clampAngles();
 
     delete brdf;
-    return rotatedBrdf;
+    return rotatedBrdf.release();
 }
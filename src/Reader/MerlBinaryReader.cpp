@@ -55,10 +55,12 @@ HalfDifferenceCoordinatesBrdf* MerlBinaryReader::read(const std::string& fileNam
                                                                             RGB_MODEL, 3, true);
 
     // Set the angles of a non-linear mapping.
+    Arrayf halfThetaAngles(brdf->getNumHalfTheta());
     for (int i = 0; i < brdf->getNumHalfTheta(); ++i) {
         float halfThetaDegree = static_cast<float>(i * i) / numHalfTheta;
-        brdf->setHalfTheta(i, toRadian(halfThetaDegree));
+        halfThetaAngles[i] = toRadian(halfThetaDegree);
     }
+    brdf->setHalfThetaAngles(halfThetaAngles);
 
     const Vec3 rgbScaleCoeff(1.0f / 1500.0f, 1.15f / 1500.0f, 1.66f / 1500.0f);
 
@@ -80,7 +82,7 @@ HalfDifferenceCoordinatesBrdf* MerlBinaryReader::read(const std::string& fileNam
         rgb = rgb.cwiseMax(0.0f);
 
         rgb = rgb.cwiseProduct(rgbScaleCoeff);
-        brdf->setSpectrum(halfThIndex, 0, diffThIndex, diffPhIndex, rgb.asVector3f());
+        brdf->getSpectrum(halfThIndex, 0, diffThIndex, diffPhIndex) = rgb.asVector3f().array();
     }}}
 
     delete[] samples;
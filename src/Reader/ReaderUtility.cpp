@@ -100,6 +100,9 @@ FileType reader_utility::classifyFile(const std::string& fileName)
     else if (hasSuffix(name, ".binary")) {
         return MERL_BINARY_FILE;
     }
+    else if (hasSuffix(name, ".lbb")) {
+        return LBB_FILE;
+    }
 
     return UNKNOWN_FILE;
 }
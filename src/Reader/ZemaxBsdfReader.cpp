@@ -174,8 +174,9 @@ SpecularCoordinatesBrdf* ZemaxBsdfReader::read(const std::string& fileName, Data
     ss->getAngles1() = toRadians(ss->getAngles1());
     ss->getAngles2() = toRadians(ss->getAngles2());
 
+    Arrayf spPhiAngles(brdf->getNumSpecPhi());
     for (int i = 0; i < static_cast<int>(spPhiDegrees.size()); ++i) {
-        brdf->setSpecPhi(i, toRadian(spPhiDegrees.at(i)));
+        spPhiAngles[i] = toRadian(spPhiDegrees.at(i));
     }
 
     // Copy symmetrical angles.
@@ -184,7 +185,18 @@ SpecularCoordinatesBrdf* ZemaxBsdfReader::read(const std::string& fileName, Data
         for (int i = numSpecPhiDegrees, reverseIndex = numSpecPhiDegrees - 2;
              i < brdf->getNumSpecPhi();
              ++i, --reverseIndex) {
-            brdf->setSpecPhi(i, PI_F + (PI_F - brdf->getSpecPhi(reverseIndex)));
+            spPhiAngles[i] = PI_F + (PI_F - spPhiAngles[reverseIndex]);
+        }
+    }
+
+    brdf->setSpecPhiAngles(spPhiAngles);
+
+    if (symmetryType == PLANE_SYMMETRICAL) {
+        // Spectra of symmetrical angles are not stored.
+        if (!ss->setSymmetry(PLANE_SYMMETRY, false)) {
+            std::cerr << "[ZemaxBsdfReader::read] Invalid symmetrical angles." << std::endl;
+            delete brdf;
+            return 0;
         }
     }
 
@@ -223,14 +235,8 @@ SpecularCoordinatesBrdf* ZemaxBsdfReader::read(const std::string& fileName, Data
                 ifs >> brdfValueStr;
                 float brdfValue = static_cast<float>(std::atof(brdfValueStr.c_str()));
 
-                Spectrum& sp = brdf->getSpectrum(inThIndex, inPhIndex, spThIndex, spPhIndex);
+                SpectrumMap sp = brdf->getSpectrum(inThIndex, inPhIndex, spThIndex, spPhIndex);
                 sp[wlIndex] = brdfValue;
-
-                if (symmetryType == PLANE_SYMMETRICAL) {
-                    int symmetryIndex = (brdf->getNumSpecPhi() - 1) - spPhIndex;
-                    Spectrum& symmetrySp = brdf->getSpectrum(inThIndex, inPhIndex, spThIndex, symmetryIndex);
-                    symmetrySp[wlIndex] = brdfValue;
-                }
             }}
 
             ++cntTis;
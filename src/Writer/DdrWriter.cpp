@@ -124,7 +124,7 @@ bool DdrWriter::output(const SpecularCoordinatesBrdf& brdf, std::ostream& stream
 
                 for (int spPhIndex = 0; spPhIndex < brdf.getNumSpecPhi(); ++spPhIndex) {
                     for (int spThIndex = 0; spThIndex < brdf.getNumSpecTheta(); ++spThIndex) {
-                        const Spectrum& sp = brdf.getSpectrum(inThIndex, inPhIndex, spThIndex, spPhIndex);
+                        ConstSpectrumMap sp = brdf.getSpectrum(inThIndex, inPhIndex, spThIndex, spPhIndex);
 
                         if (ss->getColorModel() == XYZ_MODEL) {
                             Spectrum rgb = xyzToSrgb(sp);
@@ -0,0 +1,106 @@
+// =================================================================== //
+// Copyright (C) 2016 Kimura Ryo                                       //
+//                                                                     //
+// This Source Code Form is subject to the terms of the Mozilla Public //
+// License, v. 2.0. If a copy of the MPL was not distributed with this //
+// file, You can obtain one at http://mozilla.org/MPL/2.0/.            //
+// =================================================================== //
+
+#include <libbsdf/Writer/LbbWriter.h>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+#include <libbsdf/Brdf/HalfDifferenceCoordinatesBrdf.h>
+#include <libbsdf/Brdf/SpecularCoordinatesBrdf.h>
+#include <libbsdf/Brdf/SphericalCoordinatesBrdf.h>
+#include <libbsdf/Reader/LbbUtility.h>
+
+using namespace lb;
+using namespace lb::lbb_utility;
+
+bool LbbWriter::write(const std::string& fileName, const Brdf& brdf)
+{
+    std::ofstream fout(fileName.c_str(), std::ios_base::binary);
+    if (fout.fail()) {
+        std::cerr << "[LbbWriter::write] Could not open: " << fileName << std::endl;
+        return false;
+    }
+
+    return output(brdf, fout);
+}
+
+bool LbbWriter::output(const Brdf& brdf, std::ostream& stream)
+{
+    CoordinateSystemType coordSys;
+    if (dynamic_cast<const SphericalCoordinatesBrdf*>(&brdf)) {
+        coordSys = SPHERICAL_COORDINATE_SYSTEM;
+    }
+    else if (dynamic_cast<const SpecularCoordinatesBrdf*>(&brdf)) {
+        coordSys = SPECULAR_COORDINATE_SYSTEM;
+    }
+    else if (dynamic_cast<const HalfDifferenceCoordinatesBrdf*>(&brdf)) {
+        coordSys = HALF_DIFFERENCE_COORDINATE_SYSTEM;
+    }
+    else {
+        std::cerr << "[LbbWriter::output] Unsupported coordinate system." << std::endl;
+        return false;
+    }
+
+    const SampleSet* ss = brdf.getSampleSet();
+
+    LbbHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.signature, LBB_SIGNATURE, sizeof(header.signature));
+    header.version           = LBB_VERSION;
+    header.byteOrderMark     = LBB_BYTE_ORDER_MARK;
+    header.coordinateSystem  = coordSys;
+    header.colorModel        = ss->getColorModel();
+    header.spectrumLayout    = ss->getSpectrumLayout();
+    header.spectrumPrecision = ss->getSpectrumPrecision();
+    header.numAngles[0]      = ss->getNumAngles0();
+    header.numAngles[1]      = ss->getNumAngles1();
+    header.numAngles[2]      = ss->getNumAngles2();
+    header.numAngles[3]      = ss->getNumAngles3();
+    header.numWavelengths    = ss->getNumWavelengths();
+    header.symmetry          = ss->getSymmetry();
+    header.spectraOffset     = getSpectraOffset(header);
+    header.spectraSize       = static_cast<uint64_t>(ss->getNumSamples()) * ss->getNumWavelengths()
+                             * getElementSize(ss->getSpectrumPrecision());
+
+    stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    // Write angles and wavelengths.
+    const Arrayf* arrays[] = { &ss->getAngles0(), &ss->getAngles1(), &ss->getAngles2(), &ss->getAngles3(),
+                               &ss->getWavelengths() };
+    uint64_t pos = sizeof(header);
+    for (int i = 0; i < 5; ++i) {
+        std::streamsize size = sizeof(float) * arrays[i]->size();
+        stream.write(reinterpret_cast<const char*>(arrays[i]->data()), size);
+        pos += size;
+    }
+
+    // Pad to the aligned offset of spectra.
+    while (pos < header.spectraOffset) {
+        stream.put('\0');
+        ++pos;
+    }
+
+    // Write spectra.
+    const char* spectra;
+    if (ss->getSpectrumPrecision() == SINGLE_PRECISION) {
+        spectra = reinterpret_cast<const char*>(ss->getSpectra().data());
+    }
+    else {
+        spectra = reinterpret_cast<const char*>(ss->getCompactSpectra());
+    }
+    stream.write(spectra, header.spectraSize);
+
+    if (stream.fail()) {
+        std::cerr << "[LbbWriter::output] Could not write data." << std::endl;
+        return false;
+    }
+
+    return true;
+}